@@ -0,0 +1,66 @@
+#ifndef BLAS_H
+#define BLAS_H
+
+#include "linear_algebra.h" // dla Vector, DenseMatrix i widoków macierzy
+
+/**
+ * @file blas.h
+ * @brief Podstawowe operacje na macierzach gęstych w stylu BLAS: GEMV, GEMM, TRSV i TRSM.
+ *
+ * Funkcje działają na widokach MatrixView/ConstMatrixView (układ wierszowy, dowolny stride),
+ * więc mogą operować na fragmentach większych macierzy bez kopiowania. Korzystają z tych samych
+ * blokowych, wektoryzowanych jąder (AVX2/AVX-512 wybierane w czasie działania), co solvery biblioteki.
+ */
+
+/// Czy argument macierzowy jest używany bezpośrednio, czy po transpozycji.
+enum class Transpose { No, Yes };
+
+/// Który trójkąt macierzy jest odczytywany w operacjach trójkątnych.
+enum class Triangle { Lower, Upper };
+
+/// Czy przekątna macierzy trójkątnej składa się z jedynek (nie jest wtedy odczytywana).
+enum class Diagonal { NonUnit, Unit };
+
+/**
+ * @brief y = alpha * op(A) x + beta * y.
+ * @param x Wektor o długości równej liczbie kolumn op(A).
+ * @param y Wektor o długości równej liczbie wierszy op(A); przy beta = 0 jego zawartość jest ignorowana.
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ */
+void gemv(Transpose trans, double alpha, ConstMatrixView A, const Vector& x, double beta, Vector& y);
+
+/// Wariant na wskaźnikach (długości wektorów wynikają z wymiarów A i nie są sprawdzane).
+void gemv(Transpose trans, double alpha, ConstMatrixView A, const double* x, double beta, double* y);
+
+/**
+ * @brief C = alpha * op(A) op(B) + beta * C.
+ *
+ * Mnożenie blokowe z pakowaniem paneli do buforów dopasowanych do pamięci podręcznej;
+ * przy beta = 0 poprzednia zawartość C jest ignorowana. C nie może nachodzić na A ani B.
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ */
+void gemm(Transpose trans_a, Transpose trans_b, double alpha, ConstMatrixView A, ConstMatrixView B,
+          double beta, MatrixView C);
+
+/**
+ * @brief Rozwiązuje w miejscu op(T) x = b dla macierzy trójkątnej T (x na wejściu zawiera b).
+ *
+ * Odczytywany jest tylko wskazany trójkąt T; osobliwość (zero na przekątnej) nie jest sprawdzana.
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ */
+void trsv(Triangle uplo, Transpose trans, Diagonal diag, ConstMatrixView T, Vector& x);
+void trsv(Triangle uplo, Transpose trans, Diagonal diag, ConstMatrixView T, double* x);
+
+/**
+ * @brief Rozwiązuje w miejscu op(T) X = B (B := op(T)^{-1} B) dla wielu prawych stron jednocześnie.
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ */
+void trsm(Triangle uplo, Transpose trans, Diagonal diag, ConstMatrixView T, MatrixView B);
+
+/// Iloczyn macierzy i wektora A x.
+Vector multiply(const DenseMatrix& A, const Vector& x);
+
+/// Iloczyn macierzy A B.
+DenseMatrix multiply(const DenseMatrix& A, const DenseMatrix& B);
+
+#endif // BLAS_H
\ No newline at end of file
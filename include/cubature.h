@@ -0,0 +1,79 @@
+#ifndef CUBATURE_H
+#define CUBATURE_H
+
+#include <functional>
+#include <vector>
+
+/**
+ * @file cubature.h
+ * @brief Całkowanie wielowymiarowe po prostopadłościanie [lower_1, upper_1] x ... x [lower_d, upper_d].
+ *
+ * Dostępne są trzy metody o różnym koszcie w zależności od wymiaru d:
+ * - iloczyn tensorowy kwadratur Gaussa-Legendre'a (n^d węzłów, tylko dla małego d),
+ * - siatki rzadkie Smolyaka (liczba węzłów rośnie wielomianowo z d zamiast wykładniczo),
+ * - metoda quasi-Monte Carlo z ciągami Sobola lub Haltona (błąd prawie O(1/N) niezależnie od d).
+ *
+ * Funkcja podcałkowa wywoływana jest raz na węzeł (bez zagnieżdżonych wywołań kwadratur 1-D).
+ * Wszystkie metody mogą liczyć na wielu wątkach; podział pracy nie zależy od liczby wątków, a sumy
+ * częściowe dodawane są w stałej kolejności, więc wynik jest identyczny co do bitu dla każdej liczby wątków.
+ * Przy threads != 1 funkcja podcałkowa musi być bezpieczna wątkowo.
+ */
+
+/// Funkcja podcałkowa d zmiennych: x wskazuje d współrzędnych punktu.
+using MultivariateFunction = std::function<double(const double*)>;
+
+/// Wynik całkowania wielowymiarowego z oszacowaniem błędu.
+struct CubatureResult {
+    double value = 0.0;          ///< Przybliżona wartość całki.
+    double error_estimate = 0.0; ///< Oszacowanie błędu bezwzględnego.
+    long long evaluations = 0;   ///< Liczba obliczeń funkcji podcałkowej.
+};
+
+/**
+ * @brief Iloczyn tensorowy kwadratur Gaussa-Legendre'a (nodes węzłów w każdym wymiarze).
+ *
+ * Dokładny dla wielomianów stopnia <= 2 nodes - 1 względem każdej zmiennej. Błąd szacowany jest jako
+ * różnica z regułą o nodes - 1 węzłach (dodatkowe (nodes - 1)^d obliczeń), co zwykle zawyża błąd
+ * reguły nodes-punktowej; dla nodes = 1 oszacowanie jest nieskończone.
+ * @param threads Liczba wątków (razem z wywołującym); 0 oznacza wszystkie rdzenie.
+ * @throws std::invalid_argument przy niezgodnych granicach, nodes < 1 lub zbyt dużej liczbie węzłów.
+ */
+CubatureResult tensor_gauss_cubature(MultivariateFunction func, const std::vector<double>& lower,
+                                     const std::vector<double>& upper, int nodes, int threads = 1);
+
+/**
+ * @brief Siatka rzadka Smolyaka zbudowana z kwadratur Gaussa-Legendre'a (technika kombinacji).
+ *
+ * Poziom level składa iloczyny tensorowe reguł o i_1, ..., i_d węzłach dla
+ * level <= i_1 + ... + i_d <= level + d - 1 ze współczynnikami kombinacji Smolyaka; wynik jest dokładny
+ * dla wielomianów stopnia całkowitego <= 2 level - 1. Dla funkcji gładkich daje dokładność bliską
+ * iloczynowi tensorowemu przy wielokrotnie mniejszej liczbie węzłów w wyższych wymiarach.
+ * Błąd szacowany jest jako różnica z poziomem level - 1 (wspólne siatki liczone są raz);
+ * dla level = 1 oszacowanie jest nieskończone.
+ * @throws std::invalid_argument przy niezgodnych granicach lub level < 1.
+ */
+CubatureResult sparse_grid_cubature(MultivariateFunction func, const std::vector<double>& lower,
+                                    const std::vector<double>& upper, int level, int threads = 1);
+
+/// Ciąg niskiej rozbieżności dla metody quasi-Monte Carlo.
+enum class QmcSequence {
+    Sobol, ///< Sobol (liczby kierunkowe Joe-Kuo), co najwyżej 16 wymiarów
+    Halton ///< Halton (kolejne liczby pierwsze), jakość spada dla d powyżej około 10
+};
+
+/**
+ * @brief Całkowanie metodą quasi-Monte Carlo z losowaniem ciągu.
+ *
+ * Punkty dzielone są na 8 niezależnych replik ciągu przesuniętych losowo (dla Sobola cyfrowo, XOR,
+ * co zachowuje strukturę sieci; dla Haltona przesunięcie modulo 1). Wynik to średnia replik, a oszacowanie
+ * błędu to błąd standardowy tej średniej. Ziarno jest stałe, więc wynik jest powtarzalny.
+ * Dla Sobola najlepiej, by points / 8 było potęgą dwójki.
+ * @param points Łączna liczba punktów (co najmniej 8, zaokrąglana w dół do wielokrotności 8).
+ * @throws std::invalid_argument przy niezgodnych granicach, zbyt małej liczbie punktów
+ *         lub wymiarze większym niż 16 dla ciągu Sobola.
+ */
+CubatureResult quasi_monte_carlo_cubature(MultivariateFunction func, const std::vector<double>& lower,
+                                          const std::vector<double>& upper, long long points,
+                                          QmcSequence sequence = QmcSequence::Sobol, int threads = 1);
+
+#endif // CUBATURE_H
\ No newline at end of file
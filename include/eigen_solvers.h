@@ -0,0 +1,71 @@
+#ifndef EIGEN_SOLVERS_H
+#define EIGEN_SOLVERS_H
+
+#include "linear_algebra.h" // dla DenseMatrix i LinearOperator
+
+/**
+ * @file eigen_solvers.h
+ * @brief Wartości i wektory własne: pełny rozkład macierzy symetrycznych gęstych oraz metody
+ *        iteracyjne (potęgowa, Lanczosa) dla skrajnych par własnych dużych operatorów.
+ */
+
+/**
+ * @brief Pary własne: values[j] odpowiada wektorowi w kolumnie j macierzy vectors.
+ */
+struct EigenPairs {
+    Vector values;
+    DenseMatrix vectors;  ///< n x k, kolumny ortonormalne (puste, jeśli wektory nie były liczone)
+    int iterations = 0;   ///< Iteracje QL (rozkład gęsty) lub liczba mnożeń przez operator (Lanczos)
+};
+
+/**
+ * @brief Pełny rozkład własny macierzy symetrycznej A = Z diag(values) Z^T.
+ *
+ * Macierz sprowadzana jest odbiciami Householdera do postaci trójdiagonalnej, a ta diagonalizowana
+ * niejawną metodą QL z przesunięciami Wilkinsona. Wykorzystywana jest tylko dolna część macierzy A.
+ * Koszt to około 4/3 n^3 operacji dla samych wartości i 9 n^3 z wektorami.
+ * @param compute_vectors Czy wyznaczać wektory własne (bez nich pamięć i czas są istotnie mniejsze).
+ * @return Wartości własne rosnąco i (opcjonalnie) odpowiadające im wektory własne.
+ * @throws std::invalid_argument jeśli macierz nie jest kwadratowa lub jest pusta.
+ * @throws std::runtime_error jeśli metoda QL nie osiągnie zbieżności.
+ */
+EigenPairs symmetric_eigen(const DenseMatrix& A, bool compute_vectors = true);
+
+/// Które wartości własne wyznaczać metodą Lanczosa.
+enum class EigenTarget {
+    Largest,  ///< największe algebraicznie
+    Smallest  ///< najmniejsze algebraicznie
+};
+
+/**
+ * @brief Kilka skrajnych par własnych operatora symetrycznego metodą Lanczosa z grubym restartem.
+ *
+ * Baza Kryłowa ma co najwyżej subspace_size wektorów i jest w pełni reortogonalizowana; po jej
+ * wypełnieniu zachowywane są najlepsze wektory Ritza (thick restart), więc pamięć to
+ * O(n * subspace_size) niezależnie od liczby iteracji - macierz n x n nigdy nie powstaje.
+ * Przy jednym wektorze startowym wielokrotna wartość własna jest znajdowana zwykle tylko raz.
+ * Para (theta, y) jest zbieżna, gdy ||A y - theta y|| <= tolerance * max_i |theta_i| (oszacowanie ||A||_2).
+ * @param count Liczba szukanych par (1 <= count <= n).
+ * @param subspace_size Maksymalny wymiar bazy; wartość <= 0 oznacza max(2 count + 1, 20) (nie więcej niż n).
+ * @param max_iterations Limit liczby mnożeń przez operator.
+ * @return Wartości własne (rosnąco dla Smallest, malejąco dla Largest) i wektory własne n x count.
+ * @throws std::invalid_argument przy niepoprawnych parametrach.
+ * @throws std::runtime_error jeśli metoda nie osiągnie zbieżności.
+ */
+EigenPairs lanczos_eigen(
+    const LinearOperator& A, int count, EigenTarget target = EigenTarget::Largest,
+    double tolerance = 1e-10, int max_iterations = 10000, int subspace_size = 0);
+
+/**
+ * @brief Dominująca (o największym module) wartość własna metodą potęgową.
+ *
+ * Nie wymaga symetrii: wystarczy, że dominująca wartość własna jest rzeczywista i jedyna
+ * co do modułu. Zbieżność jest liniowa ze współczynnikiem |lambda_2 / lambda_1|.
+ * Kryterium zbieżności: ||A y - lambda y|| <= tolerance * |lambda|.
+ * @return Jedna para własna (values[0], kolumna 0 macierzy vectors).
+ * @throws std::invalid_argument przy niepoprawnych parametrach.
+ * @throws std::runtime_error jeśli metoda nie osiągnie zbieżności.
+ */
+EigenPairs power_iteration(const LinearOperator& A, double tolerance = 1e-10, int max_iterations = 10000);
+
+#endif // EIGEN_SOLVERS_H
\ No newline at end of file
@@ -3,10 +3,21 @@
 
 #include <functional>
 #include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 /**
  * @file integration.h
  * @brief Deklaracje funkcji do całkowania numerycznego.
+ *
+ * Każda kwadratura ma dwie postaci: przyjmującą std::function (jedno wywołanie pośrednie na węzeł)
+ * oraz szablonową, przyjmującą dowolny obiekt wywoływalny, który kompilator może wkleić w pętlę.
+ * Wersja szablonowa akceptuje też funkcję wsadową o sygnaturze
+ * void(const double* x, double* fx, int count), która wypełnia fx[i] = f(x[i]) dla całej porcji
+ * węzłów naraz - pozwala to liczyć funkcję podcałkową wektorowo (SIMD) bez kosztu wywołania na punkt.
  */
 
 /**
@@ -29,11 +40,1141 @@ double trapezoid_rule(std::function<double(double)> func, double a, double b, in
  */
 double simpson_rule(std::function<double(double)> func, double a, double b, int intervals);
 
+/**
+ * @brief Wielowątkowe wersje kwadratur złożonych (dla kosztownych funkcji podcałkowych).
+ *
+ * Węzły dzielone są na co najwyżej 1024 porcje, których podział zależy wyłącznie od liczby
+ * podprzedziałów; wątki pobierają porcje dynamicznie, a sumy częściowe są dodawane parami w stałej
+ * kolejności. Wynik jest więc identyczny co do bitu dla każdej liczby wątków (może natomiast różnić się
+ * na ostatnich bitach od wersji jednowątkowej, która sumuje w innej kolejności).
+ * Funkcja podcałkowa jest wywoływana współbieżnie i musi być bezpieczna wątkowo.
+ * Wątki robocze są tworzone przy pierwszym wywołaniu i używane ponownie przez kolejne wywołania
+ * z tego samego wątku; kwadratura wywołana wewnątrz funkcji podcałkowej liczona jest sekwencyjnie.
+ * @param threads Liczba wątków (razem z wywołującym); 0 oznacza wszystkie rdzenie.
+ */
+double rectangle_rule(std::function<double(double)> func, double a, double b, int intervals, int threads);
+/// @copydoc rectangle_rule(std::function<double(double)>, double, double, int, int)
+double trapezoid_rule(std::function<double(double)> func, double a, double b, int intervals, int threads);
+/// @copydoc rectangle_rule(std::function<double(double)>, double, double, int, int)
+double simpson_rule(std::function<double(double)> func, double a, double b, int intervals, int threads);
+
+/// Węzły (rosnąco) i wagi kwadratury Gaussa-Legendre'a na przedziale [-1, 1].
+struct GaussRule {
+    std::vector<double> nodes;
+    std::vector<double> weights;
+};
+
+/**
+ * @brief Kwadratura Gaussa-Legendre'a rzędu n (dokładna dla wielomianów stopnia 2n - 1).
+ *
+ * Węzły to pierwiastki wielomianu Legendre'a P_n wyznaczane metodą Newtona z rekurencji
+ * trójwyrazowej. Każdy rząd liczony jest raz i trafia do współdzielonej pamięci podręcznej
+ * (bezpiecznej wątkowo); zwracana referencja pozostaje ważna do końca programu.
+ * @throws std::invalid_argument jeśli n < 1.
+ */
+const GaussRule& gauss_legendre_rule(int n);
+
 /**
  * @brief Oblicza całkę oznaczoną złożoną kwadraturą Gaussa-Legendre'a.
- * @param nodes Liczba węzłów kwadratury (2, 3 lub 4).
+ * @param nodes Liczba węzłów kwadratury na podprzedział (dowolna dodatnia, zob. gauss_legendre_rule).
  * @param subintervals Liczba podprzedziałów, na które dzielony jest główny przedział.
  */
 double gauss_legendre_quadrature(std::function<double(double)> func, double a, double b, int nodes, int subintervals);
 
+/// Wielowątkowa złożona kwadratura Gaussa-Legendre'a; podprzedziały dzielone są między wątki
+/// (zob. rectangle_rule z parametrem threads).
+double gauss_legendre_quadrature(std::function<double(double)> func, double a, double b, int nodes, int subintervals,
+                                 int threads);
+
+/**
+ * @brief Kwadratura Gaussa-Laguerre'a rzędu n: całka po [0, inf) z wagą e^(-x).
+ *
+ * Węzły i wagi liczone są raz i trafiają do wspólnej pamięci podręcznej (jak w gauss_legendre_rule).
+ * Każdy węzeł jest izolowany bisekcją z ciągiem Sturma macierzy Jacobiego i dokładany metodą Newtona,
+ * więc reguła jest poprawna dla dowolnego n (koszt O(n^2), np. ok. 0,3 s dla n = 1000).
+ * Dla dużych n wagi przy największych węzłach są bliskie zera (mogą ulec niedomiarowi).
+ * @throws std::invalid_argument jeśli n < 1.
+ */
+const GaussRule& gauss_laguerre_rule(int n);
+
+/**
+ * @brief Kwadratura Gaussa-Hermite'a rzędu n: całka po (-inf, inf) z wagą e^(-x^2).
+ *
+ * Liczona jak gauss_laguerre_rule; wagi przy skrajnych węzłach mogą ulec niedomiarowi.
+ * @throws std::invalid_argument jeśli n < 1.
+ */
+const GaussRule& gauss_hermite_rule(int n);
+
+/**
+ * @brief Całka z e^(-scale (x - a)) f(x) po [a, inf) kwadraturą Gaussa-Laguerre'a.
+ *
+ * Dokładna dla wielomianów f stopnia <= 2 nodes - 1. Funkcja f nie zawiera czynnika wykładniczego;
+ * całki bez takiego czynnika (np. o zaniku potęgowym) lepiej liczyć tanh_sinh_quadrature z b = inf.
+ * @throws std::invalid_argument jeśli nodes < 1 lub scale <= 0.
+ */
+double gauss_laguerre_quadrature(std::function<double(double)> func, int nodes, double a = 0.0, double scale = 1.0);
+
+/**
+ * @brief Całka z e^(-((x - center) / scale)^2) f(x) po całej prostej kwadraturą Gaussa-Hermite'a.
+ *
+ * Dokładna dla wielomianów f stopnia <= 2 nodes - 1 (np. wartości oczekiwane względem rozkładu normalnego
+ * o średniej center i odchyleniu scale / sqrt(2), po podzieleniu przez scale * sqrt(pi)).
+ * @throws std::invalid_argument jeśli nodes < 1 lub scale <= 0.
+ */
+double gauss_hermite_quadrature(std::function<double(double)> func, int nodes, double center = 0.0, double scale = 1.0);
+
+/// Para kwadratur Gaussa-Kronroda: n-punktowa Gaussa zagnieżdżona w (2n + 1)-punktowej Kronroda.
+enum class KronrodRule {
+    GK15, ///< Gauss 7 / Kronrod 15
+    GK21  ///< Gauss 10 / Kronrod 21
+};
+
+/// Wynik kwadratury z oszacowaniem błędu.
+struct QuadratureResult {
+    double value = 0.0;          ///< Przybliżona wartość całki.
+    double error_estimate = 0.0; ///< Oszacowanie błędu bezwzględnego.
+    int evaluations = 0;         ///< Liczba obliczeń funkcji podcałkowej.
+    int subintervals = 0;        ///< Liczba podprzedziałów w końcowym podziale.
+};
+
+/**
+ * @brief Adaptacyjna kwadratura Gaussa-Kronroda (globalna, jak QAG z QUADPACK).
+ *
+ * Podprzedziały trzymane są w kolejce priorytetowej według oszacowania błędu; w każdym kroku
+ * dzielony na pół jest ten o największym błędzie, więc węzły trafiają tam, gdzie funkcja jest
+ * trudna (piki, osobliwości całkowalne), a gładkie fragmenty pozostają podzielone zgrubnie.
+ * Błąd podprzedziału to |K - G| skalowane jak w QUADPACK. Obliczenie kończy się, gdy suma błędów
+ * spadnie do max(abs_tolerance, rel_tolerance * |wynik|).
+ * @param max_subintervals Limit liczby podprzedziałów.
+ * @return Wartość całki, oszacowanie błędu i liczba obliczeń funkcji.
+ * @throws std::invalid_argument jeśli tolerancje są ujemne lub obie zerowe, albo limit nie jest dodatni.
+ * @throws std::runtime_error jeśli tolerancja nie zostanie osiągnięta w limicie podprzedziałów
+ *         lub funkcja zwróci wartość nieskończoną albo NaN.
+ */
+QuadratureResult adaptive_gauss_kronrod(
+    std::function<double(double)> func, double a, double b,
+    double abs_tolerance = 1e-10, double rel_tolerance = 1e-10,
+    KronrodRule rule = KronrodRule::GK21, int max_subintervals = 1000);
+
+/**
+ * @brief Kwadratura podwójnie wykładnicza (tanh-sinh) dla osobliwości na końcach i przedziałów nieskończonych.
+ *
+ * Zamiana zmiennych x = tanh(pi/2 sinh t) przenosi końce przedziału do nieskończoności, a funkcja
+ * podcałkowa maleje tam podwójnie wykładniczo, więc metoda trapezów w t zbiega bardzo szybko także dla
+ * całkowalnych osobliwości na końcach (np. 1 / sqrt(x), log x). Dla a = -inf lub b = inf użyta jest
+ * odpowiednio zamiana exp-sinh lub sinh-sinh. Funkcja nie jest nigdy liczona w samych końcach.
+ * Nieciągłość funkcji lub jej pochodnej wewnątrz przedziału spowalnia zbieżność - przedział należy
+ * wtedy podzielić w tym punkcie.
+ *
+ * Ograniczenie: węzły bliskie końca c != 0 są zaokrąglane do siatki liczb double wokół c, więc funkcja
+ * osobliwa w c (np. 1 / sqrt(x - 1) na [1, 2]) dostaje x - c z błędem względnym rzędu eps |c| / |x - c|.
+ * Wynik może wtedy odbiegać od całki bardziej niż error_estimate (oszacowanie tego błędu nie obejmuje),
+ * a dla |c| >> b - a zbieżność może nie nastąpić. W takich przypadkach należy użyć
+ * tanh_sinh_quadrature_complement albo przesunąć zmienną tak, by osobliwość była w zerze.
+ * Krok w t jest połowiony (do 8 razy), a wszystkie wcześniejsze węzły są wykorzystywane ponownie; węzły
+ * i wagi każdej zamiany liczone są raz. Zasięg sum w t wynika z samej tablicy (dalej wagi lub odległości
+ * od końców wychodzą poza zakres double); na najrzadszej siatce skrajne węzły są dodatkowo odrzucane od
+ * zewnątrz, dopóki leżą poza przedziałem, dają wartość nieskończoną lub NaN albo wyraz pomijalny względem
+ * sumy modułów wyrazów. Zera funkcji wewnątrz przedziału (np. zwarty nośnik) nie skracają sum.
+ * Błąd szacowany jest z różnic kolejnych przybliżeń przy założeniu zbieżności kwadratowej.
+ * @param a Dolna granica (może być -inf).
+ * @param b Górna granica (może być inf); dla b < a wynik ma przeciwny znak.
+ * @return Wartość całki, oszacowanie błędu i liczba obliczeń funkcji (subintervals = 1).
+ * @throws std::invalid_argument przy niepoprawnych tolerancjach lub granicy NaN.
+ * @throws std::runtime_error jeśli tolerancja nie zostanie osiągnięta lub funkcja zwróci wartość
+ *         nieskończoną albo NaN wewnątrz przedziału.
+ */
+QuadratureResult tanh_sinh_quadrature(std::function<double(double)> func, double a, double b,
+                                      double abs_tolerance = 1e-10, double rel_tolerance = 1e-10);
+
+/**
+ * @brief Kwadratura tanh-sinh, w której funkcja dostaje także dokładną odległość od końca przedziału.
+ *
+ * func(x, xc): xc = a - x (<= 0) w lewej połowie przedziału i xc = b - x (>= 0) w prawej, dla przedziałów
+ * półnieskończonych odległość od skończonego końca. xc jest liczone bez odejmowania (wprost z tablicy
+ * węzłów), więc zachowuje pełną precyzję nawet wtedy, gdy x zaokrągla się do samego końca; osobliwość
+ * w c = a wyraża się przez -xc zamiast x - a (np. 1 / sqrt(-xc) dla xc < 0). Takie węzły nie są pomijane.
+ * Poza tym działa jak tanh_sinh_quadrature (dla b < a xc odnosi się do przedziału [b, a]).
+ * @throws std::invalid_argument jak tanh_sinh_quadrature oraz dla a = -inf i b = inf jednocześnie.
+ * @throws std::runtime_error jak tanh_sinh_quadrature.
+ */
+QuadratureResult tanh_sinh_quadrature_complement(std::function<double(double, double)> func, double a, double b,
+                                                 double abs_tolerance = 1e-10, double rel_tolerance = 1e-10);
+
+/**
+ * @brief Metoda trapezów zagęszczana na żądanie, z ekstrapolacją Richardsona.
+ *
+ * Każde refine() podwaja liczbę podprzedziałów i liczy funkcję tylko w nowych węzłach (środkach
+ * dotychczasowych podprzedziałów) - żaden punkt nie jest liczony dwa razy. Obiekt przechowuje ostatni
+ * wiersz tablicy Romberga, więc z tych samych próbek dostępne jest też przybliżenie wyższego rzędu:
+ * po k zagęszczeniach extrapolated() ma błąd O(h^(2k + 2)) dla funkcji dostatecznie gładkich.
+ */
+class IncrementalTrapezoid {
+public:
+    /**
+     * @brief Liczy początkowe przybliżenie metodą trapezów.
+     * @param intervals Początkowa liczba podprzedziałów.
+     * @throws std::invalid_argument jeśli intervals nie jest dodatnie.
+     */
+    IncrementalTrapezoid(std::function<double(double)> func, double a, double b, int intervals = 1);
+
+    /**
+     * @brief Podwaja liczbę podprzedziałów (intervals() nowych obliczeń funkcji).
+     * @return Nowe przybliżenie metodą trapezów.
+     * @throws std::runtime_error jeśli liczba podprzedziałów przekroczyłaby zakres int.
+     */
+    double refine();
+
+    /// Bieżące przybliżenie metodą trapezów.
+    double value() const { return romberg_row_.front(); }
+    /// Przybliżenie najwyższego rzędu z ekstrapolacji Richardsona (po dotychczasowych zagęszczeniach).
+    double extrapolated() const { return romberg_row_.back(); }
+    /// Moduł różnicy dwóch ostatnich ekstrapolacji (0 przed pierwszym zagęszczeniem).
+    double error_estimate() const { return error_estimate_; }
+    int intervals() const { return intervals_; }
+    int evaluations() const { return evaluations_; }
+
+private:
+    std::function<double(double)> func_;
+    double a_, b_;
+    int intervals_;
+    int evaluations_;
+    double error_estimate_ = 0.0;
+    std::vector<double> romberg_row_; ///< T(h), R(h, 1), ..., R(h, k)
+};
+
+/**
+ * @brief Całkowanie metodą Romberga (metoda trapezów z ekstrapolacją Richardsona).
+ *
+ * Liczba podprzedziałów jest podwajana, a każdy poziom wykorzystuje wszystkie wcześniejsze obliczenia
+ * funkcji (2^k + 1 obliczeń po k poziomach). Dla funkcji gładkich zbieżność jest bardzo szybka; przy
+ * osobliwościach lub nieciągłościach pochodnych lepiej użyć adaptive_gauss_kronrod.
+ * Obliczenie kończy się (nie wcześniej niż po 4 poziomach, by uniknąć przypadkowej zgodności na rzadkiej
+ * siatce), gdy różnica kolejnych ekstrapolacji spadnie do max(abs_tolerance, rel_tolerance * |wynik|).
+ * @param max_levels Maksymalna liczba podwojeń (1..30).
+ * @return Wartość całki, oszacowanie błędu, liczba obliczeń funkcji i końcowa liczba podprzedziałów.
+ * @throws std::invalid_argument przy niepoprawnych tolerancjach lub liczbie poziomów.
+ * @throws std::runtime_error jeśli tolerancja nie zostanie osiągnięta lub funkcja zwróci wartość nieskończoną albo NaN.
+ */
+QuadratureResult romberg_integration(
+    std::function<double(double)> func, double a, double b,
+    double abs_tolerance = 1e-10, double rel_tolerance = 1e-10, int max_levels = 20);
+
+/// Funkcja podcałkowa o wartościach wektorowych: func(x, fx) wypełnia fx[0..count) wartościami count funkcji w x.
+using VectorIntegrand = std::function<void(double, double*)>;
+
+/**
+ * @brief Całkuje count funkcji naraz złożoną metodą trapezów, w jednym przejściu po wspólnych węzłach.
+ *
+ * Każdy węzeł wyznaczany jest raz, a funkcja wektorowa liczy w nim wszystkie składowe (może więc
+ * współdzielić obliczenia, np. kolejne potęgi x przy momentach). Wyniki są równe (z dokładnością do
+ * zaokrągleń) count osobnym wywołaniom trapezoid_rule.
+ * @return Wektor count przybliżonych całek.
+ * @throws std::invalid_argument jeśli count lub intervals nie jest dodatnie.
+ */
+std::vector<double> trapezoid_rule_multi(VectorIntegrand func, int count, double a, double b, int intervals);
+
+/// @brief Całkuje count funkcji naraz złożoną metodą Simpsona (zob. trapezoid_rule_multi).
+std::vector<double> simpson_rule_multi(VectorIntegrand func, int count, double a, double b, int intervals);
+
+/// @brief Całkuje count funkcji naraz złożoną kwadraturą Gaussa-Legendre'a (zob. trapezoid_rule_multi).
+std::vector<double> gauss_legendre_quadrature_multi(VectorIntegrand func, int count, double a, double b,
+                                                    int nodes, int subintervals);
+
+/// @brief Całkuje zbiór funkcji skalarnych na wspólnej siatce (zob. trapezoid_rule_multi).
+std::vector<double> trapezoid_rule_multi(const std::vector<std::function<double(double)>>& funcs,
+                                         double a, double b, int intervals);
+/// @brief Całkuje zbiór funkcji skalarnych na wspólnej siatce metodą Simpsona.
+std::vector<double> simpson_rule_multi(const std::vector<std::function<double(double)>>& funcs,
+                                       double a, double b, int intervals);
+/// @brief Całkuje zbiór funkcji skalarnych na wspólnej siatce kwadraturą Gaussa-Legendre'a.
+std::vector<double> gauss_legendre_quadrature_multi(const std::vector<std::function<double(double)>>& funcs,
+                                                    double a, double b, int nodes, int subintervals);
+
+// --- Całkowanie danych tablicowych (próbek) ---
+
+/**
+ * @brief Całka z n próbek y[i] = f(i * dx) metodą trapezów.
+ * @throws std::invalid_argument jeśli n < 2 lub dx <= 0.
+ */
+double trapezoid_samples(const double* y, int n, double dx);
+
+/**
+ * @brief Całka z n próbek (x[i], y[i]) w nierównych odstępach metodą trapezów.
+ * @throws std::invalid_argument jeśli n < 2 lub x nie jest ściśle rosnące.
+ */
+double trapezoid_samples(const double* x, const double* y, int n);
+
+/**
+ * @brief Całka z n równoodległych próbek metodą Simpsona.
+ *
+ * Przy nieparzystej liczbie przedziałów ostatni przedział całkowany jest parabolą przez trzy
+ * ostatnie próbki (rząd dokładności jak dla Simpsona); dla n = 2 wynik to metoda trapezów.
+ * @throws std::invalid_argument jeśli n < 2 lub dx <= 0.
+ */
+double simpson_samples(const double* y, int n, double dx);
+
+/**
+ * @brief Całka z n próbek w nierównych odstępach metodą Simpsona (parabole przez kolejne trójki punktów).
+ * @throws std::invalid_argument jeśli n < 2 lub x nie jest ściśle rosnące.
+ */
+double simpson_samples(const double* x, const double* y, int n);
+
+/**
+ * @brief Całka nieoznaczona z próbek: result[i] = całka od pierwszej do i-tej próbki (metoda trapezów).
+ * @param result Tablica n wyników (result[0] = 0), może być tą samą tablicą co y.
+ * @throws std::invalid_argument jeśli n < 1 lub dx <= 0.
+ */
+void cumulative_trapezoid(const double* y, int n, double dx, double* result);
+
+/// @brief Całka nieoznaczona z próbek w nierównych odstępach (zob. cumulative_trapezoid).
+void cumulative_trapezoid(const double* x, const double* y, int n, double* result);
+
+/**
+ * @brief Całkowanie strumienia próbek dopisywanych porcjami.
+ *
+ * Obiekt pamięta tylko trzy ostatnie próbki i sumy częściowe, więc pamięć jest stała niezależnie od
+ * długości strumienia, a dopisanie porcji kosztuje tyle, ile jej długość. Wyniki są równe (z dokładnością
+ * do zaokrągleń) funkcjom *_samples wywołanym na całym dotychczasowym ciągu próbek.
+ */
+class SampleIntegrator {
+public:
+    /**
+     * @brief Integrator próbek równoodległych (dopisywanych przez append(y, count)).
+     * @throws std::invalid_argument jeśli spacing <= 0.
+     */
+    explicit SampleIntegrator(double spacing);
+
+    /// Integrator próbek w dowolnych rosnących punktach (dopisywanych przez append(x, y, count)).
+    SampleIntegrator();
+
+    /**
+     * @brief Dopisuje porcję próbek równoodległych.
+     * @param cumulative Opcjonalna tablica count wartości całki od początku strumienia do każdej nowej próbki.
+     * @throws std::invalid_argument jeśli integrator utworzono bez odstępu próbek.
+     */
+    void append(const double* y, int count, double* cumulative = nullptr);
+
+    /**
+     * @brief Dopisuje porcję próbek (x[i], y[i]).
+     * @throws std::invalid_argument jeśli integrator utworzono z odstępem próbek lub x nie rośnie ściśle
+     *         (także względem ostatniej próbki poprzedniej porcji).
+     */
+    void append(const double* x, const double* y, int count, double* cumulative = nullptr);
+
+    /// Całka metodą trapezów po wszystkich dotychczasowych próbkach.
+    double trapezoid() const { return trapezoid_; }
+    /// Całka metodą Simpsona po wszystkich dotychczasowych próbkach (zob. simpson_samples).
+    double simpson() const;
+    /// Liczba dotychczasowych próbek.
+    long long samples() const { return samples_; }
+
+private:
+    void push(double h, double y);
+
+    double spacing_;                     ///< 0 dla próbek nierównoodległych
+    long long samples_ = 0;
+    double last_x_ = 0.0;                ///< Położenie ostatniej próbki (tylko próbki nierównoodległe)
+    double h_[2] = { 0.0, 0.0 };         ///< Dwa ostatnie odstępy między próbkami (h_[1] - najnowszy)
+    double y_[3] = { 0.0, 0.0, 0.0 };    ///< Trzy ostatnie wartości (y_[2] - najnowsza)
+    double trapezoid_ = 0.0;
+    double simpson_even_ = 0.0;          ///< Simpson po najdłuższym początkowym odcinku o parzystej liczbie przedziałów
+};
+
+// --- Implementacja wspólna dla wersji std::function i szablonowych ---
+
+namespace integration_detail {
+    /// Liczba węzłów liczonych jednym wywołaniem funkcji (bufory na stosie).
+    constexpr int BATCH_SIZE = 128;
+
+    /// Wspólna walidacja argumentów kwadratur złożonych.
+    void check_intervals(int intervals, const char* message);
+
+    /// Sprawdza tolerancje kwadratur adaptacyjnych.
+    inline void check_tolerances(double abs_tolerance, double rel_tolerance) {
+        if (abs_tolerance < 0.0 || rel_tolerance < 0.0 || (abs_tolerance == 0.0 && rel_tolerance == 0.0)) {
+            throw std::invalid_argument("Tolerances must be non-negative and at least one must be positive.");
+        }
+    }
+
+    /// Największa liczba porcji w trybie wielowątkowym (podział nie zależy od liczby wątków).
+    constexpr int PARALLEL_CHUNKS = 1024;
+
+    /// Wykonuje body(c) dla c = 0 .. chunks-1 na threads wątkach (porcje przydzielane dynamicznie).
+    /// Pula wątków jest zachowywana między wywołaniami; wywołania zagnieżdżone działają sekwencyjnie.
+    void run_chunks(int chunks, int threads, const std::function<void(int)>& body);
+
+    /// Suma v[0..n) liczona parami w stałej kolejności.
+    inline double pairwise_sum(const double* v, int n) {
+        if (n <= 8) {
+            double sum = 0.0;
+            for (int i = 0; i < n; ++i) {
+                sum += v[i];
+            }
+            return sum;
+        }
+        return pairwise_sum(v, n / 2) + pairwise_sum(v + n / 2, n - n / 2);
+    }
+
+    /// Czy F jest funkcją wsadową void(const double* x, double* fx, int count).
+    template <typename F>
+    constexpr bool is_batch_integrand = std::is_invocable_v<F&, const double*, double*, int>;
+
+    /// fx[k] = f(x[k]) dla k < count.
+    template <typename F>
+    inline void evaluate(F& func, const double* x, double* fx, int count) {
+        if constexpr (is_batch_integrand<F>) {
+            func(x, fx, count);
+        }
+        else {
+            for (int k = 0; k < count; ++k) {
+                fx[k] = func(x[k]);
+            }
+        }
+    }
+
+    /// Suma w[k] * fx[k] z czterema niezależnymi sumami częściowymi (wektoryzowalna bez -ffast-math).
+    inline double weighted_sum(const double* w, const double* fx, int count) {
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        int k = 0;
+        for (; k + 4 <= count; k += 4) {
+            s0 += w[k] * fx[k];
+            s1 += w[k + 1] * fx[k + 1];
+            s2 += w[k + 2] * fx[k + 2];
+            s3 += w[k + 3] * fx[k + 3];
+        }
+        for (; k < count; ++k) {
+            s0 += w[k] * fx[k];
+        }
+        return (s0 + s1) + (s2 + s3);
+    }
+
+    /// Suma f(a + i h) dla first <= i < last, z wagą even_weight dla parzystych i oraz odd_weight dla nieparzystych.
+    template <typename F>
+    double uniform_sum(F& func, double a, double h, int first, int last, double even_weight, double odd_weight) {
+        // BATCH_SIZE jest parzyste, więc wzór wag jest w każdej porcji ten sam
+        double x[BATCH_SIZE], fx[BATCH_SIZE], w[BATCH_SIZE];
+        for (int k = 0; k < BATCH_SIZE; ++k) {
+            w[k] = ((first + k) % 2 == 0) ? even_weight : odd_weight;
+        }
+        double sum = 0.0;
+        for (int start = first; start < last; start += BATCH_SIZE) {
+            const int count = std::min(BATCH_SIZE, last - start);
+            for (int k = 0; k < count; ++k) {
+                x[k] = a + (start + k) * h;
+            }
+            evaluate(func, x, fx, count);
+            sum += weighted_sum(w, fx, count);
+        }
+        return sum;
+    }
+
+    /// uniform_sum liczona porcjami na wielu wątkach (wynik niezależny od liczby wątków).
+    template <typename F>
+    double parallel_uniform_sum(F& func, double a, double h, int first, int last,
+                                double even_weight, double odd_weight, int threads) {
+        const int total = last - first;
+        if (total <= 0) {
+            return 0.0;
+        }
+        const int chunk = (total + PARALLEL_CHUNKS - 1) / PARALLEL_CHUNKS;
+        const int chunks = (total + chunk - 1) / chunk;
+        std::vector<double> partial(chunks);
+        run_chunks(chunks, threads, [&](int c) {
+            const int begin = first + c * chunk;
+            partial[c] = uniform_sum(func, a, h, begin, std::min(last, begin + chunk), even_weight, odd_weight);
+        });
+        return pairwise_sum(partial.data(), chunks);
+    }
+
+    template <typename F>
+    double endpoint_sum(F& func, double a, double b) {
+        const double x[2] = { a, b };
+        double fx[2];
+        evaluate(func, x, fx, 2);
+        return fx[0] + fx[1];
+    }
+
+    template <typename F>
+    double rectangle(F& func, double a, double b, int intervals) {
+        check_intervals(intervals, "Number of intervals must be positive.");
+        const double h = (b - a) / intervals;
+        return uniform_sum(func, a, h, 0, intervals, 1.0, 1.0) * h;
+    }
+
+    template <typename F>
+    double trapezoid(F& func, double a, double b, int intervals) {
+        check_intervals(intervals, "Number of intervals must be positive.");
+        const double h = (b - a) / intervals;
+        return (0.5 * endpoint_sum(func, a, b) + uniform_sum(func, a, h, 1, intervals, 1.0, 1.0)) * h;
+    }
+
+    template <typename F>
+    double simpson(F& func, double a, double b, int intervals) {
+        check_intervals(intervals, "Number of intervals must be positive.");
+        if (intervals % 2 != 0) ++intervals; // Simpson's rule requires an even number of intervals
+        const double h = (b - a) / intervals;
+        return (h / 3.0) * (endpoint_sum(func, a, b) + uniform_sum(func, a, h, 1, intervals, 2.0, 4.0));
+    }
+
+    template <typename F>
+    double rectangle(F& func, double a, double b, int intervals, int threads) {
+        check_intervals(intervals, "Number of intervals must be positive.");
+        const double h = (b - a) / intervals;
+        return parallel_uniform_sum(func, a, h, 0, intervals, 1.0, 1.0, threads) * h;
+    }
+
+    template <typename F>
+    double trapezoid(F& func, double a, double b, int intervals, int threads) {
+        check_intervals(intervals, "Number of intervals must be positive.");
+        const double h = (b - a) / intervals;
+        return (0.5 * endpoint_sum(func, a, b) + parallel_uniform_sum(func, a, h, 1, intervals, 1.0, 1.0, threads)) * h;
+    }
+
+    template <typename F>
+    double simpson(F& func, double a, double b, int intervals, int threads) {
+        check_intervals(intervals, "Number of intervals must be positive.");
+        if (intervals % 2 != 0) ++intervals; // Simpson's rule requires an even number of intervals
+        const double h = (b - a) / intervals;
+        return (h / 3.0) * (endpoint_sum(func, a, b) + parallel_uniform_sum(func, a, h, 1, intervals, 2.0, 4.0, threads));
+    }
+
+    /// Suma w_q f(x_jq) po podprzedziałach first <= j < last (bez czynnika h / 2).
+    template <typename F>
+    double gauss_sum(F& func, const GaussRule& rule, double a, double h, int first, int last) {
+        const int nodes = static_cast<int>(rule.nodes.size());
+        const double half = 0.5 * h;
+        double x[BATCH_SIZE], fx[BATCH_SIZE], w[BATCH_SIZE], offset[BATCH_SIZE];
+        double sum = 0.0;
+        if (nodes <= BATCH_SIZE) {
+            // Porcja obejmuje całe podprzedziały, więc przesunięcia węzłów i wzór wag są w każdej te same
+            const int per_chunk = BATCH_SIZE / nodes;
+            for (int k = 0; k < per_chunk * nodes; ++k) {
+                w[k] = rule.weights[k % nodes];
+            }
+            for (int q = 0; q < nodes; ++q) {
+                offset[q] = half * rule.nodes[q];
+            }
+            for (int j0 = first; j0 < last; j0 += per_chunk) {
+                const int chunk = std::min(per_chunk, last - j0);
+                const int count = chunk * nodes;
+                for (int j = 0; j < chunk; ++j) {
+                    const double center = a + (j0 + j + 0.5) * h;
+                    for (int q = 0; q < nodes; ++q) {
+                        x[j * nodes + q] = center + offset[q];
+                    }
+                }
+                evaluate(func, x, fx, count);
+                sum += weighted_sum(w, fx, count);
+            }
+        }
+        else {
+            // Kwadratura wysokiego rzędu: węzły jednego podprzedziału dzielone na porcje
+            for (int j = first; j < last; ++j) {
+                const double center = a + (j + 0.5) * h;
+                for (int q0 = 0; q0 < nodes; q0 += BATCH_SIZE) {
+                    const int count = std::min(BATCH_SIZE, nodes - q0);
+                    for (int k = 0; k < count; ++k) {
+                        x[k] = center + half * rule.nodes[q0 + k];
+                    }
+                    evaluate(func, x, fx, count);
+                    sum += weighted_sum(rule.weights.data() + q0, fx, count);
+                }
+            }
+        }
+        return sum;
+    }
+
+    template <typename F>
+    double gauss_legendre(F& func, double a, double b, int nodes, int subintervals) {
+        check_intervals(subintervals, "Number of subintervals must be positive.");
+        const GaussRule& rule = gauss_legendre_rule(nodes);
+        const double h = (b - a) / subintervals;
+        return 0.5 * h * gauss_sum(func, rule, a, h, 0, subintervals);
+    }
+
+    template <typename F>
+    double gauss_legendre(F& func, double a, double b, int nodes, int subintervals, int threads) {
+        check_intervals(subintervals, "Number of subintervals must be positive.");
+        const GaussRule& rule = gauss_legendre_rule(nodes);
+        const double h = (b - a) / subintervals;
+        const int chunk = (subintervals + PARALLEL_CHUNKS - 1) / PARALLEL_CHUNKS;
+        const int chunks = (subintervals + chunk - 1) / chunk;
+        std::vector<double> partial(chunks);
+        run_chunks(chunks, threads, [&](int c) {
+            const int begin = c * chunk;
+            partial[c] = gauss_sum(func, rule, a, h, begin, std::min(subintervals, begin + chunk));
+        });
+        return 0.5 * h * pairwise_sum(partial.data(), chunks);
+    }
+
+    /// Węzły i wagi pary Gaussa-Kronroda na [-1, 1] (wagi Gaussa zerowe w węzłach tylko Kronroda).
+    struct KronrodNodes {
+        int size;
+        const double* nodes;
+        const double* kronrod_weights;
+        const double* gauss_weights;
+    };
+    constexpr int MAX_KRONROD_NODES = 21;
+
+    const KronrodNodes& kronrod_nodes(KronrodRule rule);
+
+    struct Segment {
+        double a, b, value, error;
+        bool operator<(const Segment& other) const { return error < other.error; }
+    };
+
+    /// Kwadratura Gaussa-Kronroda na count <= 2 podprzedziałach, z jednym wywołaniem funkcji dla wszystkich węzłów.
+    template <typename F>
+    void kronrod_segments(F& func, const KronrodNodes& rule, Segment* segments, int count) {
+        double x[2 * MAX_KRONROD_NODES], fx[2 * MAX_KRONROD_NODES];
+        const int n = rule.size;
+        for (int s = 0; s < count; ++s) {
+            const double center = 0.5 * (segments[s].a + segments[s].b);
+            const double half = 0.5 * (segments[s].b - segments[s].a);
+            for (int k = 0; k < n; ++k) {
+                x[s * n + k] = center + half * rule.nodes[k];
+            }
+        }
+        evaluate(func, x, fx, count * n);
+
+        const double eps = std::numeric_limits<double>::epsilon();
+        const double uflow = std::numeric_limits<double>::min();
+        for (int s = 0; s < count; ++s) {
+            const double* f = fx + s * n;
+            double kronrod = 0.0, gauss = 0.0, absolute = 0.0;
+            for (int k = 0; k < n; ++k) {
+                kronrod += rule.kronrod_weights[k] * f[k];
+                gauss += rule.gauss_weights[k] * f[k];
+                absolute += rule.kronrod_weights[k] * std::abs(f[k]);
+            }
+            // Odchylenie od średniej: skala, do której odnoszony jest błąd |K - G|
+            const double mean = 0.5 * kronrod;
+            double deviation = 0.0;
+            for (int k = 0; k < n; ++k) {
+                deviation += rule.kronrod_weights[k] * std::abs(f[k] - mean);
+            }
+            const double half = 0.5 * std::abs(segments[s].b - segments[s].a);
+            const double signed_half = 0.5 * (segments[s].b - segments[s].a);
+            double error = std::abs((kronrod - gauss) * half);
+            deviation *= half;
+            absolute *= half;
+            if (deviation != 0.0 && error != 0.0) {
+                error = deviation * std::min(1.0, std::pow(200.0 * error / deviation, 1.5));
+            }
+            if (absolute > uflow / (50.0 * eps)) {
+                error = std::max(50.0 * eps * absolute, error);
+            }
+            segments[s].value = kronrod * signed_half;
+            segments[s].error = error;
+        }
+    }
+
+    template <typename F>
+    QuadratureResult adaptive_gauss_kronrod(F& func, double a, double b, double abs_tolerance,
+                                            double rel_tolerance, KronrodRule rule, int max_subintervals) {
+        check_tolerances(abs_tolerance, rel_tolerance);
+        check_intervals(max_subintervals, "Maximum number of subintervals must be positive.");
+        const KronrodNodes& nodes = kronrod_nodes(rule);
+
+        // Kopiec podprzedziałów (największy błąd na szczycie)
+        std::vector<Segment> heap;
+        heap.reserve(max_subintervals);
+        Segment first{ a, b, 0.0, 0.0 };
+        kronrod_segments(func, nodes, &first, 1);
+        heap.push_back(first);
+        QuadratureResult result;
+        result.evaluations = nodes.size;
+        double value = first.value;
+        double error = first.error;
+
+        for (;;) {
+            // Sprawdzane przed warunkiem stopu: dla NaN porównanie jest fałszywe, a dla nieskończonej
+            // wartości tolerancja względna też jest nieskończona, więc pętla kończyłaby się od razu
+            if (!std::isfinite(value) || !std::isfinite(error)) {
+                throw std::runtime_error("Function returned a non-finite value during adaptive quadrature.");
+            }
+            if (error <= std::max(abs_tolerance, rel_tolerance * std::abs(value))) {
+                break;
+            }
+            if (static_cast<int>(heap.size()) >= max_subintervals) {
+                throw std::runtime_error("Adaptive quadrature did not converge within the maximum number of subintervals.");
+            }
+            std::pop_heap(heap.begin(), heap.end());
+            const Segment worst = heap.back();
+            heap.pop_back();
+            const double mid = 0.5 * (worst.a + worst.b);
+            Segment halves[2] = { { worst.a, mid, 0.0, 0.0 }, { mid, worst.b, 0.0, 0.0 } };
+            kronrod_segments(func, nodes, halves, 2);
+            result.evaluations += 2 * nodes.size;
+            value += halves[0].value + halves[1].value - worst.value;
+            error += halves[0].error + halves[1].error - worst.error;
+            for (const Segment& half : halves) {
+                heap.push_back(half);
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+
+        // Sumy liczone od nowa usuwają błędy zaokrągleń z aktualizacji przyrostowych
+        result.value = 0.0;
+        result.error_estimate = 0.0;
+        for (const Segment& s : heap) {
+            result.value += s.value;
+            result.error_estimate += s.error;
+        }
+        result.subintervals = static_cast<int>(heap.size());
+        return result;
+    }
+
+    /// Suma f w środkach intervals podprzedziałów długości h zaczynających się w a.
+    template <typename F>
+    double midpoint_sum(F& func, double a, double h, int intervals) {
+        return uniform_sum(func, a + 0.5 * h, h, 0, intervals, 1.0, 1.0);
+    }
+
+    /// sums[m] += suma f_m(a + i h) dla first <= i < last, z wagą even_weight (i parzyste) lub odd_weight.
+    template <typename F>
+    void uniform_sum_multi(F& func, int count, double a, double h, int first, int last,
+                           double even_weight, double odd_weight, double* sums) {
+        // Osobne sumy dla węzłów parzystych i nieparzystych: bez mnożenia przez wagę w pętli
+        std::vector<double> fx(count), even(count, 0.0), odd(count, 0.0);
+        for (int i = first; i < last; ++i) {
+            func(a + i * h, fx.data());
+            double* target = (i % 2 == 0) ? even.data() : odd.data();
+            for (int m = 0; m < count; ++m) {
+                target[m] += fx[m];
+            }
+        }
+        for (int m = 0; m < count; ++m) {
+            sums[m] += even_weight * even[m] + odd_weight * odd[m];
+        }
+    }
+
+    /// sums[m] += f_m(a) + f_m(b).
+    template <typename F>
+    void endpoint_sum_multi(F& func, int count, double a, double b, double* sums) {
+        std::vector<double> fa(count), fb(count);
+        func(a, fa.data());
+        func(b, fb.data());
+        for (int m = 0; m < count; ++m) {
+            sums[m] += fa[m] + fb[m];
+        }
+    }
+
+    template <typename F>
+    std::vector<double> trapezoid_multi(F& func, int count, double a, double b, int intervals) {
+        check_intervals(count, "Number of integrands must be positive.");
+        check_intervals(intervals, "Number of intervals must be positive.");
+        const double h = (b - a) / intervals;
+        std::vector<double> ends(count, 0.0), result(count, 0.0);
+        endpoint_sum_multi(func, count, a, b, ends.data());
+        uniform_sum_multi(func, count, a, h, 1, intervals, 1.0, 1.0, result.data());
+        for (int m = 0; m < count; ++m) {
+            result[m] = (0.5 * ends[m] + result[m]) * h;
+        }
+        return result;
+    }
+
+    template <typename F>
+    std::vector<double> simpson_multi(F& func, int count, double a, double b, int intervals) {
+        check_intervals(count, "Number of integrands must be positive.");
+        check_intervals(intervals, "Number of intervals must be positive.");
+        if (intervals % 2 != 0) ++intervals; // Simpson's rule requires an even number of intervals
+        const double h = (b - a) / intervals;
+        std::vector<double> result(count, 0.0);
+        endpoint_sum_multi(func, count, a, b, result.data());
+        uniform_sum_multi(func, count, a, h, 1, intervals, 2.0, 4.0, result.data());
+        for (int m = 0; m < count; ++m) {
+            result[m] *= h / 3.0;
+        }
+        return result;
+    }
+
+    template <typename F>
+    std::vector<double> gauss_legendre_multi(F& func, int count, double a, double b, int nodes, int subintervals) {
+        check_intervals(count, "Number of integrands must be positive.");
+        check_intervals(subintervals, "Number of subintervals must be positive.");
+        const GaussRule& rule = gauss_legendre_rule(nodes);
+        const double h = (b - a) / subintervals;
+        const double half = 0.5 * h;
+        std::vector<double> fx(count), result(count, 0.0);
+        for (int j = 0; j < subintervals; ++j) {
+            const double center = a + (j + 0.5) * h;
+            for (int q = 0; q < nodes; ++q) {
+                func(center + half * rule.nodes[q], fx.data());
+                const double w = rule.weights[q];
+                for (int m = 0; m < count; ++m) {
+                    result[m] += w * fx[m];
+                }
+            }
+        }
+        for (int m = 0; m < count; ++m) {
+            result[m] *= half;
+        }
+        return result;
+    }
+
+    /// Zastępuje ostatni wiersz tablicy Romberga następnym (dłuższym o jeden), zaczynającym się od T(h / 2).
+    inline void romberg_row(std::vector<double>& row, double trapezoid) {
+        const std::size_t k = row.size();
+        row.push_back(0.0);
+        double current = trapezoid;
+        double factor = 1.0;
+        for (std::size_t j = 0; j < k; ++j) {
+            const double previous = row[j];
+            row[j] = current;
+            factor *= 4.0;
+            current += (current - previous) / (factor - 1.0);
+        }
+        row[k] = current;
+    }
+
+    template <typename F>
+    QuadratureResult romberg(F& func, double a, double b, double abs_tolerance, double rel_tolerance, int max_levels) {
+        check_tolerances(abs_tolerance, rel_tolerance);
+        if (max_levels < 1 || max_levels > 30) {
+            throw std::invalid_argument("Number of Romberg levels must be between 1 and 30.");
+        }
+        constexpr int MIN_LEVELS = 4;
+        const double length = b - a;
+        std::vector<double> row{ 0.5 * length * endpoint_sum(func, a, b) };
+        row.reserve(max_levels + 1);
+        QuadratureResult result;
+        result.evaluations = 2;
+        int intervals = 1;
+        for (int level = 1; level <= max_levels; ++level) {
+            const double h = length / intervals;
+            const double trapezoid = 0.5 * (row.front() + h * midpoint_sum(func, a, h, intervals));
+            result.evaluations += intervals;
+            intervals *= 2;
+            const double previous = row.back();
+            romberg_row(row, trapezoid);
+            result.value = row.back();
+            result.error_estimate = std::abs(result.value - previous);
+            result.subintervals = intervals;
+            if (!std::isfinite(result.value)) {
+                throw std::runtime_error("Function returned a non-finite value during Romberg integration.");
+            }
+            if (level >= std::min(MIN_LEVELS, max_levels) &&
+                result.error_estimate <= std::max(abs_tolerance, rel_tolerance * std::abs(result.value))) {
+                return result;
+            }
+        }
+        throw std::runtime_error("Romberg integration did not converge within the maximum number of levels.");
+    }
+
+    /// Suma w_i f(shift + scale x_i) po węzłach reguły (porcjami po BATCH_SIZE).
+    template <typename F>
+    double scaled_rule_sum(F& func, const GaussRule& rule, double shift, double scale) {
+        const int n = static_cast<int>(rule.nodes.size());
+        double x[BATCH_SIZE], fx[BATCH_SIZE];
+        double sum = 0.0;
+        for (int start = 0; start < n; start += BATCH_SIZE) {
+            const int count = std::min(BATCH_SIZE, n - start);
+            for (int k = 0; k < count; ++k) {
+                x[k] = shift + scale * rule.nodes[start + k];
+            }
+            evaluate(func, x, fx, count);
+            sum += weighted_sum(rule.weights.data() + start, fx, count);
+        }
+        return sum;
+    }
+
+    inline void check_scale(double scale) {
+        if (!(scale > 0.0)) throw std::invalid_argument("Scale must be positive.");
+    }
+
+    template <typename F>
+    double gauss_laguerre(F& func, int nodes, double a, double scale) {
+        check_scale(scale);
+        return scaled_rule_sum(func, gauss_laguerre_rule(nodes), a, 1.0 / scale) / scale;
+    }
+
+    template <typename F>
+    double gauss_hermite(F& func, int nodes, double center, double scale) {
+        check_scale(scale);
+        return scale * scaled_rule_sum(func, gauss_hermite_rule(nodes), center, scale);
+    }
+
+    /// Zamiana zmiennych kwadratury podwójnie wykładniczej.
+    enum class DeTransform {
+        Finite,       ///< tanh-sinh: [a, b]
+        HalfInfinite, ///< exp-sinh: [a, inf) lub (-inf, b]
+        Infinite      ///< sinh-sinh: (-inf, inf)
+    };
+
+    /// Węzeł dla t >= 0: odległość od punktu odniesienia i waga dla +t (right) oraz -t (left).
+    struct DeNode {
+        double t;
+        double right_offset, right_weight;
+        double left_offset, left_weight;
+    };
+
+    constexpr int DE_MAX_LEVEL = 8;
+
+    /// levels[0]: t = 0, 1, 2, ...; levels[k]: nieparzyste wielokrotności 2^-k (rosnąco).
+    /// Węzły z t >= right_limit (left_limit) mają odległość od końca lub wagę poza zakresem double.
+    struct DeTable {
+        std::vector<std::vector<DeNode>> levels;
+        double right_limit = 0.0, left_limit = 0.0;
+    };
+
+    /// Tablica węzłów danej zamiany (liczona raz, bezpieczna wątkowo).
+    const DeTable& de_table(DeTransform transform);
+
+    /// Wspólna część obu wariantów: sample(x, xc) zwraca wartość funkcji w x, gdzie xc to odległość x
+    /// od najbliższego skończonego końca ze znakiem (a - x <= 0 w lewej połowie, b - x >= 0 w prawej).
+    /// Przy with_complement węzły, w których x zaokrągla się do końca przedziału, nie są pomijane.
+    template <typename G>
+    QuadratureResult tanh_sinh_core(G& sample, double a, double b, double abs_tolerance, double rel_tolerance,
+                                    bool with_complement) {
+        check_tolerances(abs_tolerance, rel_tolerance);
+        if (std::isnan(a) || std::isnan(b)) {
+            throw std::invalid_argument("Integration limits must not be NaN.");
+        }
+        if (a == b) {
+            return QuadratureResult();
+        }
+        if (a > b) {
+            QuadratureResult reversed = tanh_sinh_core(sample, b, a, abs_tolerance, rel_tolerance, with_complement);
+            reversed.value = -reversed.value;
+            return reversed;
+        }
+
+        const bool lower_infinite = std::isinf(a), upper_infinite = std::isinf(b);
+        const DeTransform transform = (lower_infinite && upper_infinite) ? DeTransform::Infinite
+            : (lower_infinite || upper_infinite) ? DeTransform::HalfInfinite : DeTransform::Finite;
+        const double half = 0.5 * (b - a);
+        const double factor = (transform == DeTransform::Finite) ? half : 1.0;
+        // Tablica przechowuje odległości od końców, więc xc jest dokładne; samo x = a + (x - a) traci
+        // jednak cyfry przy końcu różnym od zera (np. dla a = 1 odległości poniżej 1e-16 znikają)
+        auto abscissa = [&](double offset, bool right, double& complement) {
+            switch (transform) {
+            case DeTransform::Finite:
+                complement = right ? half * offset : -half * offset;
+                return right ? b - half * offset : a + half * offset;
+            case DeTransform::HalfInfinite:
+                complement = upper_infinite ? -offset : offset;
+                return upper_infinite ? a + offset : b - offset;
+            default:
+                complement = right ? offset : -offset;
+                return complement;
+            }
+        };
+        const DeTable& table = de_table(transform);
+        const double epsilon = std::numeric_limits<double>::epsilon();
+
+        QuadratureResult result;
+        result.subintervals = 1;
+        auto term = [&](double offset, double weight, bool right, bool& inside) {
+            double complement = 0.0;
+            const double x = abscissa(offset, right, complement);
+            inside = with_complement ? (complement != 0.0 && x >= a && x <= b && std::isfinite(x)) : (x > a && x < b);
+            if (!inside) return 0.0;
+            ++result.evaluations;
+            return weight * sample(x, complement);
+        };
+
+        // Najrzadsza siatka (h = 1) w całym zasięgu tablicy. Ogony przycinane są tylko od zewnątrz: skrajne
+        // węzły poza przedziałem, z wartością nieskończoną lub NaN albo pomijalne względem sumy modułów
+        // wyrazów. Zera funkcji bliżej środka (np. przy zwartym nośniku) nie skracają więc sum
+        const std::vector<DeNode>& coarse = table.levels[0];
+        bool inside = true;
+        double sum = term(coarse[0].right_offset, coarse[0].right_weight, true, inside);
+        double magnitude = std::isfinite(sum) ? std::abs(sum) : 0.0;
+        double limits[2] = { table.right_limit, table.left_limit }; // prawa, lewa strona
+        std::vector<double> values[2];
+        for (int side = 0; side < 2; ++side) {
+            values[side].push_back(0.0); // środek policzony wyżej
+            for (std::size_t j = 1; j < coarse.size() && coarse[j].t < limits[side]; ++j) {
+                const DeNode& node = coarse[j];
+                double value = (side == 0) ? term(node.right_offset, node.right_weight, true, inside)
+                                           : term(node.left_offset, node.left_weight, false, inside);
+                if (!inside) {
+                    value = std::numeric_limits<double>::quiet_NaN();
+                }
+                if (std::isfinite(value)) {
+                    magnitude += std::abs(value);
+                }
+                values[side].push_back(value);
+            }
+        }
+        for (int side = 0; side < 2; ++side) {
+            std::size_t last = values[side].size() - 1;
+            while (last >= 1 && (!std::isfinite(values[side][last]) ||
+                                 (magnitude > 0.0 && std::abs(values[side][last]) <= epsilon * magnitude))) {
+                limits[side] = coarse[last].t;
+                --last;
+            }
+            for (std::size_t j = 1; j <= last; ++j) {
+                sum += values[side][j];
+            }
+        }
+        if (!std::isfinite(sum)) {
+            throw std::runtime_error("Function returned a non-finite value during tanh-sinh quadrature.");
+        }
+
+        double h = 1.0;
+        double estimate = factor * sum;
+        double previous_difference = 0.0;
+        for (int level = 1; level <= DE_MAX_LEVEL; ++level) {
+            h *= 0.5;
+            for (const DeNode& node : table.levels[level]) {
+                if (node.t >= limits[0] && node.t >= limits[1]) break;
+                if (node.t < limits[0]) sum += term(node.right_offset, node.right_weight, true, inside);
+                if (node.t < limits[1]) sum += term(node.left_offset, node.left_weight, false, inside);
+            }
+            if (!std::isfinite(sum)) {
+                throw std::runtime_error("Function returned a non-finite value during tanh-sinh quadrature.");
+            }
+            const double refined = factor * h * sum;
+            const double difference = std::abs(refined - estimate);
+            estimate = refined;
+            // Przy zbieżności kwadratowej błąd nowego przybliżenia to około d_k^2 / d_(k-1)
+            result.error_estimate = (level > 1 && previous_difference > difference)
+                ? difference * difference / previous_difference : difference;
+            previous_difference = difference;
+            result.value = estimate;
+            if (result.error_estimate <= std::max(abs_tolerance, rel_tolerance * std::abs(estimate))) {
+                return result;
+            }
+        }
+        throw std::runtime_error("Tanh-sinh quadrature did not converge within the maximum number of levels.");
+    }
+
+    template <typename F>
+    QuadratureResult tanh_sinh(F& func, double a, double b, double abs_tolerance, double rel_tolerance) {
+        double x[1], fx[1];
+        auto sample = [&](double point, double) {
+            x[0] = point;
+            evaluate(func, x, fx, 1);
+            return fx[0];
+        };
+        return tanh_sinh_core(sample, a, b, abs_tolerance, rel_tolerance, false);
+    }
+
+    template <typename F>
+    QuadratureResult tanh_sinh_complement(F& func, double a, double b, double abs_tolerance, double rel_tolerance) {
+        if (std::isinf(a) && std::isinf(b)) {
+            throw std::invalid_argument("Endpoint distances require at least one finite integration limit.");
+        }
+        auto sample = [&](double point, double complement) { return static_cast<double>(func(point, complement)); };
+        return tanh_sinh_core(sample, a, b, abs_tolerance, rel_tolerance, true);
+    }
+} // namespace integration_detail
+
+// --- Przeciążenia szablonowe (dowolny obiekt wywoływalny lub funkcja wsadowa) ---
+
+/**
+ * @brief Złożona metoda prostokątów dla dowolnego obiektu wywoływalnego.
+ * @param func double(double) albo funkcja wsadowa void(const double* x, double* fx, int count).
+ */
+template <typename F>
+double rectangle_rule(F&& func, double a, double b, int intervals) {
+    return integration_detail::rectangle(func, a, b, intervals);
+}
+
+/// @brief Złożona metoda trapezów dla dowolnego obiektu wywoływalnego (zob. rectangle_rule).
+template <typename F>
+double trapezoid_rule(F&& func, double a, double b, int intervals) {
+    return integration_detail::trapezoid(func, a, b, intervals);
+}
+
+/// @brief Złożona metoda Simpsona dla dowolnego obiektu wywoływalnego (zob. rectangle_rule).
+template <typename F>
+double simpson_rule(F&& func, double a, double b, int intervals) {
+    return integration_detail::simpson(func, a, b, intervals);
+}
+
+/// @brief Złożona kwadratura Gaussa-Legendre'a dla dowolnego obiektu wywoływalnego (zob. rectangle_rule).
+template <typename F>
+double gauss_legendre_quadrature(F&& func, double a, double b, int nodes, int subintervals) {
+    return integration_detail::gauss_legendre(func, a, b, nodes, subintervals);
+}
+
+/// @brief Wielowątkowa metoda prostokątów dla dowolnego obiektu wywoływalnego (zob. wersję std::function).
+template <typename F>
+double rectangle_rule(F&& func, double a, double b, int intervals, int threads) {
+    return integration_detail::rectangle(func, a, b, intervals, threads);
+}
+
+/// @brief Wielowątkowa metoda trapezów dla dowolnego obiektu wywoływalnego.
+template <typename F>
+double trapezoid_rule(F&& func, double a, double b, int intervals, int threads) {
+    return integration_detail::trapezoid(func, a, b, intervals, threads);
+}
+
+/// @brief Wielowątkowa metoda Simpsona dla dowolnego obiektu wywoływalnego.
+template <typename F>
+double simpson_rule(F&& func, double a, double b, int intervals, int threads) {
+    return integration_detail::simpson(func, a, b, intervals, threads);
+}
+
+/// @brief Wielowątkowa kwadratura Gaussa-Legendre'a dla dowolnego obiektu wywoływalnego.
+template <typename F>
+double gauss_legendre_quadrature(F&& func, double a, double b, int nodes, int subintervals, int threads) {
+    return integration_detail::gauss_legendre(func, a, b, nodes, subintervals, threads);
+}
+
+/// @brief Adaptacyjna kwadratura Gaussa-Kronroda dla dowolnego obiektu wywoływalnego (zob. rectangle_rule).
+template <typename F>
+QuadratureResult adaptive_gauss_kronrod(F&& func, double a, double b,
+                                        double abs_tolerance = 1e-10, double rel_tolerance = 1e-10,
+                                        KronrodRule rule = KronrodRule::GK21, int max_subintervals = 1000) {
+    return integration_detail::adaptive_gauss_kronrod(func, a, b, abs_tolerance, rel_tolerance, rule, max_subintervals);
+}
+
+/// @brief Kwadratura Gaussa-Laguerre'a dla dowolnego obiektu wywoływalnego (zob. rectangle_rule).
+template <typename F>
+double gauss_laguerre_quadrature(F&& func, int nodes, double a = 0.0, double scale = 1.0) {
+    return integration_detail::gauss_laguerre(func, nodes, a, scale);
+}
+
+/// @brief Kwadratura Gaussa-Hermite'a dla dowolnego obiektu wywoływalnego (zob. rectangle_rule).
+template <typename F>
+double gauss_hermite_quadrature(F&& func, int nodes, double center = 0.0, double scale = 1.0) {
+    return integration_detail::gauss_hermite(func, nodes, center, scale);
+}
+
+/// @brief Kwadratura tanh-sinh dla dowolnego obiektu wywoływalnego (zob. rectangle_rule).
+template <typename F>
+QuadratureResult tanh_sinh_quadrature(F&& func, double a, double b,
+                                      double abs_tolerance = 1e-10, double rel_tolerance = 1e-10) {
+    return integration_detail::tanh_sinh(func, a, b, abs_tolerance, rel_tolerance);
+}
+
+/// @brief Kwadratura tanh-sinh z odległością od końca dla dowolnego obiektu wywoływalnego double(double, double).
+template <typename F>
+QuadratureResult tanh_sinh_quadrature_complement(F&& func, double a, double b,
+                                                 double abs_tolerance = 1e-10, double rel_tolerance = 1e-10) {
+    return integration_detail::tanh_sinh_complement(func, a, b, abs_tolerance, rel_tolerance);
+}
+
+/**
+ * @brief Metoda trapezów dla wielu funkcji naraz, z dowolnym obiektem wywoływalnym void(double x, double* fx).
+ */
+template <typename F>
+std::vector<double> trapezoid_rule_multi(F&& func, int count, double a, double b, int intervals) {
+    return integration_detail::trapezoid_multi(func, count, a, b, intervals);
+}
+
+/// @brief Metoda Simpsona dla wielu funkcji naraz (zob. trapezoid_rule_multi).
+template <typename F>
+std::vector<double> simpson_rule_multi(F&& func, int count, double a, double b, int intervals) {
+    return integration_detail::simpson_multi(func, count, a, b, intervals);
+}
+
+/// @brief Kwadratura Gaussa-Legendre'a dla wielu funkcji naraz (zob. trapezoid_rule_multi).
+template <typename F>
+std::vector<double> gauss_legendre_quadrature_multi(F&& func, int count, double a, double b, int nodes, int subintervals) {
+    return integration_detail::gauss_legendre_multi(func, count, a, b, nodes, subintervals);
+}
+
+/// @brief Metoda Romberga dla dowolnego obiektu wywoływalnego (zob. rectangle_rule).
+template <typename F>
+QuadratureResult romberg_integration(F&& func, double a, double b,
+                                     double abs_tolerance = 1e-10, double rel_tolerance = 1e-10, int max_levels = 20) {
+    return integration_detail::romberg(func, a, b, abs_tolerance, rel_tolerance, max_levels);
+}
+
 #endif // INTEGRATION_H
\ No newline at end of file
@@ -0,0 +1,120 @@
+#ifndef ITERATIVE_SOLVERS_H
+#define ITERATIVE_SOLVERS_H
+
+#include <vector>
+#include "linear_algebra.h"
+#include "sparse_matrix.h"
+
+/**
+ * @file iterative_solvers.h
+ * @brief Iteracyjne metody Kryłowa (CG, BiCGSTAB, GMRES) z wymiennymi preconditionerami.
+ */
+
+// Struktura przechowująca dane z jednej iteracji metody Kryłowa
+struct KrylovIteration {
+    int iteration_count;
+    double residual_norm;     ///< ||b - A x_k||_2 (w GMRES oszacowanie z rotacji Givensa)
+    double relative_residual; ///< residual_norm / ||b||_2
+};
+
+/**
+ * @brief Interfejs preconditionera M ~ A: apply() oblicza z = M^{-1} r.
+ */
+class Preconditioner {
+public:
+    virtual ~Preconditioner() = default;
+    virtual void apply(const double* r, double* z) const = 0;
+};
+
+/**
+ * @brief Preconditioner diagonalny (Jacobiego): M = diag(A).
+ */
+class JacobiPreconditioner : public Preconditioner {
+public:
+    /// @throws std::invalid_argument jeśli któryś element przekątnej jest zerowy.
+    explicit JacobiPreconditioner(const Vector& diagonal);
+    explicit JacobiPreconditioner(const SparseMatrix& A);
+    explicit JacobiPreconditioner(const DenseMatrix& A);
+    /// @throws std::invalid_argument jeśli operator nie ma przekątnej lub któryś jej element jest zerowy.
+    explicit JacobiPreconditioner(const LinearOperator& A);
+
+    void apply(const double* r, double* z) const override;
+
+private:
+    Vector inverse_diagonal_;
+};
+
+/**
+ * @brief Niepełny rozkład LU bez wypełnienia (ILU(0)): L i U mają strukturę macierzy A.
+ */
+class Ilu0Preconditioner : public Preconditioner {
+public:
+    /**
+     * @throws std::invalid_argument jeśli macierz nie jest kwadratowa lub brakuje elementu na przekątnej.
+     * @throws std::runtime_error jeśli w trakcie rozkładu pojawi się zerowy element główny.
+     */
+    explicit Ilu0Preconditioner(const SparseMatrix& A);
+
+    void apply(const double* r, double* z) const override;
+
+private:
+    SparseMatrix lu_;               // L (bez jedynek) pod przekątną, U na i nad przekątną
+    std::vector<int> diagonal_pos_; // pozycja elementu (i, i) w tablicach CSR
+};
+
+/**
+ * @brief Niepełny rozkład Cholesky'ego bez wypełnienia (IC(0)) dla macierzy symetrycznych dodatnio określonych.
+ *
+ * Wykorzystywana jest tylko dolna część macierzy A (wraz z przekątną).
+ */
+class IncompleteCholeskyPreconditioner : public Preconditioner {
+public:
+    /**
+     * @throws std::invalid_argument jeśli macierz nie jest kwadratowa.
+     * @throws std::runtime_error jeśli rozkład się załamie (niedodatni element przekątnej).
+     */
+    explicit IncompleteCholeskyPreconditioner(const SparseMatrix& A);
+
+    void apply(const double* r, double* z) const override;
+
+private:
+    SparseMatrix l_; // czynnik L w CSR, element przekątniowy ostatni w każdym wierszu
+};
+
+/**
+ * @brief Rozwiązuje Ax = b metodą gradientów sprzężonych (A symetryczna dodatnio określona).
+ * @param M Preconditioner (również symetryczny dodatnio określony) albo nullptr.
+ * @param tolerance Kryterium zbieżności dla ||b - Ax|| / ||b||.
+ * @param history Opcjonalny wskaźnik na wektor, do którego zapisywana jest historia iteracji.
+ * @return Przybliżenie rozwiązania x.
+ * @throws std::invalid_argument przy niezgodnych wymiarach lub niepoprawnych parametrach.
+ * @throws std::runtime_error jeśli metoda się załamie lub nie osiągnie zbieżności.
+ */
+Vector conjugate_gradient(
+    const LinearOperator& A, const Vector& b, const Preconditioner* M = nullptr,
+    double tolerance = 1e-10, int max_iterations = 1000,
+    std::vector<KrylovIteration>* history = nullptr);
+
+/**
+ * @brief Rozwiązuje Ax = b metodą BiCGSTAB (dowolna macierz nieosobliwa), z prawostronnym preconditionerem.
+ * @copydetails conjugate_gradient
+ */
+Vector bicgstab(
+    const LinearOperator& A, const Vector& b, const Preconditioner* M = nullptr,
+    double tolerance = 1e-10, int max_iterations = 1000,
+    std::vector<KrylovIteration>* history = nullptr);
+
+/**
+ * @brief Rozwiązuje Ax = b metodą GMRES z restartem co restart iteracji i prawostronnym preconditionerem.
+ *
+ * Baza Kryłowa ortogonalizowana jest zmodyfikowaną metodą Grama-Schmidta, a problem najmniejszych
+ * kwadratów rozwiązywany rotacjami Givensa; pamięć to O(n * restart).
+ * @param max_iterations Łączna liczba iteracji wewnętrznych we wszystkich cyklach.
+ * @copydetails conjugate_gradient
+ */
+Vector gmres(
+    const LinearOperator& A, const Vector& b, const Preconditioner* M = nullptr,
+    int restart = 30, double tolerance = 1e-10, int max_iterations = 1000,
+    std::vector<KrylovIteration>* history = nullptr);
+
+#endif // ITERATIVE_SOLVERS_H
\ No newline at end of file
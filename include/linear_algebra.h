@@ -3,6 +3,10 @@
 
 #include <vector>
 #include <string>
+#include <functional>
+#include <cstddef>
+#include <new>
+#include <initializer_list>
 
 // Definicje typw dla czytelnoci
 using Matrix = std::vector<std::vector<double>>;
@@ -13,14 +17,144 @@ using Vector = std::vector<double>;
  * @brief Deklaracje funkcji do rozwizywania ukadw rwna liniowych.
  */
 
+/**
+ * @brief Alokator zwracajcy pami wyrwnan do zadanej granicy (domylnie linia cache, 64 B).
+ */
+template <typename T, std::size_t Alignment = 64>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, std::size_t) noexcept {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+};
+
+template <typename T, typename U, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return true; }
+template <typename T, typename U, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return false; }
+
+/**
+ * @brief Widok na fragment macierzy w ukadzie wierszowym (row-major).
+ *
+ * Element (i, j) znajduje si pod adresem data[i * stride + j]. Widok nie zarzdza pamici.
+ */
+struct MatrixView {
+    double* data = nullptr;
+    int rows = 0;
+    int cols = 0;
+    int stride = 0;
+
+    double& operator()(int i, int j) const { return data[static_cast<std::size_t>(i) * stride + j]; }
+    double* row(int i) const { return data + static_cast<std::size_t>(i) * stride; }
+    MatrixView block(int r, int c, int nr, int nc) const { return { row(r) + c, nr, nc, stride }; }
+};
+
+/**
+ * @brief Widok tylko do odczytu na fragment macierzy w ukadzie wierszowym.
+ */
+struct ConstMatrixView {
+    const double* data = nullptr;
+    int rows = 0;
+    int cols = 0;
+    int stride = 0;
+
+    ConstMatrixView() = default;
+    ConstMatrixView(const double* data, int rows, int cols, int stride)
+        : data(data), rows(rows), cols(cols), stride(stride) {}
+    ConstMatrixView(const MatrixView& v) : data(v.data), rows(v.rows), cols(v.cols), stride(v.stride) {}
+
+    const double& operator()(int i, int j) const { return data[static_cast<std::size_t>(i) * stride + j]; }
+    const double* row(int i) const { return data + static_cast<std::size_t>(i) * stride; }
+    ConstMatrixView block(int r, int c, int nr, int nc) const { return { row(r) + c, nr, nc, stride }; }
+};
+
+/**
+ * @brief Gsta macierz przechowywana w jednym, cigym i wyrwnanym bloku pamici.
+ *
+ * Wiersze le jeden za drugim (row-major); dugo wiersza w pamici (stride) jest zaokrglana
+ * w gr do wielokrotnoci linii cache, dziki czemu kady wiersz zaczyna si na wyrwnanym adresie.
+ * Klasa zastpuje Matrix (wektor wektorw) w solverach; konwersje w obie strony zapewniaj
+ * konstruktor DenseMatrix(const Matrix&) oraz metoda to_matrix().
+ */
+class DenseMatrix {
+public:
+    DenseMatrix() = default;
+    DenseMatrix(int rows, int cols, double value = 0.0);
+    DenseMatrix(std::initializer_list<std::initializer_list<double>> values);
+
+    /**
+     * @brief Adapter dla starego typu Matrix. Kopiuje dane do cigego bufora.
+     * @throws std::invalid_argument jeli wiersze maj rne dugoci.
+     */
+    explicit DenseMatrix(const Matrix& m);
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int stride() const { return stride_; }
+
+    double* data() { return data_.data(); }
+    const double* data() const { return data_.data(); }
+
+    double& operator()(int i, int j) { return data_[static_cast<std::size_t>(i) * stride_ + j]; }
+    const double& operator()(int i, int j) const { return data_[static_cast<std::size_t>(i) * stride_ + j]; }
+
+    double* row(int i) { return data_.data() + static_cast<std::size_t>(i) * stride_; }
+    const double* row(int i) const { return data_.data() + static_cast<std::size_t>(i) * stride_; }
+
+    MatrixView view() { return { data_.data(), rows_, cols_, stride_ }; }
+    ConstMatrixView view() const { return { data_.data(), rows_, cols_, stride_ }; }
+    MatrixView block(int r, int c, int nr, int nc) { return view().block(r, c, nr, nc); }
+    ConstMatrixView block(int r, int c, int nr, int nc) const { return view().block(r, c, nr, nc); }
+
+    /// Zamienia miejscami zawarto dwch wierszy.
+    void swap_rows(int i, int j);
+
+    /// Konwersja z powrotem do typu Matrix (wektor wektorw).
+    Matrix to_matrix() const;
+
+private:
+    int rows_ = 0;
+    int cols_ = 0;
+    int stride_ = 0;
+    std::vector<double, AlignedAllocator<double>> data_;
+};
+
+/**
+ * @brief Diagnostyka rozwizania ukadu Ax = b, liczona bez ponownego rozkadu macierzy.
+ */
+struct SolveDiagnostics {
+    double condition_estimate = 0.0; ///< Oszacowanie cond_1(A) = ||A||_1 ||A^{-1}||_1 (metoda Hagera-Highama).
+    double residual_norm = 0.0;      ///< ||b - Ax||_inf dla zwrconego rozwizania.
+    double backward_error = 0.0;     ///< residual_norm / (||A||_inf ||x||_inf + ||b||_inf).
+};
+
  /**
   * @brief Rozwizuje ukad rwna liniowych Ax = b metod eliminacji Gaussa z penym pivotowaniem.
-  * @param A Macierz wspczynnikw (bdzie modyfikowana).
-  * @param b Wektor wyrazw wolnych (bdzie modyfikowany).
+  * @param A Macierz wspczynnikw.
+  * @param b Wektor wyrazw wolnych.
   * @return Wektor rozwizania x.
   * @throws std::runtime_error jeli macierz jest osobliwa.
   */
-Vector solve_gauss(Matrix A, Vector b);
+Vector solve_gauss(const Matrix& A, const Vector& b);
+
+/**
+ * @brief Wariant solve_gauss operujcy bezporednio na cigej macierzy DenseMatrix.
+ * @param threads Liczba wtkw eliminacji (1 = sekwencyjnie, 0 = wszystkie rdzenie).
+ * @param diagnostics Opcjonalny wskanik na struktur, do ktrej zapisywane s oszacowanie
+ *        uwarunkowania i residuum (koszt O(n^2) oraz kopia macierzy A na potrzeby residuum).
+ */
+Vector solve_gauss(DenseMatrix A, Vector b, int threads = 1, SolveDiagnostics* diagnostics = nullptr);
 
 /**
  * @brief Rozwizuje ukad rwna liniowych Ax = b przy uyciu dekompozycji LU.
@@ -33,6 +167,527 @@ Vector solve_gauss(Matrix A, Vector b);
  * @return Wektor rozwizania x.
  * @throws std::runtime_error jeli macierz jest osobliwa.
  */
-Vector solve_lu(Matrix A, Vector b);
+Vector solve_lu(const Matrix& A, const Vector& b);
+
+/**
+ * @brief Wariant solve_lu operujcy bezporednio na cigej macierzy DenseMatrix.
+ * @param threads Liczba wtkw dekompozycji (1 = sekwencyjnie, 0 = wszystkie rdzenie).
+ * @param diagnostics Jak w solve_gauss.
+ */
+Vector solve_lu(DenseMatrix A, Vector b, int threads = 1, SolveDiagnostics* diagnostics = nullptr);
+
+/**
+ * @brief Bufory robocze wariantw solverw dziaajcych w miejscu (permutacja i wektor pomocniczy).
+ *
+ * Bufory rosn tylko wtedy, gdy kolejny ukad jest wikszy ni capacity(); dla ukadw nie
+ * wikszych ni wczeniej obsuone solve_in_place i LuFactorization::solve_in_place nie
+ * wykonuj adnych alokacji na stercie, wic jeden obiekt mona uywa w ptli wielokrotnie.
+ */
+class SolveWorkspace {
+public:
+    SolveWorkspace() = default;
+    explicit SolveWorkspace(int n) { reserve(n); }
+
+    /// Przygotowuje bufory dla ukadw o rozmiarze do n wcznie.
+    void reserve(int n);
+    int capacity() const { return static_cast<int>(pivots_.size()); }
+
+    int* pivots() { return pivots_.data(); }
+    double* scratch() { return scratch_.data(); }
+
+private:
+    std::vector<int> pivots_;
+    Vector scratch_;
+};
+
+/**
+ * @brief Rozwizuje Ax = b w miejscu, na pamici nalecej do wywoujcego.
+ *
+ * Macierz A jest nadpisywana zwartym rozkadem LU (jak w LuFactorization::packed_lu()),
+ * a b rozwizaniem x; permutacja trafia do workspace.pivots(). Obliczenia s sekwencyjne.
+ * Poza pierwszym wywoaniem w danym wtku (przygotowanie buforw jdra mnoenia macierzy)
+ * i ewentualnym powikszeniem workspace funkcja nie alokuje pamici.
+ * @param A Widok kwadratowej macierzy n x n (dowolny stride).
+ * @param b Wskanik na n elementw wektora wyrazw wolnych.
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ * @throws std::runtime_error jeli macierz jest osobliwa.
+ */
+void solve_in_place(MatrixView A, double* b, SolveWorkspace& workspace);
+void solve_in_place(DenseMatrix& A, Vector& b, SolveWorkspace& workspace);
+
+/**
+ * @brief Dekompozycja LU z czciowym pivotowaniem (PA = LU) wielokrotnego uytku.
+ *
+ * Konstruktor wykonuje rozkad raz, kosztem O(n^3), i przechowuje go w zwartej postaci:
+ * czynniki L (bez jedynek z przektnej) pod przektn, a U na przektnej i nad ni,
+ * wraz z wektorem permutacji wierszy. Kade kolejne rozwizanie kosztuje O(n^2).
+ */
+class LuFactorization {
+public:
+    /**
+     * @param A Kwadratowa macierz wspczynnikw (przejmowana i nadpisywana rozkadem).
+     * @param threads Liczba wtkw (1 = sekwencyjnie, 0 = wszystkie rdzenie). Przy wielu wtkach
+     *        aktualizacje pozostaej czci macierzy dzielone s na kafelki wykonywane rwnolegle,
+     *        a rozkad kolejnego panelu zaczyna si przed zakoczeniem biecego kroku.
+     * @throws std::invalid_argument jeli macierz nie jest kwadratowa.
+     * @throws std::runtime_error jeli macierz jest osobliwa.
+     */
+    explicit LuFactorization(DenseMatrix A, int threads = 1);
+    explicit LuFactorization(const Matrix& A, int threads = 1);
+
+    /// Rozmiar ukadu n.
+    int size() const { return lu_.rows(); }
+
+    /// Rozwizuje Ax = b dla jednej prawej strony.
+    Vector solve(const Vector& b) const;
+
+    /// Rozwizuje AX = B dla bloku prawych stron (kada kolumna B to osobny wektor).
+    DenseMatrix solve(const DenseMatrix& B) const;
+
+    /// Rozwizuje A^T x = b przy uyciu tego samego rozkadu.
+    Vector solve_transposed(const Vector& b) const;
+
+    /**
+     * @brief Oszacowanie wspczynnika uwarunkowania cond_1(A) = ||A||_1 ||A^{-1}||_1.
+     *
+     * ||A^{-1}||_1 szacowane jest metod Hagera-Highama (jak LAPACK dlacn2) na podstawie istniejcego
+     * rozkadu: kilka rozwiza z A i A^T, czyli O(n^2) operacji. Oszacowanie jest z dou, ale
+     * w praktyce zwykle w granicach czynnika 3 od wartoci dokadnej.
+     */
+    double condition_estimate() const;
+
+    /// Norma ||A||_1 macierzy, dla ktrej wykonano rozkad.
+    double norm1() const { return norm1_; }
+
+    /**
+     * @brief Rozwizuje Ax = b w miejscu (b nadpisywany rozwizaniem) bez alokacji pamici.
+     * @throws std::invalid_argument jeli b ma inny rozmiar ni ukad.
+     */
+    void solve_in_place(Vector& b, SolveWorkspace& workspace) const;
+    void solve_in_place(double* b, SolveWorkspace& workspace) const;
+
+    /**
+     * @brief Wykonuje rozkad nowej macierzy tego samego rozmiaru, wykorzystujc istniejce bufory.
+     *
+     * Przy threads = 1 nie alokuje pamici, co pozwala np. w metodzie Newtona rozkada kolejne
+     * jakobiany w tym samym obiekcie. Jeli macierz okae si osobliwa, poprzedni rozkad jest tracony.
+     * @throws std::invalid_argument jeli rozmiar A rni si od size().
+     * @throws std::runtime_error jeli macierz jest osobliwa.
+     */
+    void refactor(ConstMatrixView A, int threads = 1);
+
+    /// Zwarta posta rozkadu (L pod przektn, U na i nad przektn).
+    const DenseMatrix& packed_lu() const { return lu_; }
+
+    /// permutation()[i] to indeks wiersza macierzy A, ktry trafi na pozycj i.
+    const std::vector<int>& permutation() const { return perm_; }
+
+private:
+    DenseMatrix lu_;
+    std::vector<int> perm_;
+    std::vector<double> column_sums_; // bufor roboczy normy ||A||_1, by refactor nie alokowa pamici
+    double norm1_ = 0.0;
+};
+
+/**
+ * @brief Przebieg rozwizania w mieszanej precyzji (solve_mixed_precision).
+ */
+struct RefinementInfo {
+    int iterations = 0;                ///< Liczba wykonanych krokw poprawiania iteracyjnego.
+    double backward_error = 0.0;       ///< ||b - Ax||_inf / (||A||_inf ||x||_inf + ||b||_inf) dla zwrconego x.
+    bool used_double_fallback = false; ///< true, jeli zamiast rozkadu float uyto penego rozkadu double.
+};
+
+/**
+ * @brief Rozwizuje Ax = b rozkadem LU w pojedynczej precyzji z iteracyjnym poprawianiem w double.
+ *
+ * Rozkad PA = LU liczony jest na kopii A w typie float (dwa razy wicej wartoci w rejestrze SIMD
+ * i o poow mniej danych do przesania z pamici). Rozwizanie jest nastpnie poprawiane:
+ * residuum r = b - Ax liczone jest w double wzgldem oryginalnej macierzy, a poprawka d z rozkadu
+ * float. Dla macierzy dobrze uwarunkowanych (cond(A) wyranie mniejsze od 1e7) wynik ma dokadno
+ * penej precyzji double. Jeli poprawianie przestaje zbiega (residuum nie maleje co najmniej
+ * dwukrotnie w kroku), macierz w float jest osobliwa albo jej elementy nie mieszcz si w zakresie
+ * float, funkcja sama wykonuje peny rozkad w double.
+ * @param info Opcjonalny wskanik na struktur z przebiegiem oblicze i osignitym bdem wstecznym.
+ * @param max_iterations Limit krokw poprawiania przed przejciem do rozkadu double.
+ * @param threads Liczba wtkw rozkadu (1 = sekwencyjnie, 0 = wszystkie rdzenie).
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ * @throws std::runtime_error jeli macierz jest osobliwa rwnie w precyzji double.
+ */
+Vector solve_mixed_precision(const DenseMatrix& A, const Vector& b, RefinementInfo* info = nullptr,
+                             int max_iterations = 30, int threads = 1);
+
+/**
+ * @brief Zestaw wielu niezalenych ukadw n x n tego samego rozmiaru w ukadzie SoA.
+ *
+ * Dane przechowywane s jako struktura tablic: element (i, j) ukadu s ley pod indeksem
+ * (i * n + j) * count + s, a wyraz wolny i pod indeksem i * count + s. Te same elementy
+ * kolejnych ukadw ssiaduj wic w pamici, co pozwala wektoryzowa obliczenia wzdu zestawu.
+ */
+class SystemBatch {
+public:
+    SystemBatch(int n, int count);
+
+    /// Rozmiar pojedynczego ukadu n.
+    int size() const { return n_; }
+    /// Liczba ukadw w zestawie.
+    int count() const { return count_; }
+
+    double& a(int system, int i, int j) { return a_[static_cast<std::size_t>(i * n_ + j) * count_ + system]; }
+    double a(int system, int i, int j) const { return a_[static_cast<std::size_t>(i * n_ + j) * count_ + system]; }
+    double& b(int system, int i) { return b_[static_cast<std::size_t>(i) * count_ + system]; }
+    double b(int system, int i) const { return b_[static_cast<std::size_t>(i) * count_ + system]; }
+
+    double* matrix_data() { return a_.data(); }
+    double* rhs_data() { return b_.data(); }
+
+private:
+    int n_;
+    int count_;
+    std::vector<double, AlignedAllocator<double>> a_;
+    std::vector<double, AlignedAllocator<double>> b_;
+};
+
+/**
+ * @brief Rozwizuje jednym wywoaniem wszystkie ukady zestawu metod eliminacji Gaussa z pivotowaniem.
+ *
+ * Obliczenia odbywaj si w miejscu: macierze s niszczone, a wyrazy wolne zastpowane
+ * rozwizaniami (batch.b(s, i) to i-ta wsprzdna rozwizania ukadu s). Nie s wykonywane
+ * adne alokacje. Dla n <= 8 uywane s wersje z rozmiarem znanym w czasie kompilacji.
+ *
+ * @throws std::runtime_error jeli ktry z ukadw jest osobliwy (komunikat zawiera jego numer).
+ */
+void solve_batched(SystemBatch& batch);
+
+/**
+ * @brief Wariant solve_batched dla buforw SoA nalecych do wywoujcego.
+ * @param n Rozmiar pojedynczego ukadu.
+ * @param count Liczba ukadw.
+ * @param a Bufor n * n * count wspczynnikw (element (i, j) ukadu s pod (i * n + j) * count + s).
+ * @param b Bufor n * count wyrazw wolnych (wyraz i ukadu s pod i * count + s), nadpisywany rozwizaniami.
+ */
+void solve_batched(int n, int count, double* a, double* b);
+
+/**
+ * @brief Rozwizuje ukad trjdiagonalny algorytmem Thomasa w czasie O(n) i pamici O(n).
+ *
+ * Eliminacja odbywa si bez pivotowania, wic jest stabilna dla macierzy diagonalnie dominujcych
+ * lub symetrycznych dodatnio okrelonych (typowych dla splajnw i niejawnych krokw dyfuzji).
+ *
+ * @param lower Poddiagonala, lower[i] = a(i+1, i), n-1 elementw.
+ * @param diagonal Przektna, n elementw.
+ * @param upper Naddiagonala, upper[i] = a(i, i+1), n-1 elementw.
+ * @param b Wektor wyrazw wolnych.
+ * @return Wektor rozwizania x.
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ * @throws std::runtime_error jeli pojawi si zerowy element gwny.
+ */
+Vector solve_tridiagonal(const Vector& lower, const Vector& diagonal, const Vector& upper, Vector b);
+
+/**
+ * @brief Rozwizuje w miejscu count niezalenych ukadw trjdiagonalnych n x n (algorytm Thomasa).
+ *
+ * Dane w ukadzie SoA, jak w solve_batched: element i ukadu s ley pod indeksem i * count + s
+ * (dla lower i upper i = 0..n-2). Obliczenia s wektoryzowane wzdu numeru ukadu. Przektna jest
+ * nadpisywana elementami gwnymi eliminacji, a b rozwizaniami; nie s wykonywane adne alokacje.
+ *
+ * @throws std::runtime_error jeli ktry z ukadw jest osobliwy (komunikat zawiera jego numer).
+ */
+void solve_tridiagonal_batched(int n, int count, const double* lower, double* diagonal, const double* upper, double* b);
+
+/**
+ * @brief Macierz pasmowa n x n w zwartej postaci: kl poddiagonal, ku naddiagonal.
+ *
+ * Wiersz i przechowuje kolumny i-kl .. i+ku pod indeksem i * (kl + ku + 1) + (j - i + kl),
+ * wic pami to O(n * (kl + ku)). Elementy spoza pasma s zerami i nie mona ich zapisa.
+ */
+class BandMatrix {
+public:
+    BandMatrix(int n, int lower_bandwidth, int upper_bandwidth);
+
+    int size() const { return n_; }
+    int lower_bandwidth() const { return kl_; }
+    int upper_bandwidth() const { return ku_; }
+
+    /// @throws std::out_of_range jeli (i, j) ley poza pasmem.
+    double& operator()(int i, int j);
+    /// Zwraca 0 dla elementw spoza pasma.
+    double operator()(int i, int j) const;
+
+    /// Konwersja do macierzy gstej (tylko dla maych macierzy).
+    DenseMatrix to_dense() const;
+
+private:
+    int n_;
+    int kl_;
+    int ku_;
+    std::vector<double> data_;
+};
+
+/**
+ * @brief Dekompozycja LU macierzy pasmowej z czciowym pivotowaniem (jak LAPACK dgbtrf).
+ *
+ * Przestawienia wierszy poszerzaj pasmo U do ku + kl naddiagonal, dlatego rozkad przechowuje
+ * 2 kl + ku + 1 elementw na wiersz. Koszt rozkadu to O(n * kl * (kl + ku)), a rozwizania O(n * (kl + ku)).
+ */
+class BandLuFactorization {
+public:
+    /// @throws std::runtime_error jeli macierz jest osobliwa.
+    explicit BandLuFactorization(const BandMatrix& A);
+
+    int size() const { return n_; }
+
+    /// Rozwizuje Ax = b.
+    Vector solve(const Vector& b) const;
+
+private:
+    double& at(int i, int j) { return lu_[static_cast<std::size_t>(i) * width_ + (j - i + kl_)]; }
+    double at(int i, int j) const { return lu_[static_cast<std::size_t>(i) * width_ + (j - i + kl_)]; }
+
+    int n_;
+    int kl_;
+    int ku_;
+    int width_;             // 2 kl + ku + 1
+    std::vector<double> lu_;
+    std::vector<int> pivots_; // w kroku k zamieniono wiersze k i pivots_[k]
+};
+
+/**
+ * @brief Rozwizuje ukad pasmowy Ax = b (BandLuFactorization) w czasie O(n * kl * (kl + ku)).
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ * @throws std::runtime_error jeli macierz jest osobliwa.
+ */
+Vector solve_banded(const BandMatrix& A, const Vector& b);
+
+/**
+ * @brief Macierz symetryczna n x n przechowywana w postaci spakowanej: tylko dolny trjkt, kolumnami.
+ *
+ * Kolumna j (wiersze j..n-1) zajmuje kolejne n - j pozycji, wic pami to n (n + 1) / 2 wartoci,
+ * o poow mniej ni DenseMatrix. Elementy (i, j) i (j, i) to ta sama komrka pamici.
+ */
+class SymmetricMatrix {
+public:
+    SymmetricMatrix() = default;
+    explicit SymmetricMatrix(int n, double value = 0.0);
+
+    /**
+     * @brief Kopiuje dolny trjkt macierzy gstej (grny jest ignorowany).
+     * @throws std::invalid_argument jeli macierz nie jest kwadratowa.
+     */
+    explicit SymmetricMatrix(const DenseMatrix& A);
+
+    int size() const { return n_; }
+
+    double& operator()(int i, int j) { return data_[offset(i, j)]; }
+    double operator()(int i, int j) const { return data_[offset(i, j)]; }
+
+    /// Wskanik na pocztek kolumny j dolnego trjkta (element (j, j), potem (j+1, j), ...).
+    double* column(int j) { return data_.data() + column_start(j); }
+    const double* column(int j) const { return data_.data() + column_start(j); }
+
+    /// Konwersja do penej macierzy gstej.
+    DenseMatrix to_dense() const;
+
+private:
+    std::size_t column_start(int j) const {
+        return static_cast<std::size_t>(j) * n_ - static_cast<std::size_t>(j) * (j - 1) / 2;
+    }
+    std::size_t offset(int i, int j) const {
+        return i >= j ? column_start(j) + (i - j) : column_start(i) + (j - i);
+    }
+
+    int n_ = 0;
+    std::vector<double, AlignedAllocator<double>> data_;
+};
+
+/**
+ * @brief Dekompozycja Cholesky'ego A = L L^T dla macierzy symetrycznych dodatnio okrelonych.
+ *
+ * Rozkad jest blokowy: panel kolumn rozkadany jest lewostronnie, a aktualizacja pozostaej czci
+ * macierzy wykonywana jdrem GEMM. Wymaga poowy operacji dekompozycji LU (n^3 / 3) i bez pivotowania,
+ * a czynnik L zajmuje miejsce spakowanego dolnego trjkta.
+ */
+class CholeskyFactorization {
+public:
+    /**
+     * @param A Macierz symetryczna (przejmowana i nadpisywana czynnikiem L).
+     * @throws std::runtime_error jeli macierz nie jest dodatnio okrelona.
+     */
+    explicit CholeskyFactorization(SymmetricMatrix A);
+    /// Wariant czytajcy dolny trjkt macierzy gstej.
+    explicit CholeskyFactorization(const DenseMatrix& A);
+
+    int size() const { return l_.size(); }
+
+    /// Rozwizuje Ax = b (podstawienie w przd z L i wstecz z L^T).
+    Vector solve(const Vector& b) const;
+
+    /// Czynnik L w dolnym trjkcie.
+    const SymmetricMatrix& factor() const { return l_; }
+
+private:
+    SymmetricMatrix l_;
+};
+
+/**
+ * @brief Dekompozycja P A P^T = L D L^T dla macierzy symetrycznych, rwnie nieokrelonych.
+ *
+ * Pivotowanie Buncha-Kaufmana (jak LAPACK dsptrf) wybiera bloki 1 x 1 lub 2 x 2 macierzy D,
+ * co zapewnia stabilno bez niszczenia symetrii. Rozkad dziaa w miejscu na spakowanym trjkcie.
+ */
+class LdltFactorization {
+public:
+    /**
+     * @throws std::runtime_error jeli macierz jest osobliwa.
+     */
+    explicit LdltFactorization(SymmetricMatrix A);
+
+    int size() const { return ld_.size(); }
+
+    /// Rozwizuje Ax = b.
+    Vector solve(const Vector& b) const;
+
+    /// Liczba ujemnych wartoci wasnych A (bezwadno D, twierdzenie Sylvestera).
+    int negative_eigenvalues() const { return negative_; }
+
+private:
+    SymmetricMatrix ld_;
+    std::vector<int> pivots_; // >= 0: blok 1 x 1 i wiersz zamieniony z k; < 0: blok 2 x 2 i wiersz -pivots_[k] - 1
+    int negative_ = 0;
+};
+
+/**
+ * @brief Rozwizuje ukad Ax = b z macierz symetryczn dodatnio okrelon (CholeskyFactorization).
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ * @throws std::runtime_error jeli macierz nie jest dodatnio okrelona.
+ */
+Vector solve_cholesky(SymmetricMatrix A, const Vector& b);
+
+/**
+ * @brief Rozwizuje ukad Ax = b z dowoln nieosobliw macierz symetryczn (LdltFactorization).
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ * @throws std::runtime_error jeli macierz jest osobliwa.
+ */
+Vector solve_ldlt(SymmetricMatrix A, const Vector& b);
+
+/**
+ * @brief Rozkad QR macierzy prostoktnej m x n (m >= n) odbiciami Householdera: AP = QR.
+ *
+ * Bez pivotowania rozkad jest blokowy: panel kolumn rozkadany jest odbiciami, ktre nastpnie
+ * stosowane s do reszty macierzy w postaci zwartej Q = I - V T V^T, czyli przez mnoenie macierzy.
+ * Z pivotowaniem kolumn (QRCP) w kadym kroku wybierana jest kolumna o najwikszej normie
+ * pozostaej czci, dziki czemu |R(k, k)| malej, a rank() wykrywa rzd macierzy.
+ * Q nie jest jawnie tworzona: wektory odbi s przechowywane pod przektn, a R na i nad ni.
+ */
+class QrFactorization {
+public:
+    /**
+     * @param A Macierz wspczynnikw (przejmowana i nadpisywana rozkadem).
+     * @param column_pivoting Czy wybiera kolumny wedug norm (rozkad ujawniajcy rzd).
+     * @throws std::invalid_argument jeli macierz jest pusta lub ma mniej wierszy ni kolumn.
+     */
+    explicit QrFactorization(DenseMatrix A, bool column_pivoting = false);
+
+    /// Liczba wierszy (wraz z dopisanymi przez append_rows).
+    int rows() const { return rows_; }
+    int cols() const { return qr_.cols(); }
+
+    /**
+     * @brief Rzd numeryczny: liczba elementw |R(k, k)| > tolerance * max_i |R(i, i)|.
+     * @param tolerance Prg wzgldny; warto ujemna oznacza max(m, n) * eps.
+     */
+    int rank(double tolerance = -1.0) const;
+
+    /**
+     * @brief Rozwizanie zadania najmniejszych kwadratw min ||Ax - b||_2.
+     *
+     * Dla macierzy penego rzdu rozwizanie jest jednoznaczne. Przy pivotowaniu i rzdzie r < n
+     * zwracane jest rozwizanie bazowe (n - r skadowych odpowiadajcych ostatnim kolumnom rwne zeru).
+     * @param residual_norm Opcjonalny wskanik na ||Ax - b||_2, wyznaczane bez mnoenia przez A.
+     * @throws std::invalid_argument jeli b ma inny rozmiar ni rows().
+     * @throws std::runtime_error jeli macierz bez pivotowania nie ma penego rzdu.
+     */
+    Vector solve(const Vector& b, double* residual_norm = nullptr) const;
+
+    /**
+     * @brief Aktualizuje rozkad po dopisaniu wierszy W (k x n) na dole macierzy A.
+     *
+     * Nowy rozkad [A; W] P = Q' R' powstaje z [R; W] kosztem O(k n^2), bez dostpu do A.
+     * Kolejne wywoania solve() oczekuj wektora b z rows() elementami (stare wiersze, potem nowe).
+     * Przy pivotowaniu kolejno kolumn pozostaje bez zmian, wic R' nie musi ju ujawnia rzdu.
+     * @throws std::invalid_argument jeli W ma inn liczb kolumn.
+     */
+    void append_rows(const DenseMatrix& W);
+
+    /// Czynnik R (n x n, grnotrjktny) dla kolumn w kolejnoci column_permutation().
+    DenseMatrix r() const;
+
+    /// column_permutation()[k] to indeks kolumny macierzy A, ktra trafia na pozycj k.
+    const std::vector<int>& column_permutation() const { return perm_; }
+
+private:
+    // Odbicia z jednej aktualizacji append_rows: wektor odbicia j to [e_j; rows(:, j)].
+    struct AppendedBlock {
+        DenseMatrix rows;
+        Vector tau;
+    };
+
+    DenseMatrix qr_;     // R na i nad przektn, wektory Householdera (bez jedynki) pod ni
+    Vector tau_;         // wspczynniki odbi H_j = I - tau_j v_j v_j^T
+    std::vector<int> perm_;
+    std::vector<AppendedBlock> appended_;
+    int rows_ = 0;
+    bool pivoted_ = false;
+};
+
+/**
+ * @brief Rozwizuje nadokrelony ukad Ax ~ b w sensie najmniejszych kwadratw (QrFactorization).
+ *
+ * W przeciwiestwie do rwna normalnych A^T A x = A^T b nie podnosi uwarunkowania do kwadratu
+ * i nie wymaga tworzenia macierzy n x n.
+ * @throws std::invalid_argument przy niezgodnych wymiarach lub m < n.
+ * @throws std::runtime_error jeli macierz bez pivotowania nie ma penego rzdu.
+ */
+Vector solve_least_squares(DenseMatrix A, const Vector& b, bool column_pivoting = false);
+
+class SparseMatrix;
+
+/**
+ * @brief Operator liniowy y = A x widziany przez solvery iteracyjne i metody wasne wycznie przez swoje dziaanie.
+ *
+ * Moe opakowywa macierz gst, macierz rzadk lub dowoln funkcj uytkownika (np. iloczyn
+ * Jacobianu z wektorem liczony przez symulacj), wic pami nie zaley od n^2. Opcjonalna
+ * przektna pozwala budowa preconditioner Jacobiego bez dostpu do elementw macierzy.
+ * Konstruktory przyjmujce macierze nie kopiuj ich: macierz musi istnie tak dugo jak operator.
+ */
+class LinearOperator {
+public:
+    /// Funkcja obliczajca y = A x; x i y maj po size() elementw i nie nachodz na siebie.
+    using ApplyFunction = std::function<void(const double* x, double* y)>;
+
+    /**
+     * @param diagonal Przektna operatora (n elementw) albo pusty wektor, jeli jest nieznana.
+     * @throws std::invalid_argument jeli n < 0, funkcja jest pusta lub przektna ma zy rozmiar.
+     */
+    LinearOperator(int n, ApplyFunction apply, Vector diagonal = Vector());
+    /// Przektna odczytywana jest z macierzy. @throws std::invalid_argument jeli macierz nie jest kwadratowa.
+    explicit LinearOperator(const DenseMatrix& A);
+    /// Przektna odczytywana jest z macierzy. @throws std::invalid_argument jeli macierz nie jest kwadratowa.
+    explicit LinearOperator(const SparseMatrix& A);
+
+    int size() const { return n_; }
+
+    void apply(const double* x, double* y) const { apply_(x, y); }
+    Vector apply(const Vector& x) const;
+
+    bool has_diagonal() const { return !diagonal_.empty(); }
+    /// Przektna operatora; pusta, jeli nie zostaa podana.
+    const Vector& diagonal() const { return diagonal_; }
+
+private:
+    int n_;
+    ApplyFunction apply_;
+    Vector diagonal_;
+};
 
 #endif // LINEAR_ALGEBRA_H
\ No newline at end of file
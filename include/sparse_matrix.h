@@ -0,0 +1,185 @@
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <vector>
+#include "linear_algebra.h" // dla Vector i DenseMatrix
+
+/**
+ * @file sparse_matrix.h
+ * @brief Macierze rzadkie (CSR/CSC) oraz rzadka dekompozycja LU.
+ */
+
+/**
+ * @brief Pojedynczy niezerowy element (wiersz, kolumna, wartość) używany do budowy macierzy rzadkiej.
+ */
+struct Triplet {
+    int row;
+    int col;
+    double value;
+};
+
+class CscMatrix;
+
+/**
+ * @brief Macierz rzadka w formacie CSR (Compressed Sparse Row).
+ *
+ * Elementy wiersza i zajmują pozycje row_pointers()[i] .. row_pointers()[i+1]-1 tablic
+ * col_indices() i values(); indeksy kolumn w obrębie wiersza są posortowane rosnąco.
+ */
+class SparseMatrix {
+public:
+    SparseMatrix() = default;
+
+    /**
+     * @brief Tworzy macierz z gotowych tablic CSR.
+     * @throws std::invalid_argument jeśli tablice są niespójne.
+     */
+    SparseMatrix(int rows, int cols, std::vector<int> row_ptr, std::vector<int> col_idx, std::vector<double> values);
+
+    /**
+     * @brief Buduje macierz z listy trójek (wiersz, kolumna, wartość).
+     *
+     * Trójki mogą występować w dowolnej kolejności; wartości powtarzających się pozycji są sumowane.
+     * @throws std::invalid_argument jeśli któryś indeks wykracza poza wymiary macierzy.
+     */
+    static SparseMatrix from_triplets(int rows, int cols, const std::vector<Triplet>& triplets);
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int non_zeros() const { return static_cast<int>(values_.size()); }
+
+    const std::vector<int>& row_pointers() const { return row_ptr_; }
+    const std::vector<int>& col_indices() const { return col_idx_; }
+    const std::vector<double>& values() const { return values_; }
+
+    /// Wartość elementu (i, j); zero, jeśli element nie jest zapisany.
+    double at(int i, int j) const;
+
+    /// Iloczyn y = A x.
+    Vector multiply(const Vector& x) const;
+    /// Iloczyn y = A x na buforach wywołującego (x ma cols() elementów, y rows()).
+    void multiply(const double* x, double* y) const;
+    /// Iloczyn y = A^T x.
+    Vector multiply_transpose(const Vector& x) const;
+
+    /// Macierz transponowana (również w formacie CSR).
+    SparseMatrix transpose() const;
+    /// Ta sama macierz w formacie CSC.
+    CscMatrix to_csc() const;
+    /// Konwersja do macierzy gęstej (tylko dla małych macierzy).
+    DenseMatrix to_dense() const;
+
+private:
+    int rows_ = 0;
+    int cols_ = 0;
+    std::vector<int> row_ptr_{ 0 };
+    std::vector<int> col_idx_;
+    std::vector<double> values_;
+};
+
+/**
+ * @brief Macierz rzadka w formacie CSC (Compressed Sparse Column).
+ *
+ * Elementy kolumny j zajmują pozycje col_pointers()[j] .. col_pointers()[j+1]-1 tablic
+ * row_indices() i values(); indeksy wierszy w obrębie kolumny są posortowane rosnąco.
+ */
+class CscMatrix {
+public:
+    CscMatrix() = default;
+    CscMatrix(int rows, int cols, std::vector<int> col_ptr, std::vector<int> row_idx, std::vector<double> values);
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int non_zeros() const { return static_cast<int>(values_.size()); }
+
+    const std::vector<int>& col_pointers() const { return col_ptr_; }
+    const std::vector<int>& row_indices() const { return row_idx_; }
+    const std::vector<double>& values() const { return values_; }
+
+    /// Iloczyn y = A x.
+    Vector multiply(const Vector& x) const;
+    /// Ta sama macierz w formacie CSR.
+    SparseMatrix to_csr() const;
+
+private:
+    int rows_ = 0;
+    int cols_ = 0;
+    std::vector<int> col_ptr_{ 0 };
+    std::vector<int> row_idx_;
+    std::vector<double> values_;
+};
+
+/**
+ * @brief Wyznacza porządek eliminacji ograniczający wypełnienie (approximate minimum degree).
+ *
+ * Działa na strukturze A + A^T (wartości są ignorowane). Eliminacja jest modelowana grafem
+ * ilorazowym: wyeliminowane zmienne stają się "elementami", a stopień zmiennej szacowany jest
+ * od góry jak w algorytmie AMD (Amestoy, Davis, Duff), bez jawnego tworzenia wypełnienia.
+ *
+ * @return Permutacja order, w której order[k] to indeks zmiennej eliminowanej jako k-ta.
+ * @throws std::invalid_argument jeśli macierz nie jest kwadratowa.
+ */
+std::vector<int> approximate_minimum_degree(const SparseMatrix& A);
+
+/// Porządek kolumn stosowany przed rzadką dekompozycją LU.
+enum class SparseOrdering {
+    Natural,                 ///< bez przestawień
+    ApproximateMinimumDegree ///< approximate_minimum_degree() na strukturze A + A^T
+};
+
+/**
+ * @brief Rzadka dekompozycja P A Q = L U wielokrotnego użytku.
+ *
+ * Kolumny są przestawiane zgodnie z porządkiem ograniczającym wypełnienie, a kolejne kolumny
+ * L i U wyznaczane metodą Gilberta-Peierlsa (rzadkie rozwiązanie trójkątne z przeszukiwaniem
+ * grafu w głąb). Element główny wybierany jest progowo: preferowany jest element "przekątniowy",
+ * o ile jego moduł stanowi co najmniej pivot_threshold największego modułu w kolumnie.
+ */
+class SparseLuFactorization {
+public:
+    /**
+     * @param A Kwadratowa macierz rzadka.
+     * @param ordering Porządek kolumn.
+     * @param pivot_threshold Próg z przedziału (0, 1]; 1 oznacza klasyczne częściowe pivotowanie.
+     * @throws std::invalid_argument jeśli macierz nie jest kwadratowa lub próg jest niepoprawny.
+     * @throws std::runtime_error jeśli macierz jest osobliwa.
+     */
+    explicit SparseLuFactorization(const SparseMatrix& A,
+                                   SparseOrdering ordering = SparseOrdering::ApproximateMinimumDegree,
+                                   double pivot_threshold = 0.1);
+
+    int size() const { return n_; }
+
+    /// Łączna liczba zapisanych elementów czynników L i U (miara wypełnienia).
+    int factor_non_zeros() const { return static_cast<int>(l_values_.size() + u_values_.size()); }
+
+    /// column_ordering()[k] to kolumna A ustawiona na pozycji k.
+    const std::vector<int>& column_ordering() const { return q_; }
+    /// row_ordering()[k] to wiersz A wybrany jako k-ty element główny.
+    const std::vector<int>& row_ordering() const { return p_; }
+
+    /// Rozwiązuje Ax = b kosztem proporcjonalnym do liczby elementów L i U.
+    Vector solve(const Vector& b) const;
+
+private:
+    int n_ = 0;
+    std::vector<int> p_;
+    std::vector<int> q_;
+    // L: kolumny z jedynką na przekątnej zapisaną jako pierwszy element, wiersze numerowane krokami pivotowania
+    std::vector<int> l_col_ptr_;
+    std::vector<int> l_row_idx_;
+    std::vector<double> l_values_;
+    // U: kolumny z elementem przekątniowym zapisanym jako ostatni element
+    std::vector<int> u_col_ptr_;
+    std::vector<int> u_row_idx_;
+    std::vector<double> u_values_;
+};
+
+/**
+ * @brief Rozwiązuje rzadki układ Ax = b (rzadka dekompozycja LU z porządkiem AMD).
+ * @throws std::invalid_argument przy niezgodnych wymiarach.
+ * @throws std::runtime_error jeśli macierz jest osobliwa.
+ */
+Vector solve_lu(const SparseMatrix& A, const Vector& b);
+
+#endif // SPARSE_MATRIX_H
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "approximation.h"
 #include "integration.h" // Using our own integration module!
+#include "linear_algebra.h"
 #include <stdexcept>
 #include <cmath>
 
@@ -9,57 +10,46 @@ std::vector<double> polynomial_approximation(std::function<double(double)> func,
     }
 
     int n = degree + 1;
-    std::vector<std::vector<double>> A(n, std::vector<double>(n));
+    SymmetricMatrix A(n);
     std::vector<double> B(n);
 
     // Build the matrix A (Gram matrix) and vector B
-    // Integrals are computed using Simpson's rule from our library
-    for (int i = 0; i < n; ++i) {
-        for (int j = 0; j < n; ++j) {
-            auto integrand = [i, j](double x) { return std::pow(x, i + j); };
-            A[i][j] = simpson_rule(integrand, a, b, 1000);
+    // A(i, j) = integral of x^(i + j) depends only on i + j, so 2n - 1 moments suffice.
+    // All moments and right-hand-side integrals are computed by Simpson's rule in a single sweep:
+    // func is called once per node and the powers of x come from a running product
+    const int moments = 2 * n - 1;
+    auto integrands = [&func, n, moments](double x, double* fx) {
+        const double fx_value = func(x);
+        double power = 1.0;
+        for (int k = 0; k < moments; ++k) {
+            fx[k] = power;
+            if (k < n) fx[moments + k] = fx_value * power;
+            power *= x;
         }
-        auto integrand_b = [func, i](double x) { return func(x) * std::pow(x, i); };
-        B[i] = simpson_rule(integrand_b, a, b, 1000);
-    }
+    };
+    std::vector<double> integrals = simpson_rule_multi(integrands, moments + n, a, b, 1000);
 
-    // Solve the linear system Ax = B using Gaussian elimination
-    // This part should ideally be in a separate linear_algebra module
+    // The Gram matrix is symmetric, so only its lower triangle is stored
     for (int i = 0; i < n; ++i) {
-        // Find pivot
-        int pivot = i;
-        for (int j = i + 1; j < n; ++j) {
-            if (std::abs(A[j][i]) > std::abs(A[pivot][i])) {
-                pivot = j;
-            }
-        }
-        std::swap(A[i], A[pivot]);
-        std::swap(B[i], B[pivot]);
-
-        // Check for singularity
-        if (std::abs(A[i][i]) < 1e-12) {
-            throw std::runtime_error("Matrix is singular or nearly singular; cannot solve the system.");
-        }
-
-        // Normalize row
-        for (int k = i + 1; k < n; ++k) {
-            double factor = A[k][i] / A[i][i];
-            B[k] -= factor * B[i];
-            for (int j = i; j < n; ++j) {
-                A[k][j] -= factor * A[i][j];
-            }
+        for (int j = 0; j <= i; ++j) {
+            A(i, j) = integrals[i + j];
         }
+        B[i] = integrals[moments + i];
     }
 
-    // Back substitution
-    std::vector<double> coeffs(n);
-    for (int i = n - 1; i >= 0; --i) {
-        double sum = 0.0;
-        for (int j = i + 1; j < n; ++j) {
-            sum += A[i][j] * coeffs[j];
-        }
-        coeffs[i] = (B[i] - sum) / A[i][i];
+    // The Gram matrix of linearly independent monomials is positive definite,
+    // so the system is solved with the Cholesky decomposition. For higher degrees the monomial
+    // basis is so ill-conditioned that rounding can make a Cholesky pivot non-positive;
+    // such systems are still solved by Gaussian elimination with partial pivoting
+    try {
+        return CholeskyFactorization(A).solve(B);
+    }
+    catch (const std::runtime_error&) {
+    }
+    try {
+        return solve_gauss(A.to_dense(), B);
+    }
+    catch (const std::runtime_error&) {
+        throw std::runtime_error("Matrix is singular or nearly singular; cannot solve the system.");
     }
-
-    return coeffs;
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "linear_algebra.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <string>
+
+namespace {
+    // Próg, poniżej którego element główny uznajemy za zerowy (jak w solverach gęstych)
+    constexpr double PIVOT_TOLERANCE = 1e-12;
+} // anonymous namespace
+
+// --- Algorytm Thomasa ---
+
+Vector solve_tridiagonal(const Vector& lower, const Vector& diagonal, const Vector& upper, Vector b) {
+    const int n = static_cast<int>(diagonal.size());
+    if (n == 0 || static_cast<int>(lower.size()) != n - 1 || static_cast<int>(upper.size()) != n - 1 ||
+        static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+
+    // Eliminacja w przód: pivot[i] to element główny wiersza i, b nadpisywany w miejscu
+    Vector pivot(n);
+    pivot[0] = diagonal[0];
+    for (int i = 1; i < n; ++i) {
+        if (std::abs(pivot[i - 1]) < PIVOT_TOLERANCE) {
+            throw std::runtime_error("Matrix is singular or nearly singular.");
+        }
+        const double factor = lower[i - 1] / pivot[i - 1];
+        pivot[i] = diagonal[i] - factor * upper[i - 1];
+        b[i] -= factor * b[i - 1];
+    }
+    if (std::abs(pivot[n - 1]) < PIVOT_TOLERANCE) {
+        throw std::runtime_error("Matrix is singular or nearly singular.");
+    }
+
+    // Podstawienie wstecz
+    b[n - 1] /= pivot[n - 1];
+    for (int i = n - 2; i >= 0; --i) {
+        b[i] = (b[i] - upper[i] * b[i + 1]) / pivot[i];
+    }
+    return b;
+}
+
+void solve_tridiagonal_batched(int n, int count, const double* lower, double* diagonal, const double* upper, double* b) {
+    if (n <= 0 || count < 0 || (count > 0 && (diagonal == nullptr || b == nullptr ||
+                                             (n > 1 && (lower == nullptr || upper == nullptr))))) {
+        throw std::invalid_argument("Invalid batch dimensions.");
+    }
+    const std::size_t stride = static_cast<std::size_t>(count);
+
+    // Eliminacja w przód; pętla wewnętrzna biegnie wzdłuż układów i jest wektoryzowana
+    for (int i = 1; i < n; ++i) {
+        const double* l = lower + (i - 1) * stride;
+        const double* u = upper + (i - 1) * stride;
+        const double* d_prev = diagonal + (i - 1) * stride;
+        const double* b_prev = b + (i - 1) * stride;
+        double* d = diagonal + i * stride;
+        double* bi = b + i * stride;
+        for (int s = 0; s < count; ++s) {
+            const double factor = l[s] / d_prev[s];
+            d[s] -= factor * u[s];
+            bi[s] -= factor * b_prev[s];
+        }
+    }
+
+    // Zerowy element główny daje inf/NaN zamiast przerwania pętli, więc sprawdzamy go osobno
+    for (int s = 0; s < count; ++s) {
+        for (int i = 0; i < n; ++i) {
+            if (!(std::abs(diagonal[i * stride + s]) >= PIVOT_TOLERANCE) || !std::isfinite(diagonal[i * stride + s])) {
+                throw std::runtime_error("Matrix is singular or nearly singular (system " + std::to_string(s) + " in batch).");
+            }
+        }
+    }
+
+    // Podstawienie wstecz
+    double* b_last = b + (n - 1) * stride;
+    const double* d_last = diagonal + (n - 1) * stride;
+    for (int s = 0; s < count; ++s) {
+        b_last[s] /= d_last[s];
+    }
+    for (int i = n - 2; i >= 0; --i) {
+        const double* u = upper + i * stride;
+        const double* d = diagonal + i * stride;
+        const double* b_next = b + (i + 1) * stride;
+        double* bi = b + i * stride;
+        for (int s = 0; s < count; ++s) {
+            bi[s] = (bi[s] - u[s] * b_next[s]) / d[s];
+        }
+    }
+}
+
+// --- Macierz pasmowa ---
+
+BandMatrix::BandMatrix(int n, int lower_bandwidth, int upper_bandwidth)
+    : n_(n), kl_(lower_bandwidth), ku_(upper_bandwidth) {
+    if (n <= 0 || lower_bandwidth < 0 || upper_bandwidth < 0) {
+        throw std::invalid_argument("Invalid band matrix dimensions.");
+    }
+    data_.assign(static_cast<std::size_t>(n) * (kl_ + ku_ + 1), 0.0);
+}
+
+double& BandMatrix::operator()(int i, int j) {
+    if (i < 0 || i >= n_ || j < 0 || j >= n_ || j < i - kl_ || j > i + ku_) {
+        throw std::out_of_range("Band matrix index outside the band.");
+    }
+    return data_[static_cast<std::size_t>(i) * (kl_ + ku_ + 1) + (j - i + kl_)];
+}
+
+double BandMatrix::operator()(int i, int j) const {
+    if (i < 0 || i >= n_ || j < 0 || j >= n_ || j < i - kl_ || j > i + ku_) {
+        return 0.0;
+    }
+    return data_[static_cast<std::size_t>(i) * (kl_ + ku_ + 1) + (j - i + kl_)];
+}
+
+DenseMatrix BandMatrix::to_dense() const {
+    DenseMatrix D(n_, n_);
+    for (int i = 0; i < n_; ++i) {
+        for (int j = std::max(0, i - kl_); j <= std::min(n_ - 1, i + ku_); ++j) {
+            D(i, j) = (*this)(i, j);
+        }
+    }
+    return D;
+}
+
+// --- Dekompozycja LU macierzy pasmowej ---
+
+BandLuFactorization::BandLuFactorization(const BandMatrix& A)
+    : n_(A.size()), kl_(A.lower_bandwidth()), ku_(A.upper_bandwidth()),
+      width_(2 * A.lower_bandwidth() + A.upper_bandwidth() + 1) {
+    lu_.assign(static_cast<std::size_t>(n_) * width_, 0.0);
+    pivots_.resize(n_);
+    for (int i = 0; i < n_; ++i) {
+        for (int j = std::max(0, i - kl_); j <= std::min(n_ - 1, i + ku_); ++j) {
+            at(i, j) = A(i, j);
+        }
+    }
+
+    for (int k = 0; k < n_; ++k) {
+        const int last_row = std::min(n_ - 1, k + kl_);
+        const int last_col = std::min(n_ - 1, k + ku_ + kl_);
+
+        // Wybór elementu głównego w kolumnie k (tylko kl wierszy pod przekątną może być niezerowych)
+        int pivot_row = k;
+        double max_val = std::abs(at(k, k));
+        for (int i = k + 1; i <= last_row; ++i) {
+            if (std::abs(at(i, k)) > max_val) {
+                max_val = std::abs(at(i, k));
+                pivot_row = i;
+            }
+        }
+        if (max_val < PIVOT_TOLERANCE) {
+            throw std::runtime_error("Matrix is singular, LU decomposition failed.");
+        }
+        pivots_[k] = pivot_row;
+        if (pivot_row != k) {
+            for (int j = k; j <= last_col; ++j) {
+                std::swap(at(k, j), at(pivot_row, j));
+            }
+        }
+
+        // Eliminacja: mnożniki L zapisywane w miejscu wyzerowanych elementów
+        const double inv_pivot = 1.0 / at(k, k);
+        for (int i = k + 1; i <= last_row; ++i) {
+            const double factor = at(i, k) * inv_pivot;
+            at(i, k) = factor;
+            if (factor != 0.0) {
+                for (int j = k + 1; j <= last_col; ++j) {
+                    at(i, j) -= factor * at(k, j);
+                }
+            }
+        }
+    }
+}
+
+Vector BandLuFactorization::solve(const Vector& b) const {
+    if (static_cast<int>(b.size()) != n_) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    Vector x = b;
+    // Lz = Pb: przestawienia stosowane w tej samej kolejności co podczas rozkładu
+    for (int k = 0; k < n_; ++k) {
+        std::swap(x[k], x[pivots_[k]]);
+        const int last_row = std::min(n_ - 1, k + kl_);
+        for (int i = k + 1; i <= last_row; ++i) {
+            x[i] -= at(i, k) * x[k];
+        }
+    }
+    // Ux = z
+    for (int i = n_ - 1; i >= 0; --i) {
+        const int last_col = std::min(n_ - 1, i + ku_ + kl_);
+        double sum = x[i];
+        for (int j = i + 1; j <= last_col; ++j) {
+            sum -= at(i, j) * x[j];
+        }
+        x[i] = sum / at(i, i);
+    }
+    return x;
+}
+
+Vector solve_banded(const BandMatrix& A, const Vector& b) {
+    if (static_cast<int>(b.size()) != A.size()) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    return BandLuFactorization(A).solve(b);
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "blas.h"
+#include "dense_kernels.h"
+#include <stdexcept>
+#include <algorithm>
+
+namespace {
+    // Kroki (wiersz, kolumna) elementów op(A) w pamięci; transpozycja to ich zamiana.
+    struct Strides {
+        int rows;
+        int cols;
+        int row_step;
+        int col_step;
+    };
+
+    Strides op_strides(ConstMatrixView A, Transpose trans) {
+        if (trans == Transpose::No) {
+            return { A.rows, A.cols, A.stride, 1 };
+        }
+        return { A.cols, A.rows, 1, A.stride };
+    }
+
+    // y = beta * y (przy beta = 0 zerowanie, tak aby NaN z poprzedniej zawartości nie przeciekał)
+    void scale(double beta, double* y, int n) {
+        if (beta == 0.0) {
+            std::fill(y, y + n, 0.0);
+        } else if (beta != 1.0) {
+            for (int i = 0; i < n; ++i) {
+                y[i] *= beta;
+            }
+        }
+    }
+
+    void validate_triangular(ConstMatrixView T, int rows) {
+        if (T.rows != T.cols || T.rows != rows) {
+            throw std::invalid_argument("Invalid matrix or vector dimensions.");
+        }
+    }
+} // anonymous namespace
+
+void gemv(Transpose trans, double alpha, ConstMatrixView A, const Vector& x, double beta, Vector& y) {
+    const Strides op = op_strides(A, trans);
+    if (static_cast<int>(x.size()) != op.cols || static_cast<int>(y.size()) != op.rows) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    gemv(trans, alpha, A, x.data(), beta, y.data());
+}
+
+void gemv(Transpose trans, double alpha, ConstMatrixView A, const double* x, double beta, double* y) {
+    const Strides op = op_strides(A, trans);
+    scale(beta, y, op.rows);
+    kernels::gemv_accumulate(op.rows, op.cols, alpha, A.data, op.row_step, op.col_step, x, y);
+}
+
+void gemm(Transpose trans_a, Transpose trans_b, double alpha, ConstMatrixView A, ConstMatrixView B,
+          double beta, MatrixView C) {
+    const Strides a = op_strides(A, trans_a);
+    const Strides b = op_strides(B, trans_b);
+    if (a.cols != b.rows || C.rows != a.rows || C.cols != b.cols) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    for (int i = 0; i < C.rows; ++i) {
+        scale(beta, C.row(i), C.cols);
+    }
+    kernels::gemm_strided(a.rows, b.cols, a.cols, alpha, A.data, a.row_step, a.col_step,
+                          B.data, b.row_step, b.col_step, C.data, C.stride);
+}
+
+void trsv(Triangle uplo, Transpose trans, Diagonal diag, ConstMatrixView T, Vector& x) {
+    validate_triangular(T, static_cast<int>(x.size()));
+    trsv(uplo, trans, diag, T, x.data());
+}
+
+void trsv(Triangle uplo, Transpose trans, Diagonal diag, ConstMatrixView T, double* x) {
+    validate_triangular(T, T.rows);
+    const Strides op = op_strides(T, trans);
+    // Transpozycja zamienia trójkąt dolny na górny
+    const bool lower = (uplo == Triangle::Lower) == (trans == Transpose::No);
+    kernels::trsv(lower, diag == Diagonal::Unit, T.rows, T.data, op.row_step, op.col_step, x);
+}
+
+void trsm(Triangle uplo, Transpose trans, Diagonal diag, ConstMatrixView T, MatrixView B) {
+    validate_triangular(T, B.rows);
+    const Strides op = op_strides(T, trans);
+    const bool lower = (uplo == Triangle::Lower) == (trans == Transpose::No);
+    kernels::trsm(lower, diag == Diagonal::Unit, B.rows, B.cols, T.data, op.row_step, op.col_step,
+                  B.data, B.stride);
+}
+
+Vector multiply(const DenseMatrix& A, const Vector& x) {
+    Vector y(A.rows());
+    gemv(Transpose::No, 1.0, A.view(), x, 0.0, y);
+    return y;
+}
+
+DenseMatrix multiply(const DenseMatrix& A, const DenseMatrix& B) {
+    DenseMatrix C(A.rows(), B.cols());
+    gemm(Transpose::No, Transpose::No, 1.0, A.view(), B.view(), 0.0, C.view());
+    return C;
+}
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include "cubature.h"
+#include "integration.h" // gauss_legendre_rule oraz wspólny podział pracy między wątki
+#include <stdexcept>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+using integration_detail::PARALLEL_CHUNKS;
+
+namespace {
+    /// Środek i połowa długości przedziału w każdym wymiarze.
+    struct Box {
+        std::vector<double> lower, width, mid, half;
+        double volume = 1.0;     ///< Iloczyn (upper_k - lower_k), ze znakiem
+        double half_volume = 1.0; ///< Iloczyn połówek długości (jakobian przejścia z [-1, 1]^d)
+    };
+
+    Box make_box(const std::vector<double>& lower, const std::vector<double>& upper) {
+        if (lower.empty() || lower.size() != upper.size()) {
+            throw std::invalid_argument("Integration bounds must have the same positive dimension.");
+        }
+        Box box;
+        box.lower = lower;
+        for (std::size_t k = 0; k < lower.size(); ++k) {
+            const double width = upper[k] - lower[k];
+            box.width.push_back(width);
+            box.mid.push_back(0.5 * (lower[k] + upper[k]));
+            box.half.push_back(0.5 * width);
+            box.volume *= width;
+            box.half_volume *= 0.5 * width;
+        }
+        return box;
+    }
+
+    /// Suma range_sum(begin, end) po stałym podziale [0, total) na porcje, dodawana parami.
+    double parallel_sum(long long total, int threads, const std::function<double(long long, long long)>& range_sum) {
+        const long long chunk = (total + PARALLEL_CHUNKS - 1) / PARALLEL_CHUNKS;
+        const int chunks = static_cast<int>((total + chunk - 1) / chunk);
+        std::vector<double> partial(chunks);
+        integration_detail::run_chunks(chunks, threads, [&](int c) {
+            const long long begin = c * chunk;
+            partial[c] = range_sum(begin, std::min(total, begin + chunk));
+        });
+        return integration_detail::pairwise_sum(partial.data(), chunks);
+    }
+
+    /// Liczba węzłów iloczynu tensorowego reguł o counts[k] węzłach.
+    long long tensor_size(const std::vector<int>& counts) {
+        long long total = 1;
+        for (int n : counts) {
+            if (total > std::numeric_limits<long long>::max() / n) {
+                throw std::invalid_argument("Too many cubature points.");
+            }
+            total *= n;
+        }
+        return total;
+    }
+
+    /// Suma w_p f(x_p) po węzłach begin <= p < end iloczynu tensorowego (ostatni wymiar zmienia się najszybciej).
+    double tensor_range_sum(const MultivariateFunction& func, const std::vector<const GaussRule*>& rules,
+                            const Box& box, long long begin, long long end) {
+        const int d = static_cast<int>(rules.size());
+        std::vector<int> index(d);
+        std::vector<double> x(d);
+        long long rest = begin;
+        for (int k = d - 1; k >= 0; --k) {
+            const int n = static_cast<int>(rules[k]->nodes.size());
+            index[k] = static_cast<int>(rest % n);
+            rest /= n;
+        }
+        double sum = 0.0;
+        for (long long p = begin; p < end; ++p) {
+            double weight = 1.0;
+            for (int k = 0; k < d; ++k) {
+                x[k] = box.mid[k] + box.half[k] * rules[k]->nodes[index[k]];
+                weight *= rules[k]->weights[index[k]];
+            }
+            sum += weight * func(x.data());
+            for (int k = d - 1; k >= 0; --k) {
+                if (++index[k] < static_cast<int>(rules[k]->nodes.size())) break;
+                index[k] = 0;
+            }
+        }
+        return sum;
+    }
+
+    /// Całka iloczynem tensorowym reguł Gaussa o counts[k] węzłach.
+    double tensor_gauss(const MultivariateFunction& func, const std::vector<int>& counts, const Box& box, int threads) {
+        std::vector<const GaussRule*> rules;
+        for (int n : counts) {
+            rules.push_back(&gauss_legendre_rule(n));
+        }
+        const long long total = tensor_size(counts);
+        return box.half_volume * parallel_sum(total, threads, [&](long long begin, long long end) {
+            return tensor_range_sum(func, rules, box, begin, end);
+        });
+    }
+
+    /// Wszystkie wielowskaźniki i (i_k >= 1) o sumie z przedziału [low, high].
+    void multi_indices(int k, int sum, int low, int high, std::vector<int>& current, std::vector<std::vector<int>>& out) {
+        const int d = static_cast<int>(current.size());
+        if (k == d) {
+            if (sum >= low) out.push_back(current);
+            return;
+        }
+        // Pozostałe wymiary potrzebują co najmniej po jednym węźle
+        for (int i = 1; sum + i + (d - k - 1) <= high; ++i) {
+            current[k] = i;
+            multi_indices(k + 1, sum + i, low, high, current, out);
+        }
+    }
+
+    /// Współczynnik Smolyaka (-1)^(q - |i|) C(d - 1, q - |i|) dla q = level + d - 1 (0 poza zakresem).
+    double smolyak_coefficient(int level, int d, int norm) {
+        const int m = level + d - 1 - norm;
+        if (level < 1 || norm < d || m < 0 || m > d - 1) return 0.0;
+        double binomial = 1.0;
+        for (int j = 1; j <= m; ++j) {
+            binomial = binomial * (d - m - 1 + j) / j;
+        }
+        return (m % 2 == 0) ? binomial : -binomial;
+    }
+
+    // Liczby kierunkowe Sobola (Joe, Kuo: new-joe-kuo-6.21201) dla wymiarów 2..16:
+    // stopień s wielomianu pierwotnego, jego współczynniki a i początkowe m_1..m_s
+    struct SobolPolynomial {
+        int s;
+        unsigned a;
+        unsigned m[6];
+    };
+
+    const SobolPolynomial SOBOL_POLYNOMIALS[] = {
+        { 1, 0, { 1 } },
+        { 2, 1, { 1, 3 } },
+        { 3, 1, { 1, 3, 1 } },
+        { 3, 2, { 1, 1, 1 } },
+        { 4, 1, { 1, 1, 3, 3 } },
+        { 4, 4, { 1, 3, 5, 13 } },
+        { 5, 2, { 1, 1, 5, 5, 17 } },
+        { 5, 4, { 1, 1, 5, 5, 5 } },
+        { 5, 7, { 1, 1, 7, 11, 19 } },
+        { 5, 11, { 1, 1, 5, 1, 1 } },
+        { 5, 13, { 1, 1, 1, 3, 11 } },
+        { 5, 14, { 1, 3, 5, 5, 31 } },
+        { 6, 1, { 1, 3, 3, 9, 7, 49 } },
+        { 6, 13, { 1, 1, 1, 15, 21, 21 } },
+        { 6, 16, { 1, 3, 1, 13, 27, 49 } },
+    };
+
+    constexpr int SOBOL_MAX_DIMENSION = 16;
+    constexpr int SOBOL_BITS = 32;
+    constexpr int QMC_REPLICAS = 8;
+
+    /// Wektory kierunkowe v[k][j] (32 bity) dla pierwszych d wymiarów.
+    std::vector<std::vector<std::uint32_t>> sobol_directions(int d) {
+        std::vector<std::vector<std::uint32_t>> v(d, std::vector<std::uint32_t>(SOBOL_BITS));
+        for (int j = 0; j < SOBOL_BITS; ++j) {
+            v[0][j] = std::uint32_t(1) << (SOBOL_BITS - 1 - j);
+        }
+        for (int k = 1; k < d; ++k) {
+            const SobolPolynomial& p = SOBOL_POLYNOMIALS[k - 1];
+            for (int j = 0; j < SOBOL_BITS; ++j) {
+                if (j < p.s) {
+                    v[k][j] = p.m[j] << (SOBOL_BITS - 1 - j);
+                    continue;
+                }
+                std::uint32_t value = v[k][j - p.s] ^ (v[k][j - p.s] >> p.s);
+                for (int i = 1; i < p.s; ++i) {
+                    if ((p.a >> (p.s - 1 - i)) & 1u) value ^= v[k][j - i];
+                }
+                v[k][j] = value;
+            }
+        }
+        return v;
+    }
+
+    /// Pierwsze d liczb pierwszych (podstawy ciągu Haltona).
+    std::vector<int> first_primes(int d) {
+        std::vector<int> primes;
+        for (int candidate = 2; static_cast<int>(primes.size()) < d; ++candidate) {
+            bool prime = true;
+            for (int p : primes) {
+                if (p * p > candidate) break;
+                if (candidate % p == 0) {
+                    prime = false;
+                    break;
+                }
+            }
+            if (prime) primes.push_back(candidate);
+        }
+        return primes;
+    }
+}
+
+CubatureResult tensor_gauss_cubature(MultivariateFunction func, const std::vector<double>& lower,
+                                     const std::vector<double>& upper, int nodes, int threads) {
+    const Box box = make_box(lower, upper);
+    if (nodes < 1) {
+        throw std::invalid_argument("Gauss-Legendre quadrature requires a positive number of nodes.");
+    }
+    const int d = static_cast<int>(lower.size());
+    CubatureResult result;
+    result.value = tensor_gauss(func, std::vector<int>(d, nodes), box, threads);
+    result.evaluations = tensor_size(std::vector<int>(d, nodes));
+    if (nodes == 1) {
+        result.error_estimate = std::numeric_limits<double>::infinity();
+        return result;
+    }
+    const double coarse = tensor_gauss(func, std::vector<int>(d, nodes - 1), box, threads);
+    result.error_estimate = std::abs(result.value - coarse);
+    result.evaluations += tensor_size(std::vector<int>(d, nodes - 1));
+    return result;
+}
+
+CubatureResult sparse_grid_cubature(MultivariateFunction func, const std::vector<double>& lower,
+                                    const std::vector<double>& upper, int level, int threads) {
+    const Box box = make_box(lower, upper);
+    if (level < 1) {
+        throw std::invalid_argument("Sparse grid level must be positive.");
+    }
+    const int d = static_cast<int>(lower.size());
+
+    // Siatki poziomu level i level - 1 (wspólne liczone raz)
+    std::vector<std::vector<int>> grids;
+    std::vector<int> current(d);
+    multi_indices(0, 0, std::max(d, level - 1), level + d - 1, current, grids);
+    const int count = static_cast<int>(grids.size());
+
+    // Każda siatka liczona w całości przez jeden wątek: wynik nie zależy od liczby wątków
+    std::vector<double> values(count);
+    integration_detail::run_chunks(count, threads, [&](int g) {
+        values[g] = tensor_gauss(func, grids[g], box, 1);
+    });
+
+    CubatureResult result;
+    double previous = 0.0;
+    for (int g = 0; g < count; ++g) {
+        int norm = 0;
+        for (int i : grids[g]) norm += i;
+        const double fine = smolyak_coefficient(level, d, norm);
+        const double coarse = smolyak_coefficient(level - 1, d, norm);
+        result.value += fine * values[g];
+        previous += coarse * values[g];
+        result.evaluations += tensor_size(grids[g]);
+    }
+    result.error_estimate = (level == 1) ? std::numeric_limits<double>::infinity() : std::abs(result.value - previous);
+    return result;
+}
+
+CubatureResult quasi_monte_carlo_cubature(MultivariateFunction func, const std::vector<double>& lower,
+                                          const std::vector<double>& upper, long long points,
+                                          QmcSequence sequence, int threads) {
+    const Box box = make_box(lower, upper);
+    const int d = static_cast<int>(lower.size());
+    if (points < QMC_REPLICAS) {
+        throw std::invalid_argument("Quasi-Monte Carlo requires at least 8 points.");
+    }
+    const long long per_replica = points / QMC_REPLICAS;
+    const bool sobol = (sequence == QmcSequence::Sobol);
+    if (sobol && d > SOBOL_MAX_DIMENSION) {
+        throw std::invalid_argument("Sobol sequence supports at most 16 dimensions.");
+    }
+    if (sobol && per_replica > (1LL << SOBOL_BITS)) {
+        throw std::invalid_argument("Too many cubature points.");
+    }
+    const std::vector<std::vector<std::uint32_t>> directions = sobol ? sobol_directions(d) : std::vector<std::vector<std::uint32_t>>();
+    const std::vector<int> primes = sobol ? std::vector<int>() : first_primes(d);
+
+    std::mt19937_64 generator(20240521);
+    double replica_mean[QMC_REPLICAS];
+    for (int r = 0; r < QMC_REPLICAS; ++r) {
+        // Losowe przesunięcie repliki: cyfrowe (Sobol) lub modulo 1 (Halton)
+        std::vector<std::uint32_t> digital_shift(d);
+        std::vector<double> shift(d);
+        for (int k = 0; k < d; ++k) {
+            digital_shift[k] = static_cast<std::uint32_t>(generator() >> 32);
+            shift[k] = std::ldexp(static_cast<double>(generator() >> 11), -53);
+        }
+
+        const double sum = parallel_sum(per_replica, threads, [&](long long begin, long long end) {
+            std::vector<double> x(d);
+            double partial = 0.0;
+            if (sobol) {
+                // Punkt begin w kolejności kodu Graya, dalej po jednym XOR na wymiar
+                std::vector<std::uint32_t> state(d, 0);
+                const unsigned long long gray = static_cast<unsigned long long>(begin) ^ (static_cast<unsigned long long>(begin) >> 1);
+                for (int j = 0; j < SOBOL_BITS; ++j) {
+                    if ((gray >> j) & 1ULL) {
+                        for (int k = 0; k < d; ++k) state[k] ^= directions[k][j];
+                    }
+                }
+                for (long long i = begin; i < end; ++i) {
+                    for (int k = 0; k < d; ++k) {
+                        const double u = std::ldexp(static_cast<double>(state[k] ^ digital_shift[k]) + 0.5, -SOBOL_BITS);
+                        x[k] = box.lower[k] + box.width[k] * u;
+                    }
+                    partial += func(x.data());
+                    int bit = 0;
+                    for (unsigned long long next = static_cast<unsigned long long>(i) + 1; (next & 1ULL) == 0; next >>= 1) ++bit;
+                    if (bit < SOBOL_BITS) {
+                        for (int k = 0; k < d; ++k) state[k] ^= directions[k][bit];
+                    }
+                }
+            }
+            else {
+                for (long long i = begin; i < end; ++i) {
+                    for (int k = 0; k < d; ++k) {
+                        // Odwrotność pierwiastka (radical inverse) w podstawie primes[k]
+                        const int base = primes[k];
+                        const double inverse_base = 1.0 / base;
+                        double u = 0.0, factor = inverse_base;
+                        for (long long n = i; n > 0; n /= base) {
+                            u += factor * static_cast<double>(n % base);
+                            factor *= inverse_base;
+                        }
+                        u += shift[k];
+                        if (u >= 1.0) u -= 1.0;
+                        x[k] = box.lower[k] + box.width[k] * u;
+                    }
+                    partial += func(x.data());
+                }
+            }
+            return partial;
+        });
+        replica_mean[r] = box.volume * sum / static_cast<double>(per_replica);
+    }
+
+    CubatureResult result;
+    for (double m : replica_mean) result.value += m;
+    result.value /= QMC_REPLICAS;
+    double variance = 0.0;
+    for (double m : replica_mean) variance += (m - result.value) * (m - result.value);
+    variance /= (QMC_REPLICAS - 1);
+    result.error_estimate = std::sqrt(variance / QMC_REPLICAS);
+    result.evaluations = per_replica * QMC_REPLICAS;
+    return result;
+}
\ No newline at end of file
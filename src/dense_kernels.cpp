@@ -0,0 +1,877 @@
+#include "dense_kernels.h"
+#include "linear_algebra.h" // dla AlignedAllocator
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define NUMERIX_X86_SIMD 1
+#define NUMERIX_TARGET(isa) __attribute__((target(isa)))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define NUMERIX_X86_SIMD 1
+#define NUMERIX_TARGET(isa)
+#endif
+
+// Funkcje oznaczone NUMERIX_INLINE są wklejane do wariantów z NUMERIX_TARGET,
+// dzięki czemu ta sama pętla jest kompilowana (i wektoryzowana) osobno dla każdego zestawu instrukcji.
+#if defined(__GNUC__) || defined(__clang__)
+#define NUMERIX_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define NUMERIX_INLINE __forceinline
+#else
+#define NUMERIX_INLINE inline
+#endif
+
+namespace kernels {
+
+namespace {
+    // Rozmiary bloków dobrane tak, aby spakowany panel A mieścił się w L2, a B w L3.
+    // MC i NC są wielokrotnościami wymiarów mikrokafelków wszystkich wariantów.
+    constexpr int MC = 120;
+    constexpr int KC = 256;
+    constexpr int NC = 2048;
+
+    // Największy mikrokafelek (MR x NR) spośród wariantów, dla bufora kafelków brzegowych.
+    constexpr int MAX_TILE = 12 * 32;
+
+    template <typename T>
+    using AlignedBuffer = std::vector<T, AlignedAllocator<T>>;
+
+    // Mikrojądro: C[MR x NR] += alpha * a * b, gdzie a i b to spakowane panele o głębokości kc.
+    template <typename T>
+    using MicroKernel = void (*)(int kc, const T* a, const T* b, T* c, int ldc, T alpha);
+
+    // Wariant skalarny; dla float kafelek jest dwa razy szerszy, jak w wersjach SIMD.
+    constexpr int SCALAR_MR = 4;
+    constexpr int SCALAR_NR = 8;
+    constexpr int SCALAR_NR_FLOAT = 16;
+
+    template <typename T, int MR, int NR>
+    void micro_kernel_scalar(int kc, const T* a, const T* b, T* c, int ldc, T alpha) {
+        T acc[MR][NR] = {};
+        for (int p = 0; p < kc; ++p) {
+            for (int i = 0; i < MR; ++i) {
+                for (int j = 0; j < NR; ++j) {
+                    acc[i][j] += a[i] * b[j];
+                }
+            }
+            a += MR;
+            b += NR;
+        }
+        for (int i = 0; i < MR; ++i) {
+            for (int j = 0; j < NR; ++j) {
+                c[i * ldc + j] += alpha * acc[i][j];
+            }
+        }
+    }
+
+#ifdef NUMERIX_X86_SIMD
+    // AVX2: kafelek 6 x 8 (12 akumulatorów ymm), AVX-512: kafelek 12 x 16 (24 akumulatory zmm).
+    // Liczba niezależnych akumulatorów musi pokryć opóźnienie FMA na obu portach wykonawczych.
+    // Warianty float mają tyle samo akumulatorów, ale każdy mieści dwa razy więcej wartości.
+    constexpr int AVX2_MR = 6;
+    constexpr int AVX2_NR = 8;
+    constexpr int AVX512_MR = 12;
+    constexpr int AVX512_NR = 16;
+    constexpr int AVX2_NR_FLOAT = 16;
+    constexpr int AVX512_NR_FLOAT = 32;
+
+    // Wiersz mikrokafelka AVX2: dwa akumulatory po 4 wartości. Jawne zmienne (zamiast tablicy)
+    // gwarantują, że kompilator trzyma akumulatory w rejestrach.
+#define NUMERIX_AVX2_ROW(i) \
+    { const __m256d ai = _mm256_broadcast_sd(a + i); \
+      c##i##0 = _mm256_fmadd_pd(ai, b0, c##i##0); c##i##1 = _mm256_fmadd_pd(ai, b1, c##i##1); }
+#define NUMERIX_AVX2_STORE(i) \
+    { double* r = c + static_cast<std::ptrdiff_t>(i) * ldc; \
+      _mm256_storeu_pd(r, _mm256_fmadd_pd(va, c##i##0, _mm256_loadu_pd(r))); \
+      _mm256_storeu_pd(r + 4, _mm256_fmadd_pd(va, c##i##1, _mm256_loadu_pd(r + 4))); }
+
+    NUMERIX_TARGET("avx2,fma")
+    void micro_kernel_avx2(int kc, const double* a, const double* b, double* c, int ldc, double alpha) {
+        __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+        __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+        __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+        __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+        __m256d c40 = _mm256_setzero_pd(), c41 = _mm256_setzero_pd();
+        __m256d c50 = _mm256_setzero_pd(), c51 = _mm256_setzero_pd();
+        for (int p = 0; p < kc; ++p) {
+            const __m256d b0 = _mm256_load_pd(b);
+            const __m256d b1 = _mm256_load_pd(b + 4);
+            NUMERIX_AVX2_ROW(0) NUMERIX_AVX2_ROW(1) NUMERIX_AVX2_ROW(2)
+            NUMERIX_AVX2_ROW(3) NUMERIX_AVX2_ROW(4) NUMERIX_AVX2_ROW(5)
+            a += AVX2_MR;
+            b += AVX2_NR;
+        }
+        const __m256d va = _mm256_set1_pd(alpha);
+        NUMERIX_AVX2_STORE(0) NUMERIX_AVX2_STORE(1) NUMERIX_AVX2_STORE(2)
+        NUMERIX_AVX2_STORE(3) NUMERIX_AVX2_STORE(4) NUMERIX_AVX2_STORE(5)
+    }
+#undef NUMERIX_AVX2_ROW
+#undef NUMERIX_AVX2_STORE
+
+#define NUMERIX_AVX2_ROW_PS(i) \
+    { const __m256 ai = _mm256_broadcast_ss(a + i); \
+      c##i##0 = _mm256_fmadd_ps(ai, b0, c##i##0); c##i##1 = _mm256_fmadd_ps(ai, b1, c##i##1); }
+#define NUMERIX_AVX2_STORE_PS(i) \
+    { float* r = c + static_cast<std::ptrdiff_t>(i) * ldc; \
+      _mm256_storeu_ps(r, _mm256_fmadd_ps(va, c##i##0, _mm256_loadu_ps(r))); \
+      _mm256_storeu_ps(r + 8, _mm256_fmadd_ps(va, c##i##1, _mm256_loadu_ps(r + 8))); }
+
+    NUMERIX_TARGET("avx2,fma")
+    void micro_kernel_avx2(int kc, const float* a, const float* b, float* c, int ldc, float alpha) {
+        __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+        __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+        __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+        __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+        __m256 c40 = _mm256_setzero_ps(), c41 = _mm256_setzero_ps();
+        __m256 c50 = _mm256_setzero_ps(), c51 = _mm256_setzero_ps();
+        for (int p = 0; p < kc; ++p) {
+            const __m256 b0 = _mm256_load_ps(b);
+            const __m256 b1 = _mm256_load_ps(b + 8);
+            NUMERIX_AVX2_ROW_PS(0) NUMERIX_AVX2_ROW_PS(1) NUMERIX_AVX2_ROW_PS(2)
+            NUMERIX_AVX2_ROW_PS(3) NUMERIX_AVX2_ROW_PS(4) NUMERIX_AVX2_ROW_PS(5)
+            a += AVX2_MR;
+            b += AVX2_NR_FLOAT;
+        }
+        const __m256 va = _mm256_set1_ps(alpha);
+        NUMERIX_AVX2_STORE_PS(0) NUMERIX_AVX2_STORE_PS(1) NUMERIX_AVX2_STORE_PS(2)
+        NUMERIX_AVX2_STORE_PS(3) NUMERIX_AVX2_STORE_PS(4) NUMERIX_AVX2_STORE_PS(5)
+    }
+#undef NUMERIX_AVX2_ROW_PS
+#undef NUMERIX_AVX2_STORE_PS
+
+    NUMERIX_TARGET("avx512f")
+    void micro_kernel_avx512(int kc, const double* a, const double* b, double* c, int ldc, double alpha) {
+        __m512d acc[AVX512_MR][2];
+        for (int i = 0; i < AVX512_MR; ++i) {
+            acc[i][0] = _mm512_setzero_pd();
+            acc[i][1] = _mm512_setzero_pd();
+        }
+        for (int p = 0; p < kc; ++p) {
+            const __m512d b0 = _mm512_load_pd(b);
+            const __m512d b1 = _mm512_load_pd(b + 8);
+            for (int i = 0; i < AVX512_MR; ++i) {
+                const __m512d ai = _mm512_set1_pd(a[i]);
+                acc[i][0] = _mm512_fmadd_pd(ai, b0, acc[i][0]);
+                acc[i][1] = _mm512_fmadd_pd(ai, b1, acc[i][1]);
+            }
+            a += AVX512_MR;
+            b += AVX512_NR;
+        }
+        const __m512d va = _mm512_set1_pd(alpha);
+        for (int i = 0; i < AVX512_MR; ++i) {
+            double* r = c + static_cast<std::ptrdiff_t>(i) * ldc;
+            _mm512_storeu_pd(r, _mm512_fmadd_pd(va, acc[i][0], _mm512_loadu_pd(r)));
+            _mm512_storeu_pd(r + 8, _mm512_fmadd_pd(va, acc[i][1], _mm512_loadu_pd(r + 8)));
+        }
+    }
+
+    NUMERIX_TARGET("avx512f")
+    void micro_kernel_avx512(int kc, const float* a, const float* b, float* c, int ldc, float alpha) {
+        __m512 acc[AVX512_MR][2];
+        for (int i = 0; i < AVX512_MR; ++i) {
+            acc[i][0] = _mm512_setzero_ps();
+            acc[i][1] = _mm512_setzero_ps();
+        }
+        for (int p = 0; p < kc; ++p) {
+            const __m512 b0 = _mm512_load_ps(b);
+            const __m512 b1 = _mm512_load_ps(b + 16);
+            for (int i = 0; i < AVX512_MR; ++i) {
+                const __m512 ai = _mm512_set1_ps(a[i]);
+                acc[i][0] = _mm512_fmadd_ps(ai, b0, acc[i][0]);
+                acc[i][1] = _mm512_fmadd_ps(ai, b1, acc[i][1]);
+            }
+            a += AVX512_MR;
+            b += AVX512_NR_FLOAT;
+        }
+        const __m512 va = _mm512_set1_ps(alpha);
+        for (int i = 0; i < AVX512_MR; ++i) {
+            float* r = c + static_cast<std::ptrdiff_t>(i) * ldc;
+            _mm512_storeu_ps(r, _mm512_fmadd_ps(va, acc[i][0], _mm512_loadu_ps(r)));
+            _mm512_storeu_ps(r + 16, _mm512_fmadd_ps(va, acc[i][1], _mm512_loadu_ps(r + 16)));
+        }
+    }
+
+    bool cpu_has_avx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4];
+        __cpuid(regs, 1);
+        bool osxsave = (regs[2] & (1 << 27)) != 0, fma = (regs[2] & (1 << 12)) != 0;
+        if (!osxsave || !fma || (_xgetbv(0) & 0x6) != 0x6) return false;
+        __cpuidex(regs, 7, 0);
+        return (regs[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+    }
+
+    bool cpu_has_avx512() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int regs[4];
+        __cpuid(regs, 1);
+        if ((regs[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0xE6) != 0xE6) return false;
+        __cpuidex(regs, 7, 0);
+        return (regs[1] & (1 << 16)) != 0;
+#else
+        return __builtin_cpu_supports("avx512f");
+#endif
+    }
+#endif // NUMERIX_X86_SIMD
+
+    enum class SimdLevel { Scalar, Avx2, Avx512 };
+
+    // Poziom instrukcji wektorowych dostępny na procesorze. Zmienna środowiskowa NUMERIX_SIMD
+    // (scalar, avx2, avx512) pozwala wymusić słabszy wariant, np. do testów porównawczych.
+    SimdLevel detect_simd_level() {
+#ifdef NUMERIX_X86_SIMD
+        const char* env = std::getenv("NUMERIX_SIMD");
+        const bool allow_avx2 = !env || std::strcmp(env, "scalar") != 0;
+        const bool allow_avx512 = allow_avx2 && (!env || std::strcmp(env, "avx2") != 0);
+        if (allow_avx512 && cpu_has_avx512()) {
+            return SimdLevel::Avx512;
+        }
+        if (allow_avx2 && cpu_has_avx2()) {
+            return SimdLevel::Avx2;
+        }
+#endif
+        return SimdLevel::Scalar;
+    }
+
+    SimdLevel simd_level() {
+        static const SimdLevel level = detect_simd_level();
+        return level;
+    }
+
+    template <typename T>
+    struct KernelChoice {
+        MicroKernel<T> kernel;
+        int mr;
+        int nr;
+        const char* name;
+    };
+
+    KernelChoice<double> select_kernel(double) {
+        switch (simd_level()) {
+#ifdef NUMERIX_X86_SIMD
+        case SimdLevel::Avx512:
+            return { micro_kernel_avx512, AVX512_MR, AVX512_NR, "avx512" };
+        case SimdLevel::Avx2:
+            return { micro_kernel_avx2, AVX2_MR, AVX2_NR, "avx2" };
+#endif
+        default:
+            return { micro_kernel_scalar<double, SCALAR_MR, SCALAR_NR>, SCALAR_MR, SCALAR_NR, "scalar" };
+        }
+    }
+
+    KernelChoice<float> select_kernel(float) {
+        switch (simd_level()) {
+#ifdef NUMERIX_X86_SIMD
+        case SimdLevel::Avx512:
+            return { micro_kernel_avx512, AVX512_MR, AVX512_NR_FLOAT, "avx512" };
+        case SimdLevel::Avx2:
+            return { micro_kernel_avx2, AVX2_MR, AVX2_NR_FLOAT, "avx2" };
+#endif
+        default:
+            return { micro_kernel_scalar<float, SCALAR_MR, SCALAR_NR_FLOAT>, SCALAR_MR, SCALAR_NR_FLOAT, "scalar" };
+        }
+    }
+
+    template <typename T>
+    const KernelChoice<T>& kernel_choice() {
+        static const KernelChoice<T> choice = select_kernel(T());
+        return choice;
+    }
+
+    // Pakuje blok A (mc x kc) w pionowe paski po mr wierszy; brakujące wiersze uzupełnia zerami.
+    // Element (i, p) leży pod A[i * rs + p * cs], co obejmuje również macierz transponowaną.
+    template <typename T>
+    void pack_a(int mc, int kc, const T* A, int rs, int cs, int mr, T* buf) {
+        for (int r0 = 0; r0 < mc; r0 += mr) {
+            const int rows = std::min(mr, mc - r0);
+            for (int p = 0; p < kc; ++p) {
+                const T* src = A + static_cast<std::ptrdiff_t>(r0) * rs + static_cast<std::ptrdiff_t>(p) * cs;
+                for (int i = 0; i < rows; ++i) {
+                    buf[i] = src[static_cast<std::ptrdiff_t>(i) * rs];
+                }
+                for (int i = rows; i < mr; ++i) {
+                    buf[i] = T(0);
+                }
+                buf += mr;
+            }
+        }
+    }
+
+    // Pakuje blok B (kc x nc) w poziome paski po nr kolumn; brakujące kolumny uzupełnia zerami.
+    template <typename T>
+    void pack_b(int kc, int nc, const T* B, int rs, int cs, int nr, T* buf) {
+        for (int c0 = 0; c0 < nc; c0 += nr) {
+            const int cols = std::min(nr, nc - c0);
+            for (int p = 0; p < kc; ++p) {
+                const T* src = B + static_cast<std::ptrdiff_t>(p) * rs + static_cast<std::ptrdiff_t>(c0) * cs;
+                if (cs == 1) {
+                    for (int j = 0; j < cols; ++j) {
+                        buf[j] = src[j];
+                    }
+                } else {
+                    for (int j = 0; j < cols; ++j) {
+                        buf[j] = src[static_cast<std::ptrdiff_t>(j) * cs];
+                    }
+                }
+                for (int j = cols; j < nr; ++j) {
+                    buf[j] = T(0);
+                }
+                buf += nr;
+            }
+        }
+    }
+
+    template <typename T>
+    void gemm_blocked(int m, int n, int k, T alpha,
+                      const T* A, int rsa, int csa, const T* B, int rsb, int csb, T* C, int ldc) {
+        if (m <= 0 || n <= 0 || k <= 0 || alpha == T(0)) {
+            return;
+        }
+        const KernelChoice<T>& choice = kernel_choice<T>();
+        const MicroKernel<T> kernel = choice.kernel;
+        const int MR = choice.mr;
+        const int NR = choice.nr;
+
+        // Bufory pakujące są lokalne dla wątku i wielokrotnie używane między wywołaniami.
+        thread_local AlignedBuffer<T> packed_a;
+        thread_local AlignedBuffer<T> packed_b;
+        packed_a.resize(static_cast<std::size_t>(MC) * KC);
+        packed_b.resize(static_cast<std::size_t>(KC) * NC);
+
+        alignas(64) T edge[MAX_TILE];
+
+        for (int jc = 0; jc < n; jc += NC) {
+            const int nc = std::min(NC, n - jc);
+            for (int pc = 0; pc < k; pc += KC) {
+                const int kc = std::min(KC, k - pc);
+                pack_b(kc, nc, B + static_cast<std::ptrdiff_t>(pc) * rsb + static_cast<std::ptrdiff_t>(jc) * csb,
+                       rsb, csb, NR, packed_b.data());
+
+                for (int ic = 0; ic < m; ic += MC) {
+                    const int mc = std::min(MC, m - ic);
+                    pack_a(mc, kc, A + static_cast<std::ptrdiff_t>(ic) * rsa + static_cast<std::ptrdiff_t>(pc) * csa,
+                           rsa, csa, MR, packed_a.data());
+
+                    for (int jr = 0; jr < nc; jr += NR) {
+                        const int nr = std::min(NR, nc - jr);
+                        const T* bp = packed_b.data() + static_cast<std::size_t>(jr) * kc;
+                        for (int ir = 0; ir < mc; ir += MR) {
+                            const int mr = std::min(MR, mc - ir);
+                            const T* ap = packed_a.data() + static_cast<std::size_t>(ir) * kc;
+                            T* cp = C + static_cast<std::ptrdiff_t>(ic + ir) * ldc + jc + jr;
+                            if (mr == MR && nr == NR) {
+                                kernel(kc, ap, bp, cp, ldc, alpha);
+                            } else {
+                                // Kafelek brzegowy: licz do bufora tymczasowego i dodaj tylko istniejące elementy
+                                std::fill(edge, edge + MR * NR, T(0));
+                                kernel(kc, ap, bp, edge, NR, alpha);
+                                for (int i = 0; i < mr; ++i) {
+                                    for (int j = 0; j < nr; ++j) {
+                                        cp[static_cast<std::ptrdiff_t>(i) * ldc + j] += edge[i * NR + j];
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // y += alpha * A x dla A (m x n) w układzie wierszowym. Cztery wiersze naraz dzielą odczyty x,
+    // a osiem sum częściowych na wiersz pozwala wektoryzować bez zmiany kolejności działań.
+    template <typename T>
+    NUMERIX_INLINE void gemv_rows_body(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        const auto reduce = [](const T* s) { return ((s[0] + s[1]) + (s[2] + s[3])) + ((s[4] + s[5]) + (s[6] + s[7])); };
+        int i = 0;
+        for (; i + 4 <= m; i += 4) {
+            const T* a0 = A + static_cast<std::ptrdiff_t>(i) * lda;
+            const T* a1 = a0 + lda;
+            const T* a2 = a1 + lda;
+            const T* a3 = a2 + lda;
+            T s0[8] = {}, s1[8] = {}, s2[8] = {}, s3[8] = {};
+            int j = 0;
+            for (; j + 8 <= n; j += 8) {
+                for (int u = 0; u < 8; ++u) {
+                    const T xv = x[j + u];
+                    s0[u] += a0[j + u] * xv;
+                    s1[u] += a1[j + u] * xv;
+                    s2[u] += a2[j + u] * xv;
+                    s3[u] += a3[j + u] * xv;
+                }
+            }
+            T t0 = reduce(s0), t1 = reduce(s1), t2 = reduce(s2), t3 = reduce(s3);
+            for (; j < n; ++j) {
+                t0 += a0[j] * x[j];
+                t1 += a1[j] * x[j];
+                t2 += a2[j] * x[j];
+                t3 += a3[j] * x[j];
+            }
+            y[i] += alpha * t0;
+            y[i + 1] += alpha * t1;
+            y[i + 2] += alpha * t2;
+            y[i + 3] += alpha * t3;
+        }
+        for (; i < m; ++i) {
+            const T* a0 = A + static_cast<std::ptrdiff_t>(i) * lda;
+            T s0[8] = {};
+            int j = 0;
+            for (; j + 8 <= n; j += 8) {
+                for (int u = 0; u < 8; ++u) {
+                    s0[u] += a0[j + u] * x[j + u];
+                }
+            }
+            T t0 = reduce(s0);
+            for (; j < n; ++j) {
+                t0 += a0[j] * x[j];
+            }
+            y[i] += alpha * t0;
+        }
+    }
+
+    // y += alpha * A^T x dla A (m x n) w układzie wierszowym: kombinacja liniowa wierszy,
+    // po cztery naraz, aby każdy element y był odczytywany i zapisywany raz na cztery wiersze.
+    template <typename T>
+    NUMERIX_INLINE void gemv_columns_body(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        int i = 0;
+        for (; i + 4 <= m; i += 4) {
+            const T* a0 = A + static_cast<std::ptrdiff_t>(i) * lda;
+            const T* a1 = a0 + lda;
+            const T* a2 = a1 + lda;
+            const T* a3 = a2 + lda;
+            const T c0 = alpha * x[i], c1 = alpha * x[i + 1], c2 = alpha * x[i + 2], c3 = alpha * x[i + 3];
+            for (int j = 0; j < n; ++j) {
+                y[j] += (c0 * a0[j] + c1 * a1[j]) + (c2 * a2[j] + c3 * a3[j]);
+            }
+        }
+        for (; i < m; ++i) {
+            const T* a0 = A + static_cast<std::ptrdiff_t>(i) * lda;
+            const T c0 = alpha * x[i];
+            for (int j = 0; j < n; ++j) {
+                y[j] += c0 * a0[j];
+            }
+        }
+    }
+
+    template <typename T>
+    void gemv_rows_generic(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        gemv_rows_body(m, n, alpha, A, lda, x, y);
+    }
+
+    template <typename T>
+    void gemv_columns_generic(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        gemv_columns_body(m, n, alpha, A, lda, x, y);
+    }
+
+#ifdef NUMERIX_X86_SIMD
+    template <typename T>
+    NUMERIX_TARGET("avx2,fma")
+    void gemv_rows_avx2(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        gemv_rows_body(m, n, alpha, A, lda, x, y);
+    }
+
+    template <typename T>
+    NUMERIX_TARGET("avx2,fma")
+    void gemv_columns_avx2(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        gemv_columns_body(m, n, alpha, A, lda, x, y);
+    }
+
+    template <typename T>
+    NUMERIX_TARGET("avx512f")
+    void gemv_rows_avx512(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        gemv_rows_body(m, n, alpha, A, lda, x, y);
+    }
+
+    template <typename T>
+    NUMERIX_TARGET("avx512f")
+    void gemv_columns_avx512(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        gemv_columns_body(m, n, alpha, A, lda, x, y);
+    }
+#endif
+
+    template <typename T>
+    void gemv_rows(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        if (m <= 0 || n <= 0 || alpha == T(0)) return;
+        switch (simd_level()) {
+#ifdef NUMERIX_X86_SIMD
+        case SimdLevel::Avx512:
+            return gemv_rows_avx512(m, n, alpha, A, lda, x, y);
+        case SimdLevel::Avx2:
+            return gemv_rows_avx2(m, n, alpha, A, lda, x, y);
+#endif
+        default:
+            return gemv_rows_generic(m, n, alpha, A, lda, x, y);
+        }
+    }
+
+    template <typename T>
+    void gemv_columns(int m, int n, T alpha, const T* A, int lda, const T* x, T* y) {
+        if (m <= 0 || n <= 0 || alpha == T(0)) return;
+        switch (simd_level()) {
+#ifdef NUMERIX_X86_SIMD
+        case SimdLevel::Avx512:
+            return gemv_columns_avx512(m, n, alpha, A, lda, x, y);
+        case SimdLevel::Avx2:
+            return gemv_columns_avx2(m, n, alpha, A, lda, x, y);
+#endif
+        default:
+            return gemv_columns_generic(m, n, alpha, A, lda, x, y);
+        }
+    }
+
+    // y += alpha * op(A) x, gdzie element (i, j) macierzy op(A) (m x n) leży pod A[i * rs + j * cs].
+    template <typename T>
+    void gemv_strided(int m, int n, T alpha, const T* A, int rs, int cs, const T* x, T* y) {
+        if (cs == 1) {
+            gemv_rows(m, n, alpha, A, rs, x, y);
+        } else if (rs == 1) {
+            gemv_columns(n, m, alpha, A, cs, x, y);
+        } else {
+            for (int i = 0; i < m; ++i) {
+                T sum = T(0);
+                for (int j = 0; j < n; ++j) {
+                    sum += A[static_cast<std::ptrdiff_t>(i) * rs + static_cast<std::ptrdiff_t>(j) * cs] * x[j];
+                }
+                y[i] += alpha * sum;
+            }
+        }
+    }
+
+    // Szerokość bloku diagonalnego w TRSV i TRSM; poza blokiem działają GEMV i GEMM.
+    constexpr int TRIANGULAR_BLOCK = 64;
+
+    // Rozwiązuje op(T) x = b w miejscu dla trójkąta dolnego (lower) lub górnego, z jedynkami
+    // na przekątnej (unit) lub bez. Element (i, j) macierzy op(T) leży pod T[i * rs + j * cs].
+    template <typename T>
+    void trsv_blocked(bool lower, bool unit, int n, const T* A, int rs, int cs, T* x) {
+        const auto at = [&](int i, int j) { return A[static_cast<std::ptrdiff_t>(i) * rs + static_cast<std::ptrdiff_t>(j) * cs]; };
+        if (lower) {
+            for (int i0 = 0; i0 < n; i0 += TRIANGULAR_BLOCK) {
+                const int ib = std::min(TRIANGULAR_BLOCK, n - i0);
+                gemv_strided(ib, i0, T(-1), A + static_cast<std::ptrdiff_t>(i0) * rs, rs, cs, x, x + i0);
+                for (int i = i0; i < i0 + ib; ++i) {
+                    T sum = x[i];
+                    for (int j = i0; j < i; ++j) {
+                        sum -= at(i, j) * x[j];
+                    }
+                    x[i] = unit ? sum : sum / at(i, i);
+                }
+            }
+        } else {
+            for (int i1 = n; i1 > 0; i1 -= TRIANGULAR_BLOCK) {
+                const int i0 = std::max(0, i1 - TRIANGULAR_BLOCK);
+                gemv_strided(i1 - i0, n - i1, T(-1),
+                             A + static_cast<std::ptrdiff_t>(i0) * rs + static_cast<std::ptrdiff_t>(i1) * cs,
+                             rs, cs, x + i1, x + i0);
+                for (int i = i1 - 1; i >= i0; --i) {
+                    T sum = x[i];
+                    for (int j = i + 1; j < i1; ++j) {
+                        sum -= at(i, j) * x[j];
+                    }
+                    x[i] = unit ? sum : sum / at(i, i);
+                }
+            }
+        }
+    }
+
+    // Rozwiązuje op(T) X = B w miejscu (B := op(T)^{-1} B, T m x m, B m x n w układzie wierszowym).
+    // Blok diagonalny rozwiązywany jest bezpośrednio operacjami na całych (ciągłych) wierszach B,
+    // a jego wpływ na pozostałe wiersze odejmowany przez gemm_blocked.
+    template <typename T>
+    void trsm_blocked(bool lower, bool unit, int m, int n, const T* A, int rs, int cs, T* B, int ldb) {
+        const auto at = [&](int i, int j) { return A[static_cast<std::ptrdiff_t>(i) * rs + static_cast<std::ptrdiff_t>(j) * cs]; };
+        const auto row = [&](int i) { return B + static_cast<std::ptrdiff_t>(i) * ldb; };
+        const auto solve_row = [&](int i, int p0, int p1) {
+            T* bi = row(i);
+            for (int p = p0; p < p1; ++p) {
+                const T l = at(i, p);
+                if (l == T(0)) continue;
+                const T* bp = row(p);
+                for (int j = 0; j < n; ++j) {
+                    bi[j] -= l * bp[j];
+                }
+            }
+            if (!unit) {
+                const T inv = T(1) / at(i, i);
+                for (int j = 0; j < n; ++j) {
+                    bi[j] *= inv;
+                }
+            }
+        };
+        if (lower) {
+            for (int i0 = 0; i0 < m; i0 += TRIANGULAR_BLOCK) {
+                const int ib = std::min(TRIANGULAR_BLOCK, m - i0);
+                for (int i = i0; i < i0 + ib; ++i) {
+                    solve_row(i, i0, i);
+                }
+                gemm_blocked<T>(m - i0 - ib, n, ib, T(-1),
+                                A + static_cast<std::ptrdiff_t>(i0 + ib) * rs + static_cast<std::ptrdiff_t>(i0) * cs, rs, cs,
+                                row(i0), ldb, 1, row(i0 + ib), ldb);
+            }
+        } else {
+            for (int i1 = m; i1 > 0; i1 -= TRIANGULAR_BLOCK) {
+                const int i0 = std::max(0, i1 - TRIANGULAR_BLOCK);
+                for (int i = i1 - 1; i >= i0; --i) {
+                    solve_row(i, i + 1, i1);
+                }
+                gemm_blocked<T>(i0, n, i1 - i0, T(-1), A + static_cast<std::ptrdiff_t>(i0) * cs, rs, cs,
+                                row(i0), ldb, 1, row(0), ldb);
+            }
+        }
+    }
+} // anonymous namespace
+
+void gemm_accumulate(int m, int n, int k, double alpha,
+                     const double* A, int lda, const double* B, int ldb,
+                     double* C, int ldc) {
+    gemm_blocked(m, n, k, alpha, A, lda, 1, B, ldb, 1, C, ldc);
+}
+
+void gemm_accumulate(int m, int n, int k, float alpha,
+                     const float* A, int lda, const float* B, int ldb,
+                     float* C, int ldc) {
+    gemm_blocked(m, n, k, alpha, A, lda, 1, B, ldb, 1, C, ldc);
+}
+
+void gemm_strided(int m, int n, int k, double alpha,
+                  const double* A, int rsa, int csa, const double* B, int rsb, int csb,
+                  double* C, int ldc) {
+    gemm_blocked(m, n, k, alpha, A, rsa, csa, B, rsb, csb, C, ldc);
+}
+
+void gemv_accumulate(int m, int n, double alpha, const double* A, int rs, int cs, const double* x, double* y) {
+    gemv_strided(m, n, alpha, A, rs, cs, x, y);
+}
+
+void gemv_accumulate(int m, int n, float alpha, const float* A, int rs, int cs, const float* x, float* y) {
+    gemv_strided(m, n, alpha, A, rs, cs, x, y);
+}
+
+void trsv(bool lower, bool unit, int n, const double* T, int rs, int cs, double* x) {
+    trsv_blocked(lower, unit, n, T, rs, cs, x);
+}
+
+void trsv(bool lower, bool unit, int n, const float* T, int rs, int cs, float* x) {
+    trsv_blocked(lower, unit, n, T, rs, cs, x);
+}
+
+void trsm(bool lower, bool unit, int m, int n, const double* T, int rs, int cs, double* B, int ldb) {
+    trsm_blocked(lower, unit, m, n, T, rs, cs, B, ldb);
+}
+
+void trsm_lower_unit(int m, int n, const double* L, int ldl, double* B, int ldb) {
+    trsm_blocked(true, true, m, n, L, ldl, 1, B, ldb);
+}
+
+void trsm_lower_unit(int m, int n, const float* L, int ldl, float* B, int ldb) {
+    trsm_blocked(true, true, m, n, L, ldl, 1, B, ldb);
+}
+
+// --- Odbicia Householdera ---
+
+double norm2(int n, const double* x, int step) {
+    // Skalowanie bieżącym maksimum chroni sumę kwadratów przed nadmiarem i niedomiarem (jak dnrm2)
+    double scale = 0.0;
+    double sum = 1.0;
+    for (int i = 0; i < n; ++i) {
+        const double a = std::abs(x[static_cast<std::size_t>(i) * step]);
+        if (a == 0.0) {
+            continue;
+        }
+        if (scale < a) {
+            sum = 1.0 + sum * (scale / a) * (scale / a);
+            scale = a;
+        } else {
+            sum += (a / scale) * (a / scale);
+        }
+    }
+    return scale * std::sqrt(sum);
+}
+
+double householder(double& alpha, int n, double* x, int step) {
+    const double xnorm = norm2(n, x, step);
+    if (xnorm == 0.0) {
+        return 0.0;
+    }
+    const double beta = -std::copysign(std::hypot(alpha, xnorm), alpha);
+    const double tau = (beta - alpha) / beta;
+    const double scale = 1.0 / (alpha - beta);
+    for (int i = 0; i < n; ++i) {
+        x[static_cast<std::size_t>(i) * step] *= scale;
+    }
+    alpha = beta;
+    return tau;
+}
+
+// --- Wsadowe rozwiązywanie wielu małych układów ---
+
+namespace {
+    // Liczba układów przetwarzanych razem; dla n <= 16 dane porcji mieszczą się w L2.
+    constexpr int BATCH_CHUNK = 64;
+    constexpr double BATCH_PIVOT_TOLERANCE = 1e-12;
+
+    /**
+     * Eliminacja Gaussa z częściowym pivotowaniem dla porcji len <= BATCH_CHUNK układów.
+     * Najbardziej wewnętrzne pętle biegną po numerze układu s, czyli po ciągłej pamięci,
+     * więc kompilator wektoryzuje je niezależnie od (małego) rozmiaru n. Dla N > 0 rozmiar
+     * jest znany w czasie kompilacji i pętle po wierszach/kolumnach zostają rozwinięte.
+     * Zwraca indeks (w porcji) pierwszego układu osobliwego albo -1.
+     */
+    template <int N>
+    NUMERIX_INLINE int solve_batch_chunk(int n_runtime, int count, int len, double* a, double* b) {
+        const int n = N > 0 ? N : n_runtime;
+        const auto elem = [&](int i, int j) { return a + static_cast<std::ptrdiff_t>(i * n + j) * count; };
+        const auto rhs = [&](int i) { return b + static_cast<std::ptrdiff_t>(i) * count; };
+
+        int piv[BATCH_CHUNK];
+        double best[BATCH_CHUNK];
+        double inv[BATCH_CHUNK];
+        double factor[BATCH_CHUNK];
+        int singular = -1;
+
+        for (int k = 0; k < n; ++k) {
+            // Wybór elementu głównego osobno dla każdego układu
+            const double* akk = elem(k, k);
+            for (int s = 0; s < len; ++s) {
+                best[s] = std::abs(akk[s]);
+                piv[s] = k;
+            }
+            for (int i = k + 1; i < n; ++i) {
+                const double* aik = elem(i, k);
+                for (int s = 0; s < len; ++s) {
+                    const double v = std::abs(aik[s]);
+                    const bool better = v > best[s];
+                    best[s] = better ? v : best[s];
+                    piv[s] = better ? i : piv[s];
+                }
+            }
+            for (int s = 0; s < len; ++s) {
+                if (best[s] < BATCH_PIVOT_TOLERANCE && (singular < 0 || s < singular)) {
+                    singular = s;
+                }
+            }
+
+            // Zamiana wierszy tylko w tych układach, które jej wymagają
+            for (int s = 0; s < len; ++s) {
+                const int p = piv[s];
+                if (p != k) {
+                    for (int j = k; j < n; ++j) {
+                        std::swap(elem(k, j)[s], elem(p, j)[s]);
+                    }
+                    std::swap(rhs(k)[s], rhs(p)[s]);
+                }
+            }
+
+            for (int s = 0; s < len; ++s) {
+                inv[s] = 1.0 / akk[s];
+            }
+            const double* bk = rhs(k);
+            for (int i = k + 1; i < n; ++i) {
+                const double* aik = elem(i, k);
+                for (int s = 0; s < len; ++s) {
+                    factor[s] = aik[s] * inv[s];
+                }
+                for (int j = k + 1; j < n; ++j) {
+                    double* aij = elem(i, j);
+                    const double* akj = elem(k, j);
+                    for (int s = 0; s < len; ++s) {
+                        aij[s] -= factor[s] * akj[s];
+                    }
+                }
+                double* bi = rhs(i);
+                for (int s = 0; s < len; ++s) {
+                    bi[s] -= factor[s] * bk[s];
+                }
+            }
+        }
+
+        // Podstawienie wsteczne; rozwiązanie nadpisuje b
+        for (int i = n - 1; i >= 0; --i) {
+            double* bi = rhs(i);
+            for (int j = i + 1; j < n; ++j) {
+                const double* aij = elem(i, j);
+                const double* bj = rhs(j);
+                for (int s = 0; s < len; ++s) {
+                    bi[s] -= aij[s] * bj[s];
+                }
+            }
+            const double* aii = elem(i, i);
+            for (int s = 0; s < len; ++s) {
+                bi[s] /= aii[s];
+            }
+        }
+        return singular;
+    }
+
+    template <int N>
+    NUMERIX_INLINE int solve_batch_range(int n, int count, double* a, double* b) {
+        for (int s0 = 0; s0 < count; s0 += BATCH_CHUNK) {
+            const int len = std::min(BATCH_CHUNK, count - s0);
+            const int singular = solve_batch_chunk<N>(n, count, len, a + s0, b + s0);
+            if (singular >= 0) {
+                return s0 + singular;
+            }
+        }
+        return -1;
+    }
+
+    // Specjalizacje dla rozmiarów 1..8 znanych w czasie kompilacji, wersja ogólna dla pozostałych.
+    NUMERIX_INLINE int solve_batch_dispatch(int n, int count, double* a, double* b) {
+        switch (n) {
+        case 1: return solve_batch_range<1>(n, count, a, b);
+        case 2: return solve_batch_range<2>(n, count, a, b);
+        case 3: return solve_batch_range<3>(n, count, a, b);
+        case 4: return solve_batch_range<4>(n, count, a, b);
+        case 5: return solve_batch_range<5>(n, count, a, b);
+        case 6: return solve_batch_range<6>(n, count, a, b);
+        case 7: return solve_batch_range<7>(n, count, a, b);
+        case 8: return solve_batch_range<8>(n, count, a, b);
+        default: return solve_batch_range<0>(n, count, a, b);
+        }
+    }
+
+    int solve_batch_generic(int n, int count, double* a, double* b) {
+        return solve_batch_dispatch(n, count, a, b);
+    }
+
+#ifdef NUMERIX_X86_SIMD
+    NUMERIX_TARGET("avx2,fma")
+    int solve_batch_avx2(int n, int count, double* a, double* b) {
+        return solve_batch_dispatch(n, count, a, b);
+    }
+
+    NUMERIX_TARGET("avx512f")
+    int solve_batch_avx512(int n, int count, double* a, double* b) {
+        return solve_batch_dispatch(n, count, a, b);
+    }
+#endif
+} // anonymous namespace
+
+int solve_batched_soa(int n, int count, double* a, double* b) {
+    switch (simd_level()) {
+#ifdef NUMERIX_X86_SIMD
+    case SimdLevel::Avx512:
+        return solve_batch_avx512(n, count, a, b);
+    case SimdLevel::Avx2:
+        return solve_batch_avx2(n, count, a, b);
+#endif
+    default:
+        return solve_batch_generic(n, count, a, b);
+    }
+}
+
+const char* active_kernel_name() {
+    return kernel_choice<double>().name;
+}
+
+} // namespace kernels
\ No newline at end of file
@@ -0,0 +1,92 @@
+#ifndef DENSE_KERNELS_H
+#define DENSE_KERNELS_H
+
+/**
+ * @file dense_kernels.h
+ * @brief Wewnętrzne jądra obliczeniowe dla gęstych macierzy (nie są częścią publicznego API).
+ *
+ * Wszystkie macierze są w układzie wierszowym (row-major) i opisane wskaźnikiem na pierwszy
+ * element oraz długością wiersza w pamięci (ld).
+ */
+
+namespace kernels {
+
+/**
+ * @brief C += alpha * A * B, gdzie A ma wymiary m x k, B k x n, C m x n.
+ *
+ * Implementacja blokowa z pakowaniem paneli A i B do buforów wyrównanych pod SIMD;
+ * mikrojądro (AVX-512, AVX2/FMA lub skalarne) wybierane jest w czasie działania programu.
+ */
+void gemm_accumulate(int m, int n, int k, double alpha,
+                     const double* A, int lda, const double* B, int ldb,
+                     double* C, int ldc);
+
+/// Wariant pojedynczej precyzji (mikrojądra mieszczą w rejestrze dwa razy więcej wartości).
+void gemm_accumulate(int m, int n, int k, float alpha,
+                     const float* A, int lda, const float* B, int ldb,
+                     float* C, int ldc);
+
+/**
+ * @brief C += alpha * op(A) * op(B) dla macierzy podanych przez kroki wierszy i kolumn.
+ *
+ * Element (i, p) macierzy op(A) leży pod A[i * rsa + p * csa], a (p, j) macierzy op(B) pod
+ * B[p * rsb + j * csb]; transpozycja to zamiana kroków. C jest w układzie wierszowym.
+ */
+void gemm_strided(int m, int n, int k, double alpha,
+                  const double* A, int rsa, int csa, const double* B, int rsb, int csb,
+                  double* C, int ldc);
+
+/**
+ * @brief y += alpha * op(A) x, gdzie op(A) ma wymiary m x n, a element (i, j) leży pod A[i * rs + j * cs].
+ *
+ * Dla cs = 1 (wiersze ciągłe) liczone są iloczyny skalarne po cztery wiersze naraz, dla rs = 1
+ * (macierz transponowana) kombinacja liniowa wierszy; oba warianty wektoryzowane dla AVX2/AVX-512.
+ */
+void gemv_accumulate(int m, int n, double alpha, const double* A, int rs, int cs, const double* x, double* y);
+void gemv_accumulate(int m, int n, float alpha, const float* A, int rs, int cs, const float* x, float* y);
+
+/**
+ * @brief Rozwiązuje w miejscu op(T) x = b, T trójkątna n x n (kroki jak w gemv_accumulate).
+ * @param lower true dla macierzy op(T) dolnotrójkątnej, false dla górnotrójkątnej.
+ * @param unit true, jeśli przekątna składa się z jedynek (nie jest odczytywana).
+ */
+void trsv(bool lower, bool unit, int n, const double* T, int rs, int cs, double* x);
+void trsv(bool lower, bool unit, int n, const float* T, int rs, int cs, float* x);
+
+/**
+ * @brief Rozwiązuje w miejscu op(T) X = B (B := op(T)^{-1} B), T m x m, B m x n w układzie wierszowym.
+ */
+void trsm(bool lower, bool unit, int m, int n, const double* T, int rs, int cs, double* B, int ldb);
+
+/**
+ * @brief Rozwiązuje L X = B w miejscu (B := L^{-1} B), L dolnotrójkątna m x m z jedynkami na przekątnej.
+ */
+void trsm_lower_unit(int m, int n, const double* L, int ldl, double* B, int ldb);
+void trsm_lower_unit(int m, int n, const float* L, int ldl, float* B, int ldb);
+
+/// Norma euklidesowa elementów x[0], x[step], ..., x[(n - 1) * step], odporna na nadmiar.
+double norm2(int n, const double* x, int step);
+
+/**
+ * @brief Odbicie Householdera H = I - tau v v^T, v = [1; x'], zerujące x pod alpha (jak dlarfg).
+ *
+ * alpha zastępowane jest przez beta = -sign(alpha) ||[alpha; x]||, x przez x' (dolną część v).
+ * @return tau; zero, gdy x jest już zerowy (H = I).
+ */
+double householder(double& alpha, int n, double* x, int step);
+
+/**
+ * @brief Rozwiązuje w miejscu count niezależnych układów n x n zapisanych w układzie SoA.
+ *
+ * Element (i, j) układu s leży w a[(i * n + j) * count + s], wyraz wolny i w b[i * count + s];
+ * po powrocie b zawiera rozwiązania. Obliczenia są wektoryzowane wzdłuż numeru układu.
+ * @return Indeks pierwszego układu osobliwego albo -1.
+ */
+int solve_batched_soa(int n, int count, double* a, double* b);
+
+/// Nazwa aktualnie używanego mikrojądra: "avx512", "avx2" lub "scalar".
+const char* active_kernel_name();
+
+} // namespace kernels
+
+#endif // DENSE_KERNELS_H
\ No newline at end of file
@@ -0,0 +1,404 @@
+#include "eigen_solvers.h"
+#include "blas.h"
+#include "dense_kernels.h"
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace {
+    // Limit iteracji QL na jedną wartość własną (jak w EISPACK tql2)
+    constexpr int QL_MAX_ITERATIONS = 30;
+
+    // Względny próg normy nowego wektora Lanczosa, poniżej którego baza jest niezmiennicza
+    constexpr double LANCZOS_BREAKDOWN = 64.0 * std::numeric_limits<double>::epsilon();
+
+    // Redukcja S = Q T Q^T do postaci trójdiagonalnej (d - przekątna, e[i] - element (i, i + 1)).
+    // Odbicie k działa na indeksy k + 1..n - 1; jego wektor (bez jedynki) zostaje w S(k, k + 2..n - 1).
+    void tridiagonalize(DenseMatrix& S, Vector& d, Vector& e, Vector& tau) {
+        const int n = S.rows();
+        const int ld = S.stride();
+        Vector v(n), p(n);
+        for (int k = 0; k + 2 < n; ++k) {
+            const int r = n - k - 1;
+            const double t = kernels::householder(S(k, k + 1), r - 1, &S(k, k + 2), 1);
+            d[k] = S(k, k);
+            e[k] = S(k, k + 1);
+            tau[k] = t;
+            if (t == 0.0) {
+                continue;
+            }
+            v[0] = 1.0;
+            std::copy(&S(k, k + 2), &S(k, k + 2) + (r - 1), v.begin() + 1);
+
+            // p = t A22 v, w = p - (t / 2)(p^T v) v, A22 -= v w^T + w v^T (obie połowy macierzy)
+            std::fill(p.begin(), p.begin() + r, 0.0);
+            kernels::gemv_accumulate(r, r, t, &S(k + 1, k + 1), ld, 1, v.data(), p.data());
+            double pv = 0.0;
+            for (int i = 0; i < r; ++i) {
+                pv += p[i] * v[i];
+            }
+            const double K = -0.5 * t * pv;
+            for (int i = 0; i < r; ++i) {
+                p[i] += K * v[i];
+            }
+            for (int i = 0; i < r; ++i) {
+                double* row = &S(k + 1 + i, k + 1);
+                const double vi = v[i];
+                const double wi = p[i];
+                for (int j = 0; j < r; ++j) {
+                    row[j] -= vi * p[j] + wi * v[j];
+                }
+            }
+        }
+        if (n >= 2) {
+            d[n - 2] = S(n - 2, n - 2);
+            e[n - 2] = S(n - 2, n - 1);
+        }
+        d[n - 1] = S(n - 1, n - 1);
+        e[n - 1] = 0.0;
+    }
+
+    // Q^T = (H_0 H_1 ... H_{n-3})^T; Q gromadzona wstecz, by każde odbicie działało na coraz większy blok
+    DenseMatrix form_q_transposed(const DenseMatrix& S, const Vector& tau) {
+        const int n = S.rows();
+        DenseMatrix Q(n, n);
+        for (int i = 0; i < n; ++i) {
+            Q(i, i) = 1.0;
+        }
+        Vector v(n), w(n);
+        for (int k = n - 3; k >= 0; --k) {
+            if (tau[k] == 0.0) {
+                continue;
+            }
+            const int r = n - k - 1;
+            v[0] = 1.0;
+            std::copy(&S(k, k + 2), &S(k, k + 2) + (r - 1), v.begin() + 1);
+            std::fill(w.begin(), w.begin() + r, 0.0);
+            for (int i = 0; i < r; ++i) {
+                const double* row = &Q(k + 1 + i, k + 1);
+                for (int j = 0; j < r; ++j) {
+                    w[j] += v[i] * row[j];
+                }
+            }
+            for (int i = 0; i < r; ++i) {
+                double* row = &Q(k + 1 + i, k + 1);
+                const double f = tau[k] * v[i];
+                for (int j = 0; j < r; ++j) {
+                    row[j] -= f * w[j];
+                }
+            }
+        }
+        DenseMatrix Qt(n, n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                Qt(j, i) = Q(i, j);
+            }
+        }
+        return Qt;
+    }
+
+    // Niejawna metoda QL z przesunięciem Wilkinsona dla macierzy trójdiagonalnej (jak tql2).
+    // Obroty stosowane są do wierszy Zt (wektory własne jako wiersze), więc dostęp jest ciągły.
+    int tridiagonal_ql(Vector& d, Vector& e, DenseMatrix* Zt) {
+        const int n = static_cast<int>(d.size());
+        const double eps = std::numeric_limits<double>::epsilon();
+        const int cols = Zt ? Zt->cols() : 0;
+        int total = 0;
+        for (int l = 0; l < n; ++l) {
+            int iterations = 0;
+            int m;
+            do {
+                for (m = l; m < n - 1; ++m) {
+                    const double dd = std::abs(d[m]) + std::abs(d[m + 1]);
+                    if (std::abs(e[m]) <= eps * dd) {
+                        break;
+                    }
+                }
+                if (m == l) {
+                    break;
+                }
+                if (++iterations > QL_MAX_ITERATIONS) {
+                    throw std::runtime_error("Symmetric eigenvalue iteration did not converge.");
+                }
+                ++total;
+                double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+                double r = std::hypot(g, 1.0);
+                g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+                double s = 1.0, c = 1.0, p = 0.0;
+                int i;
+                for (i = m - 1; i >= l; --i) {
+                    const double f = s * e[i];
+                    const double b = c * e[i];
+                    r = std::hypot(f, g);
+                    e[i + 1] = r;
+                    if (r == 0.0) {
+                        // Niedomiar: macierz rozpadła się na dwa bloki
+                        d[i + 1] -= p;
+                        e[m] = 0.0;
+                        break;
+                    }
+                    s = f / r;
+                    c = g / r;
+                    g = d[i + 1] - p;
+                    r = (d[i] - g) * s + 2.0 * c * b;
+                    p = s * r;
+                    d[i + 1] = g + p;
+                    g = c * r - b;
+                    if (Zt) {
+                        double* zi = Zt->row(i);
+                        double* zi1 = Zt->row(i + 1);
+                        for (int k = 0; k < cols; ++k) {
+                            const double z = zi1[k];
+                            zi1[k] = s * zi[k] + c * z;
+                            zi[k] = c * zi[k] - s * z;
+                        }
+                    }
+                }
+                if (r == 0.0 && i >= l) {
+                    continue;
+                }
+                d[l] -= p;
+                e[l] = g;
+                e[m] = 0.0;
+            } while (m != l);
+        }
+        return total;
+    }
+
+    // Losowy wektor jednostkowy o stałym ziarnie (powtarzalne wyniki metod iteracyjnych)
+    void random_unit_vector(std::mt19937& gen, double* x, int n) {
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (int i = 0; i < n; ++i) {
+            x[i] = dist(gen);
+        }
+        const double norm = kernels::norm2(n, x, 1);
+        for (int i = 0; i < n; ++i) {
+            x[i] /= norm;
+        }
+    }
+
+    // w -= V^T (V w) dla wierszy 0..k-1 bazy V, dwukrotnie (DGKS); zwraca sumaryczne współczynniki w h
+    void orthogonalize(const DenseMatrix& V, int k, double* w, double* h, double* correction) {
+        const ConstMatrixView basis = V.block(0, 0, k, V.cols());
+        gemv(Transpose::No, 1.0, basis, w, 0.0, h);
+        gemv(Transpose::Yes, -1.0, basis, h, 1.0, w);
+        gemv(Transpose::No, 1.0, basis, w, 0.0, correction);
+        gemv(Transpose::Yes, -1.0, basis, correction, 1.0, w);
+        for (int i = 0; i < k; ++i) {
+            h[i] += correction[i];
+        }
+    }
+} // anonymous namespace
+
+// --- Rozkład gęsty ---
+
+EigenPairs symmetric_eigen(const DenseMatrix& A, bool compute_vectors) {
+    const int n = A.rows();
+    if (n == 0 || A.cols() != n) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    DenseMatrix S(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            S(i, j) = S(j, i) = A(i, j);
+        }
+    }
+
+    Vector d(n), e(n), tau(n, 0.0);
+    tridiagonalize(S, d, e, tau);
+    DenseMatrix Zt;
+    if (compute_vectors) {
+        Zt = form_q_transposed(S, tau);
+    }
+
+    EigenPairs result;
+    result.iterations = tridiagonal_ql(d, e, compute_vectors ? &Zt : nullptr);
+
+    std::vector<int> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&d](int a, int b) { return d[a] < d[b]; });
+    result.values.resize(n);
+    for (int j = 0; j < n; ++j) {
+        result.values[j] = d[order[j]];
+    }
+    if (compute_vectors) {
+        result.vectors = DenseMatrix(n, n);
+        for (int j = 0; j < n; ++j) {
+            const double* z = Zt.row(order[j]);
+            for (int i = 0; i < n; ++i) {
+                result.vectors(i, j) = z[i];
+            }
+        }
+    }
+    return result;
+}
+
+// --- Metoda Lanczosa z grubym restartem ---
+
+EigenPairs lanczos_eigen(const LinearOperator& A, int count, EigenTarget target,
+                         double tolerance, int max_iterations, int subspace_size) {
+    const int n = A.size();
+    if (count < 1 || count > n) {
+        throw std::invalid_argument("Number of eigenpairs must be between 1 and the operator size.");
+    }
+    if (tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive.");
+    }
+    if (max_iterations <= 0) {
+        throw std::invalid_argument("Maximum iterations must be positive.");
+    }
+    const int m = std::min(n, subspace_size > 0 ? subspace_size : std::max(2 * count + 1, 20));
+    if (m <= count && m < n) {
+        throw std::invalid_argument("Lanczos subspace must be larger than the number of eigenpairs.");
+    }
+
+    // Baza w wierszach V (m + 1 wektorów, ostatni to znormalizowane residuum), T = V^T A V
+    DenseMatrix V(m + 1, n);
+    DenseMatrix T(m, m);
+    Vector w(n), h(m + 1), correction(m + 1);
+    std::mt19937 gen(12345);
+    random_unit_vector(gen, V.row(0), n);
+
+    int j = 0;
+    int matvecs = 0;
+    double scale = 0.0;
+    while (true) {
+        double beta = 0.0;
+        for (; j < m; ++j) {
+            A.apply(V.row(j), w.data());
+            ++matvecs;
+            orthogonalize(V, j + 1, w.data(), h.data(), correction.data());
+            T(j, j) = h[j];
+            beta = kernels::norm2(n, w.data(), 1);
+            scale = std::max(scale, std::abs(h[j]) + beta);
+            if (beta <= LANCZOS_BREAKDOWN * scale) {
+                // Baza jest niezmiennicza: dalsze wektory spoza niej, bez sprzężenia z dotychczasowymi
+                beta = 0.0;
+                if (j + 1 == n) {
+                    std::fill(V.row(j + 1), V.row(j + 1) + n, 0.0);
+                    continue;
+                }
+                random_unit_vector(gen, w.data(), n);
+                orthogonalize(V, j + 1, w.data(), h.data(), correction.data());
+                const double norm = kernels::norm2(n, w.data(), 1);
+                for (int i = 0; i < n; ++i) {
+                    V(j + 1, i) = w[i] / norm;
+                }
+            }
+            else {
+                for (int i = 0; i < n; ++i) {
+                    V(j + 1, i) = w[i] / beta;
+                }
+            }
+            if (j + 1 < m) {
+                T(j + 1, j) = T(j, j + 1) = beta;
+            }
+        }
+
+        // Wartości Ritza; residuum pary i to |beta * S(m - 1, i)|
+        EigenPairs ritz = symmetric_eigen(T);
+        const Vector& theta = ritz.values;
+        const DenseMatrix& S = ritz.vectors;
+        const double norm_estimate = std::max(std::abs(theta[0]), std::abs(theta[m - 1]));
+        auto ritz_index = [&](int k) { return target == EigenTarget::Largest ? m - 1 - k : k; };
+        bool converged = true;
+        for (int k = 0; k < count; ++k) {
+            if (std::abs(beta * S(m - 1, ritz_index(k))) > tolerance * norm_estimate) {
+                converged = false;
+                break;
+            }
+        }
+
+        // Zachowywane wektory Ritza: szukane oraz następne w tym samym kierunku widma
+        const int keep = converged ? count : std::min(m - 1, count + (m - count) / 2);
+        if (!converged && matvecs >= max_iterations) {
+            throw std::runtime_error("Lanczos iteration did not converge within the maximum number of iterations.");
+        }
+        DenseMatrix Sk(m, keep);
+        for (int i = 0; i < m; ++i) {
+            for (int k = 0; k < keep; ++k) {
+                Sk(i, k) = S(i, ritz_index(k));
+            }
+        }
+        DenseMatrix Y(keep, n);
+        gemm(Transpose::Yes, Transpose::No, 1.0, Sk.view(), V.block(0, 0, m, n), 0.0, Y.view());
+
+        if (converged) {
+            EigenPairs result;
+            result.values.resize(count);
+            result.vectors = DenseMatrix(n, count);
+            for (int k = 0; k < count; ++k) {
+                result.values[k] = theta[ritz_index(k)];
+                for (int i = 0; i < n; ++i) {
+                    result.vectors(i, k) = Y(k, i);
+                }
+            }
+            result.iterations = matvecs;
+            return result;
+        }
+
+        // Gruby restart: T przyjmuje postać strzałki diag(theta) z ostatnim wierszem beta * S(m - 1, :)
+        for (int k = 0; k < keep; ++k) {
+            std::copy(Y.row(k), Y.row(k) + n, V.row(k));
+        }
+        std::copy(V.row(m), V.row(m) + n, V.row(keep));
+        T = DenseMatrix(m, m);
+        for (int k = 0; k < keep; ++k) {
+            T(k, k) = theta[ritz_index(k)];
+            T(keep, k) = T(k, keep) = beta * Sk(m - 1, k);
+        }
+        j = keep;
+    }
+}
+
+// --- Metoda potęgowa ---
+
+EigenPairs power_iteration(const LinearOperator& A, double tolerance, int max_iterations) {
+    const int n = A.size();
+    if (n == 0) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    if (tolerance <= 0.0) {
+        throw std::invalid_argument("Tolerance must be positive.");
+    }
+    if (max_iterations <= 0) {
+        throw std::invalid_argument("Maximum iterations must be positive.");
+    }
+
+    std::mt19937 gen(12345);
+    Vector x(n), y(n);
+    random_unit_vector(gen, x.data(), n);
+    for (int iteration = 1; iteration <= max_iterations; ++iteration) {
+        A.apply(x.data(), y.data());
+        // Iloraz Rayleigha i residuum ||Ax - lambda x|| dla wektora jednostkowego x
+        double lambda = 0.0;
+        for (int i = 0; i < n; ++i) {
+            lambda += x[i] * y[i];
+        }
+        double residual = 0.0;
+        for (int i = 0; i < n; ++i) {
+            residual += (y[i] - lambda * x[i]) * (y[i] - lambda * x[i]);
+        }
+        if (std::sqrt(residual) <= tolerance * std::abs(lambda)) {
+            EigenPairs result;
+            result.values = { lambda };
+            result.vectors = DenseMatrix(n, 1);
+            for (int i = 0; i < n; ++i) {
+                result.vectors(i, 0) = x[i];
+            }
+            result.iterations = iteration;
+            return result;
+        }
+        const double norm = kernels::norm2(n, y.data(), 1);
+        if (norm == 0.0) {
+            throw std::runtime_error("Power iteration breakdown: operator maps the iterate to zero.");
+        }
+        for (int i = 0; i < n; ++i) {
+            x[i] = y[i] / norm;
+        }
+    }
+    throw std::runtime_error("Power iteration did not converge within the maximum number of iterations.");
+}
\ No newline at end of file
@@ -1,100 +1,691 @@
 #include "integration.h"
+#include "thread_pool.h"
 #include <stdexcept>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
 
 // Implementacje są w większości przeniesione z Twojego kodu.
 
 double rectangle_rule(std::function<double(double)> func, double a, double b, int intervals) {
-    if (intervals <= 0) throw std::invalid_argument("Number of intervals must be positive.");
-    double h = (b - a) / intervals;
-    double sum = 0.0;
-    for (int i = 0; i < intervals; ++i) {
-        double x = a + i * h;
-        sum += func(x);
-    }
-    return sum * h;
+    return integration_detail::rectangle(func, a, b, intervals);
 }
 
 double trapezoid_rule(std::function<double(double)> func, double a, double b, int intervals) {
-    if (intervals <= 0) throw std::invalid_argument("Number of intervals must be positive.");
-    double h = (b - a) / intervals;
-    double sum = 0.5 * (func(a) + func(b));
-    for (int i = 1; i < intervals; ++i) {
-        double x = a + i * h;
-        sum += func(x);
-    }
-    return sum * h;
+    return integration_detail::trapezoid(func, a, b, intervals);
 }
 
 double simpson_rule(std::function<double(double)> func, double a, double b, int intervals) {
-    if (intervals <= 0) throw std::invalid_argument("Number of intervals must be positive.");
-    if (intervals % 2 != 0) ++intervals; // Simpson's rule requires an even number of intervals
-    double h = (b - a) / intervals;
-    double sum = func(a) + func(b);
-    for (int i = 1; i < intervals; ++i) {
-        double x = a + i * h;
-        sum += (i % 2 == 0 ? 2.0 : 4.0) * func(x);
-    }
-    return (h / 3.0) * sum;
+    return integration_detail::simpson(func, a, b, intervals);
+}
+
+double rectangle_rule(std::function<double(double)> func, double a, double b, int intervals, int threads) {
+    return integration_detail::rectangle(func, a, b, intervals, threads);
+}
+
+double trapezoid_rule(std::function<double(double)> func, double a, double b, int intervals, int threads) {
+    return integration_detail::trapezoid(func, a, b, intervals, threads);
+}
+
+double simpson_rule(std::function<double(double)> func, double a, double b, int intervals, int threads) {
+    return integration_detail::simpson(func, a, b, intervals, threads);
 }
 
 
 // --- Gauss-Legendre Quadrature Implementation ---
-// Helper struct and function, not exposed in the header
 namespace {
-    struct GaussNodes {
-        std::vector<double> nodes;
-        std::vector<double> weights;
+    // Rząd n: pierwiastki P_n metodą Newtona, przybliżenie początkowe z asymptotyki Tricomiego
+    GaussRule compute_gauss_legendre(int n) {
+        GaussRule rule;
+        rule.nodes.resize(n);
+        rule.weights.resize(n);
+        const double pi = 3.14159265358979323846;
+        for (int i = 0; i < (n + 1) / 2; ++i) {
+            double z = std::cos(pi * (i + 0.75) / (n + 0.5));
+            double derivative = 0.0;
+            for (int iteration = 0; iteration < 100; ++iteration) {
+                // P_n(z) i P_n'(z) z rekurencji (j + 1) P_{j+1} = (2j + 1) z P_j - j P_{j-1}
+                double p0 = 1.0, p1 = 0.0;
+                for (int j = 1; j <= n; ++j) {
+                    const double p2 = p1;
+                    p1 = p0;
+                    p0 = ((2.0 * j - 1.0) * z * p1 - (j - 1.0) * p2) / j;
+                }
+                derivative = n * (z * p0 - p1) / (z * z - 1.0);
+                const double step = p0 / derivative;
+                z -= step;
+                if (std::abs(step) <= 1e-15) {
+                    break;
+                }
+            }
+            rule.nodes[i] = -z;
+            rule.nodes[n - 1 - i] = z;
+            rule.weights[i] = rule.weights[n - 1 - i] = 2.0 / ((1.0 - z * z) * derivative * derivative);
+        }
+        if (n % 2 == 1) {
+            rule.nodes[n / 2] = 0.0;
+        }
+        return rule;
+    }
+
+    // Reguła Gaussa z rekurencji wielomianów ortonormalnych x p_k = b_{k+1} p_{k+1} + a_k p_k + b_k p_{k-1}
+    // (a[0..n), b[1..n]; mu0 to całka wagi). Węzły to wartości własne macierzy Jacobiego: każdy jest najpierw
+    // izolowany bisekcją z ciągiem Sturma (liczba wartości własnych mniejszych od x), a potem dokładany
+    // metodą Newtona w wyznaczonym przedziale, więc dobór przybliżeń początkowych nie może zawieść.
+    // Wagi 1 / sum p_k(x)^2 (Christoffel). Wartości p_k są w trakcie rekurencji przeskalowywane,
+    // bo dla dużych n przekraczają zakres double; wagi mniejsze od najmniejszej liczby double dają 0.
+    GaussRule gauss_rule_from_recurrence(const std::vector<double>& a, const std::vector<double>& b, double mu0) {
+        const int n = static_cast<int>(a.size());
+        constexpr double BIG = 1e100;
+        constexpr double TINY = 1e-300;
+
+        // Liczba wartości własnych mniejszych od x (ujemne elementy D w rozkładzie T - xI = L D L^T)
+        const auto count_below = [&](double x) {
+            int count = 0;
+            double q = 1.0;
+            for (int k = 0; k < n; ++k) {
+                q = (a[k] - x) - (k > 0 ? b[k] * b[k] / q : 0.0);
+                if (std::abs(q) < TINY) q = -TINY;
+                if (q < 0.0) ++count;
+            }
+            return count;
+        };
+
+        // p_n(x) i p_n'(x) (ze wspólnym czynnikiem skali) oraz log2 przeskalowania sumy sum p_k^2, k < n
+        struct Evaluation {
+            double value, derivative, squares;
+            int exponent;
+        };
+        const auto evaluate = [&](double x) {
+            Evaluation e{ 0.0, 0.0, 0.0, 0 };
+            double p = 1.0, p_prev = 0.0, dp = 0.0, dp_prev = 0.0;
+            for (int k = 0; k < n; ++k) {
+                e.squares += p * p;
+                const double p_next = ((x - a[k]) * p - b[k] * p_prev) / b[k + 1];
+                const double dp_next = ((x - a[k]) * dp + p - b[k] * dp_prev) / b[k + 1];
+                p_prev = p;
+                p = p_next;
+                dp_prev = dp;
+                dp = dp_next;
+                if (std::abs(p) > BIG || std::abs(dp) > BIG) {
+                    p /= BIG;
+                    p_prev /= BIG;
+                    dp /= BIG;
+                    dp_prev /= BIG;
+                    e.squares /= BIG * BIG;
+                    ++e.exponent;
+                }
+            }
+            e.value = p;
+            e.derivative = dp;
+            return e;
+        };
+
+        // Przedział zawierający wszystkie wartości własne (twierdzenie Gerszgorina)
+        double lower = a[0], upper = a[0];
+        for (int k = 0; k < n; ++k) {
+            const double radius = (k > 0 ? b[k] : 0.0) + (k + 1 < n ? b[k + 1] : 0.0);
+            lower = std::min(lower, a[k] - radius);
+            upper = std::max(upper, a[k] + radius);
+        }
+        const double resolution = 1e-14 * (upper - lower);
+
+        GaussRule rule;
+        rule.nodes.resize(n);
+        rule.weights.resize(n);
+        for (int i = 0; i < n; ++i) {
+            double lo = i > 0 ? rule.nodes[i - 1] : lower;
+            double hi = upper;
+            while (hi - lo > std::max(1e-10 * std::max(std::abs(lo), std::abs(hi)), resolution)) {
+                const double mid = 0.5 * (lo + hi);
+                if (count_below(mid) > i) hi = mid;
+                else lo = mid;
+            }
+            double x = 0.5 * (lo + hi);
+            Evaluation e = evaluate(x);
+            for (int iteration = 0; iteration < 20 && e.derivative != 0.0; ++iteration) {
+                const double next = x - e.value / e.derivative;
+                if (!(next >= lo && next <= hi) || next == x) {
+                    break;
+                }
+                const bool converged = std::abs(next - x) <= 1e-15 * std::abs(next);
+                x = next;
+                e = evaluate(x);
+                if (converged) {
+                    break;
+                }
+            }
+            rule.nodes[i] = x;
+            double weight = mu0 / e.squares;
+            for (int k = 0; k < e.exponent && weight != 0.0; ++k) {
+                weight /= BIG * BIG;
+            }
+            rule.weights[i] = weight;
+        }
+        return rule;
+    }
+
+    // Rząd n: waga e^{-x} na [0, inf), L_k ortonormalne: a_k = 2k + 1, b_k = k
+    GaussRule compute_gauss_laguerre(int n) {
+        std::vector<double> a(n), b(n + 1);
+        for (int k = 0; k < n; ++k) a[k] = 2.0 * k + 1.0;
+        for (int k = 1; k <= n; ++k) b[k] = k;
+        return gauss_rule_from_recurrence(a, b, 1.0);
+    }
+
+    // Rząd n: waga e^{-x^2} na R, a_k = 0, b_k = sqrt(k / 2); węzły i wagi symetryzowane względem zera
+    GaussRule compute_gauss_hermite(int n) {
+        std::vector<double> a(n, 0.0), b(n + 1);
+        for (int k = 1; k <= n; ++k) b[k] = std::sqrt(0.5 * k);
+        GaussRule rule = gauss_rule_from_recurrence(a, b, std::sqrt(3.14159265358979323846));
+        for (int i = 0; i < n / 2; ++i) {
+            const double z = 0.5 * (rule.nodes[n - 1 - i] - rule.nodes[i]);
+            const double w = 0.5 * (rule.weights[n - 1 - i] + rule.weights[i]);
+            rule.nodes[i] = -z;
+            rule.nodes[n - 1 - i] = z;
+            rule.weights[i] = rule.weights[n - 1 - i] = w;
+        }
+        if (n % 2 == 1) {
+            rule.nodes[n / 2] = 0.0;
+        }
+        return rule;
+    }
+
+    /// Pamięć podręczna reguł jednej rodziny; reguły nie są nigdy usuwane, więc referencje pozostają ważne.
+    struct RuleCache {
+        std::shared_mutex mutex;
+        std::map<int, std::unique_ptr<const GaussRule>> rules;
     };
 
-    GaussNodes get_gauss_legendre_nodes(int n) {
-        GaussNodes data;
-        if (n == 2) {
-            data.nodes = { -1.0 / sqrt(3.0), 1.0 / sqrt(3.0) };
-            data.weights = { 1.0, 1.0 };
-        } else if (n == 3) {
-            data.nodes = { -sqrt(3.0 / 5.0), 0.0, sqrt(3.0 / 5.0) };
-            data.weights = { 5.0 / 9.0, 8.0 / 9.0, 5.0 / 9.0 };
-        } else if (n == 4) {
-            data.nodes = {
-                -sqrt((3.0 + 2.0 * sqrt(6.0 / 5.0)) / 7.0),
-                -sqrt((3.0 - 2.0 * sqrt(6.0 / 5.0)) / 7.0),
-                sqrt((3.0 - 2.0 * sqrt(6.0 / 5.0)) / 7.0),
-                sqrt((3.0 + 2.0 * sqrt(6.0 / 5.0)) / 7.0)
-            };
-            data.weights = {
-                (18.0 - sqrt(30.0)) / 36.0,
-                (18.0 + sqrt(30.0)) / 36.0,
-                (18.0 + sqrt(30.0)) / 36.0,
-                (18.0 - sqrt(30.0)) / 36.0
-            };
-        } else {
-            throw std::invalid_argument("Gauss-Legendre quadrature is only supported for 2, 3, or 4 nodes.");
+    const GaussRule& cached_rule(RuleCache& cache, int n, GaussRule (*compute)(int), const char* message) {
+        if (n < 1) {
+            throw std::invalid_argument(message);
+        }
+        {
+            std::shared_lock<std::shared_mutex> lock(cache.mutex);
+            auto it = cache.rules.find(n);
+            if (it != cache.rules.end()) {
+                return *it->second;
+            }
         }
-        return data;
+        auto rule = std::make_unique<const GaussRule>(compute(n));
+        std::unique_lock<std::shared_mutex> lock(cache.mutex);
+        auto inserted = cache.rules.emplace(n, std::move(rule));
+        return *inserted.first->second;
     }
 } // anonymous namespace
 
+const GaussRule& gauss_legendre_rule(int n) {
+    static RuleCache cache;
+    return cached_rule(cache, n, compute_gauss_legendre, "Gauss-Legendre quadrature requires a positive number of nodes.");
+}
+
+const GaussRule& gauss_laguerre_rule(int n) {
+    static RuleCache cache;
+    return cached_rule(cache, n, compute_gauss_laguerre, "Gauss-Laguerre quadrature requires a positive number of nodes.");
+}
+
+const GaussRule& gauss_hermite_rule(int n) {
+    static RuleCache cache;
+    return cached_rule(cache, n, compute_gauss_hermite, "Gauss-Hermite quadrature requires a positive number of nodes.");
+}
+
+double gauss_laguerre_quadrature(std::function<double(double)> func, int nodes, double a, double scale) {
+    return integration_detail::gauss_laguerre(func, nodes, a, scale);
+}
+
+double gauss_hermite_quadrature(std::function<double(double)> func, int nodes, double center, double scale) {
+    return integration_detail::gauss_hermite(func, nodes, center, scale);
+}
+
+namespace integration_detail {
+    void check_intervals(int intervals, const char* message) {
+        if (intervals <= 0) throw std::invalid_argument(message);
+    }
+
+    namespace {
+        // Pula wątku wywołującego, używana ponownie przez kolejne wywołania run_chunks (np. przez
+        // wszystkie repliki quasi-Monte Carlo), by nie tworzyć i nie kończyć wątków przy każdej kwadraturze.
+        // Każdy wątek wywołujący ma własną pulę, więc równoległe wywołania z różnych wątków się nie mieszają.
+        thread_local std::unique_ptr<ThreadPool> cached_pool;
+
+        // true w wątku, który właśnie wykonuje porcje run_chunks
+        thread_local bool inside_chunks = false;
+    }
+
+    void run_chunks(int chunks, int threads, const std::function<void(int)>& body) {
+        const int workers = std::min(ThreadPool::resolve_thread_count(threads), chunks);
+        // Wywołanie zagnieżdżone (funkcja podcałkowa sama całkuje wielowątkowo) liczone jest sekwencyjnie:
+        // zewnętrzne wywołanie zajmuje już wątki, a czekanie na tej samej puli by się zakleszczyło
+        if (workers <= 1 || inside_chunks) {
+            for (int c = 0; c < chunks; ++c) {
+                body(c);
+            }
+            return;
+        }
+        if (!cached_pool || cached_pool->size() < workers) {
+            cached_pool.reset();
+            cached_pool = std::make_unique<ThreadPool>(workers);
+        }
+        // Każdy wątek pobiera kolejne porcje, więc nierówny koszt funkcji nie blokuje pozostałych
+        std::atomic<int> next{ 0 };
+        cached_pool->parallel_for(workers, [&](int) {
+            struct Scope {
+                Scope() { inside_chunks = true; }
+                ~Scope() { inside_chunks = false; }
+            } scope;
+            for (int c = next.fetch_add(1); c < chunks; c = next.fetch_add(1)) {
+                body(c);
+            }
+        });
+    }
+
+    namespace {
+        // Dodatnie węzły i wagi (QUADPACK qk15/qk21); Gauss używa co drugiego węzła Kronroda
+        constexpr double K15_X[8] = {
+            0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+            0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+            0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+            0.207784955007898467600689403773245, 0.0
+        };
+        constexpr double K15_W[8] = {
+            0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+            0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+            0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+            0.204432940075298892414161999234649, 0.209482141084727828012999174891714
+        };
+        constexpr double G7_W[4] = {
+            0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+            0.381830050505118944950369775488975, 0.417959183673469387755102040816327
+        };
+        constexpr double K21_X[11] = {
+            0.995657163025808080735527280689003, 0.973906528517171720077964012084452,
+            0.930157491355708226001207180059508, 0.865063366688984510732096688423493,
+            0.780817726586416897063717578345042, 0.679409568299024406234327365114874,
+            0.562757134668604683339000099272694, 0.433395394129247190799265943165784,
+            0.294392862701460198131126603103866, 0.148874338981631210884826001129720, 0.0
+        };
+        constexpr double K21_W[11] = {
+            0.011694638867371874278064396062192, 0.032558162307964727478818972459390,
+            0.054755896574351996031381300244580, 0.075039674810919952767043140916190,
+            0.093125454583697605535065465083366, 0.109387158802297641899210590325805,
+            0.123491976262065851077208507413042, 0.134709217311473325928054001771707,
+            0.142775938577060080797094273138717, 0.147739104901338491374841515972068,
+            0.149445554002916905664936468389821
+        };
+        constexpr double G10_W[5] = {
+            0.066671344308688137593568809893332, 0.149451349150580593145776339657697,
+            0.219086362515982043995534934228163, 0.269266719309996355091226921569469,
+            0.295524224714752870173892994651338
+        };
+
+        // Pełna (symetryczna) reguła na [-1, 1] z połówkowych tablic
+        struct FullKronrod {
+            std::vector<double> nodes, kronrod_weights, gauss_weights;
+            KronrodNodes view;
+
+            FullKronrod(int half, const double* x, const double* wk, const double* wg) {
+                const int n = 2 * half - 1;
+                nodes.resize(n);
+                kronrod_weights.resize(n);
+                gauss_weights.assign(n, 0.0);
+                for (int k = 0; k < half; ++k) {
+                    nodes[k] = -x[k];
+                    nodes[n - 1 - k] = x[k];
+                    kronrod_weights[k] = kronrod_weights[n - 1 - k] = wk[k];
+                    if (k % 2 == 1) {
+                        gauss_weights[k] = gauss_weights[n - 1 - k] = wg[k / 2];
+                    }
+                }
+                view = { n, nodes.data(), kronrod_weights.data(), gauss_weights.data() };
+            }
+        };
+    } // anonymous namespace
+
+    const KronrodNodes& kronrod_nodes(KronrodRule rule) {
+        static const FullKronrod gk15(8, K15_X, K15_W, G7_W);
+        static const FullKronrod gk21(11, K21_X, K21_W, G10_W);
+        return rule == KronrodRule::GK15 ? gk15.view : gk21.view;
+    }
+
+    namespace {
+        constexpr double DE_T_MAX = 6.5; // dalej exp(pi/2 sinh t) przekracza zakres double
+
+        DeNode de_node(DeTransform transform, double t) {
+            const double pi_half = 1.5707963267948966;
+            const double s = pi_half * std::sinh(t);
+            const double c = pi_half * std::cosh(t);
+            DeNode node{ t, 0.0, 0.0, 0.0, 0.0 };
+            switch (transform) {
+            case DeTransform::Finite: {
+                // 1 - tanh(s) i sech^2(s) przez e^(-2s): bez utraty cyfr i nadmiaru dla dużych s
+                const double e = std::exp(-2.0 * s);
+                node.right_offset = node.left_offset = 2.0 * e / (1.0 + e);
+                node.right_weight = node.left_weight = c * 4.0 * e / ((1.0 + e) * (1.0 + e));
+                break;
+            }
+            case DeTransform::HalfInfinite:
+                node.right_offset = std::exp(s);
+                node.right_weight = c * node.right_offset;
+                node.left_offset = std::exp(-s);
+                node.left_weight = c * node.left_offset;
+                break;
+            case DeTransform::Infinite:
+                node.right_offset = node.left_offset = std::sinh(s);
+                node.right_weight = node.left_weight = c * std::cosh(s);
+                break;
+            }
+            return node;
+        }
+
+        DeTable build_de_table(DeTransform transform) {
+            DeTable table;
+            table.levels.resize(DE_MAX_LEVEL + 1);
+            for (int j = 0; j <= static_cast<int>(DE_T_MAX); ++j) {
+                table.levels[0].push_back(de_node(transform, j));
+            }
+            for (int level = 1; level <= DE_MAX_LEVEL; ++level) {
+                const double h = std::ldexp(1.0, -level);
+                for (int i = 1; i * h <= DE_T_MAX; i += 2) {
+                    table.levels[level].push_back(de_node(transform, i * h));
+                }
+            }
+            // Zasięg każdej strony: pierwszy węzeł, którego odległość od końca lub waga wychodzi poza zakres
+            // double (wyraz byłby pomijalny dla każdej rozsądnej funkcji, a punkt mógłby trafić w koniec)
+            const auto outside_range = [](double offset, double weight) {
+                return !(offset > 0.0 && std::isfinite(offset) && weight >= std::numeric_limits<double>::min() &&
+                         std::isfinite(weight));
+            };
+            table.right_limit = table.left_limit = DE_T_MAX + 1.0;
+            for (const std::vector<DeNode>& nodes : table.levels) {
+                for (const DeNode& node : nodes) {
+                    if (node.t == 0.0) continue;
+                    if (outside_range(node.right_offset, node.right_weight)) {
+                        table.right_limit = std::min(table.right_limit, node.t);
+                    }
+                    if (outside_range(node.left_offset, node.left_weight)) {
+                        table.left_limit = std::min(table.left_limit, node.t);
+                    }
+                }
+            }
+            return table;
+        }
+    } // anonymous namespace
+
+    const DeTable& de_table(DeTransform transform) {
+        // Każda tablica budowana przy pierwszym użyciu (inicjalizacja statycznych zmiennych jest bezpieczna wątkowo)
+        switch (transform) {
+        case DeTransform::Finite: {
+            static const DeTable finite = build_de_table(DeTransform::Finite);
+            return finite;
+        }
+        case DeTransform::HalfInfinite: {
+            static const DeTable half_infinite = build_de_table(DeTransform::HalfInfinite);
+            return half_infinite;
+        }
+        default: {
+            static const DeTable infinite = build_de_table(DeTransform::Infinite);
+            return infinite;
+        }
+        }
+    }
+} // namespace integration_detail
+
 double gauss_legendre_quadrature(std::function<double(double)> func, double a, double b, int nodes, int subintervals) {
-    if (subintervals <= 0) throw std::invalid_argument("Number of subintervals must be positive.");
-    
-    GaussNodes gn = get_gauss_legendre_nodes(nodes);
-    double h = (b - a) / subintervals;
-    double result = 0.0;
+    return integration_detail::gauss_legendre(func, a, b, nodes, subintervals);
+}
 
-    for (int j = 0; j < subintervals; ++j) {
-        double interval_a = a + j * h;
-        double interval_b = interval_a + h;
-        double sum = 0.0;
+double gauss_legendre_quadrature(std::function<double(double)> func, double a, double b, int nodes, int subintervals,
+                                 int threads) {
+    return integration_detail::gauss_legendre(func, a, b, nodes, subintervals, threads);
+}
+
+QuadratureResult adaptive_gauss_kronrod(std::function<double(double)> func, double a, double b,
+                                        double abs_tolerance, double rel_tolerance,
+                                        KronrodRule rule, int max_subintervals) {
+    return integration_detail::adaptive_gauss_kronrod(func, a, b, abs_tolerance, rel_tolerance, rule, max_subintervals);
+}
+
+std::vector<double> trapezoid_rule_multi(VectorIntegrand func, int count, double a, double b, int intervals) {
+    return integration_detail::trapezoid_multi(func, count, a, b, intervals);
+}
+
+std::vector<double> simpson_rule_multi(VectorIntegrand func, int count, double a, double b, int intervals) {
+    return integration_detail::simpson_multi(func, count, a, b, intervals);
+}
 
-        for (int i = 0; i < nodes; ++i) {
-            double t_i = gn.nodes[i];
-            double w_i = gn.weights[i];
-            double x_i = ((interval_b - interval_a) / 2.0) * t_i + ((interval_a + interval_b) / 2.0);
-            sum += w_i * func(x_i);
+std::vector<double> gauss_legendre_quadrature_multi(VectorIntegrand func, int count, double a, double b,
+                                                    int nodes, int subintervals) {
+    return integration_detail::gauss_legendre_multi(func, count, a, b, nodes, subintervals);
+}
+
+namespace {
+    /// Zbiór funkcji skalarnych widziany jako jedna funkcja wektorowa.
+    struct FunctionSet {
+        const std::vector<std::function<double(double)>>& funcs;
+        void operator()(double x, double* fx) const {
+            for (std::size_t m = 0; m < funcs.size(); ++m) {
+                fx[m] = funcs[m](x);
+            }
+        }
+    };
+}
+
+std::vector<double> trapezoid_rule_multi(const std::vector<std::function<double(double)>>& funcs,
+                                         double a, double b, int intervals) {
+    FunctionSet set{ funcs };
+    return integration_detail::trapezoid_multi(set, static_cast<int>(funcs.size()), a, b, intervals);
+}
+
+std::vector<double> simpson_rule_multi(const std::vector<std::function<double(double)>>& funcs,
+                                       double a, double b, int intervals) {
+    FunctionSet set{ funcs };
+    return integration_detail::simpson_multi(set, static_cast<int>(funcs.size()), a, b, intervals);
+}
+
+std::vector<double> gauss_legendre_quadrature_multi(const std::vector<std::function<double(double)>>& funcs,
+                                                    double a, double b, int nodes, int subintervals) {
+    FunctionSet set{ funcs };
+    return integration_detail::gauss_legendre_multi(set, static_cast<int>(funcs.size()), a, b, nodes, subintervals);
+}
+
+QuadratureResult tanh_sinh_quadrature(std::function<double(double)> func, double a, double b,
+                                      double abs_tolerance, double rel_tolerance) {
+    return integration_detail::tanh_sinh(func, a, b, abs_tolerance, rel_tolerance);
+}
+
+QuadratureResult tanh_sinh_quadrature_complement(std::function<double(double, double)> func, double a, double b,
+                                                 double abs_tolerance, double rel_tolerance) {
+    return integration_detail::tanh_sinh_complement(func, a, b, abs_tolerance, rel_tolerance);
+}
+
+QuadratureResult romberg_integration(std::function<double(double)> func, double a, double b,
+                                     double abs_tolerance, double rel_tolerance, int max_levels) {
+    return integration_detail::romberg(func, a, b, abs_tolerance, rel_tolerance, max_levels);
+}
+
+IncrementalTrapezoid::IncrementalTrapezoid(std::function<double(double)> func, double a, double b, int intervals)
+    : func_(std::move(func)), a_(a), b_(b), intervals_(intervals), evaluations_(intervals + 1) {
+    romberg_row_.push_back(integration_detail::trapezoid(func_, a_, b_, intervals_));
+}
+
+double IncrementalTrapezoid::refine() {
+    if (intervals_ > std::numeric_limits<int>::max() / 2) {
+        throw std::runtime_error("Number of intervals exceeds the supported range.");
+    }
+    // T(h / 2) = (T(h) + h * suma f w środkach) / 2
+    const double h = (b_ - a_) / intervals_;
+    const double trapezoid = 0.5 * (value() + h * integration_detail::midpoint_sum(func_, a_, h, intervals_));
+    evaluations_ += intervals_;
+    intervals_ *= 2;
+    const double previous = extrapolated();
+    integration_detail::romberg_row(romberg_row_, trapezoid);
+    error_estimate_ = std::abs(extrapolated() - previous);
+    return trapezoid;
+}
+
+// --- Dane tablicowe ---
+
+namespace {
+    void check_samples(int n, int minimum) {
+        if (n < minimum) {
+            throw std::invalid_argument(minimum == 1 ? "At least one sample is required." : "At least two samples are required.");
         }
-        result += ((interval_b - interval_a) / 2.0) * sum;
     }
 
+    void check_spacing(double dx) {
+        if (!(dx > 0.0)) throw std::invalid_argument("Sample spacing must be positive.");
+    }
+
+    void check_increasing(double previous, double next) {
+        if (!(next > previous)) throw std::invalid_argument("Sample abscissae must be strictly increasing.");
+    }
+
+    /// Całka paraboli przez (x0, y0), (x1, y1), (x2, y2) po [x0, x2]; h0 = x1 - x0, h1 = x2 - x1.
+    double simpson_pair(double h0, double h1, double y0, double y1, double y2) {
+        const double h = h0 + h1;
+        return h / 6.0 * ((2.0 - h1 / h0) * y0 + h * h / (h0 * h1) * y1 + (2.0 - h0 / h1) * y2);
+    }
+
+    /// Całka tej samej paraboli tylko po ostatnim przedziale [x1, x2].
+    double simpson_last(double h0, double h1, double y0, double y1, double y2) {
+        const double h = h0 + h1;
+        return (2.0 * h1 * h1 + 3.0 * h0 * h1) / (6.0 * h) * y2 + (h1 * h1 + 3.0 * h0 * h1) / (6.0 * h0) * y1
+            - h1 * h1 * h1 / (6.0 * h0 * h) * y0;
+    }
+}
+
+double trapezoid_samples(const double* y, int n, double dx) {
+    check_samples(n, 2);
+    check_spacing(dx);
+    double sum = 0.0;
+    for (int i = 1; i < n - 1; ++i) {
+        sum += y[i];
+    }
+    return (0.5 * (y[0] + y[n - 1]) + sum) * dx;
+}
+
+double trapezoid_samples(const double* x, const double* y, int n) {
+    check_samples(n, 2);
+    double sum = 0.0;
+    for (int i = 1; i < n; ++i) {
+        check_increasing(x[i - 1], x[i]);
+        sum += (x[i] - x[i - 1]) * (y[i - 1] + y[i]);
+    }
+    return 0.5 * sum;
+}
+
+double simpson_samples(const double* y, int n, double dx) {
+    check_samples(n, 2);
+    check_spacing(dx);
+    if (n == 2) return 0.5 * dx * (y[0] + y[1]);
+    // Simpson po parzystej liczbie przedziałów, ewentualny ostatni przedział osobno
+    const int last = (n % 2 == 1) ? n - 1 : n - 2;
+    double odd = 0.0, even = 0.0;
+    for (int i = 1; i < last; i += 2) {
+        odd += y[i];
+    }
+    for (int i = 2; i < last; i += 2) {
+        even += y[i];
+    }
+    double result = dx / 3.0 * (y[0] + 4.0 * odd + 2.0 * even + y[last]);
+    if (last != n - 1) {
+        result += dx / 12.0 * (5.0 * y[n - 1] + 8.0 * y[n - 2] - y[n - 3]);
+    }
     return result;
+}
+
+double simpson_samples(const double* x, const double* y, int n) {
+    check_samples(n, 2);
+    for (int i = 1; i < n; ++i) {
+        check_increasing(x[i - 1], x[i]);
+    }
+    if (n == 2) return 0.5 * (x[1] - x[0]) * (y[0] + y[1]);
+    double result = 0.0;
+    int i = 0;
+    for (; i + 2 < n; i += 2) {
+        result += simpson_pair(x[i + 1] - x[i], x[i + 2] - x[i + 1], y[i], y[i + 1], y[i + 2]);
+    }
+    if (i != n - 1) {
+        result += simpson_last(x[n - 2] - x[n - 3], x[n - 1] - x[n - 2], y[n - 3], y[n - 2], y[n - 1]);
+    }
+    return result;
+}
+
+void cumulative_trapezoid(const double* y, int n, double dx, double* result) {
+    check_samples(n, 1);
+    check_spacing(dx);
+    double previous = y[0], sum = 0.0;
+    result[0] = 0.0;
+    for (int i = 1; i < n; ++i) {
+        const double current = y[i]; // y i result mogą być tą samą tablicą
+        sum += 0.5 * dx * (previous + current);
+        result[i] = sum;
+        previous = current;
+    }
+}
+
+void cumulative_trapezoid(const double* x, const double* y, int n, double* result) {
+    check_samples(n, 1);
+    double previous = y[0], sum = 0.0;
+    result[0] = 0.0;
+    for (int i = 1; i < n; ++i) {
+        check_increasing(x[i - 1], x[i]);
+        const double current = y[i];
+        sum += 0.5 * (x[i] - x[i - 1]) * (previous + current);
+        result[i] = sum;
+        previous = current;
+    }
+}
+
+SampleIntegrator::SampleIntegrator(double spacing) : spacing_(spacing) {
+    check_spacing(spacing);
+}
+
+SampleIntegrator::SampleIntegrator() : spacing_(0.0) {}
+
+void SampleIntegrator::push(double h, double y) {
+    h_[0] = h_[1]; h_[1] = h;
+    y_[0] = y_[1]; y_[1] = y_[2]; y_[2] = y;
+    ++samples_;
+    if (samples_ == 1) return;
+    trapezoid_ += 0.5 * h * (y_[1] + y_[2]);
+    // Parzysta liczba przedziałów: domknięta kolejna para dla metody Simpsona
+    if (samples_ % 2 == 1) {
+        simpson_even_ += simpson_pair(h_[0], h_[1], y_[0], y_[1], y_[2]);
+    }
+}
+
+void SampleIntegrator::append(const double* y, int count, double* cumulative) {
+    if (spacing_ == 0.0) {
+        throw std::invalid_argument("Integrator without a sample spacing requires sample abscissae.");
+    }
+    for (int i = 0; i < count; ++i) {
+        push(spacing_, y[i]);
+        if (cumulative) cumulative[i] = trapezoid_;
+    }
+}
+
+void SampleIntegrator::append(const double* x, const double* y, int count, double* cumulative) {
+    if (spacing_ != 0.0) {
+        throw std::invalid_argument("Integrator with a fixed sample spacing does not accept sample abscissae.");
+    }
+    for (int i = 0; i < count; ++i) {
+        if (samples_ > 0) check_increasing(last_x_, x[i]);
+        push(x[i] - last_x_, y[i]);
+        last_x_ = x[i];
+        if (cumulative) cumulative[i] = trapezoid_;
+    }
+}
+
+double SampleIntegrator::simpson() const {
+    if (samples_ < 3) return trapezoid_;
+    if (samples_ % 2 == 1) return simpson_even_;
+    return simpson_even_ + simpson_last(h_[0], h_[1], y_[0], y_[1], y_[2]);
 }
\ No newline at end of file
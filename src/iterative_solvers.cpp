@@ -0,0 +1,451 @@
+#include "iterative_solvers.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+// --- Pomocnicze operacje wektorowe ---
+
+namespace {
+    double dot(const Vector& x, const Vector& y) {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            sum += x[i] * y[i];
+        }
+        return sum;
+    }
+
+    double norm2(const Vector& x) {
+        return std::sqrt(dot(x, x));
+    }
+
+    // y += alpha * x
+    void axpy(double alpha, const Vector& x, Vector& y) {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            y[i] += alpha * x[i];
+        }
+    }
+
+    // z = M^{-1} r albo z = r, gdy brak preconditionera
+    void precondition(const Preconditioner* M, const Vector& r, Vector& z) {
+        if (M) {
+            M->apply(r.data(), z.data());
+        }
+        else {
+            z = r;
+        }
+    }
+
+    void validate_arguments(const LinearOperator& A, const Vector& b, double tolerance, int max_iterations) {
+        if (static_cast<int>(b.size()) != A.size()) {
+            throw std::invalid_argument("Invalid matrix or vector dimensions.");
+        }
+        if (tolerance <= 0.0) {
+            throw std::invalid_argument("Tolerance must be positive.");
+        }
+        if (max_iterations <= 0) {
+            throw std::invalid_argument("Maximum iterations must be positive.");
+        }
+    }
+
+    void record(std::vector<KrylovIteration>* history, int iteration, double residual, double b_norm) {
+        if (history) {
+            history->push_back({ iteration, residual, residual / b_norm });
+        }
+    }
+} // anonymous namespace
+
+// --- Preconditioner Jacobiego ---
+
+JacobiPreconditioner::JacobiPreconditioner(const Vector& diagonal) : inverse_diagonal_(diagonal.size()) {
+    for (std::size_t i = 0; i < diagonal.size(); ++i) {
+        if (diagonal[i] == 0.0) {
+            throw std::invalid_argument("Jacobi preconditioner requires a non-zero diagonal.");
+        }
+        inverse_diagonal_[i] = 1.0 / diagonal[i];
+    }
+}
+
+JacobiPreconditioner::JacobiPreconditioner(const SparseMatrix& A) : JacobiPreconditioner(LinearOperator(A)) {}
+
+JacobiPreconditioner::JacobiPreconditioner(const DenseMatrix& A) : JacobiPreconditioner(LinearOperator(A)) {}
+
+JacobiPreconditioner::JacobiPreconditioner(const LinearOperator& A) : JacobiPreconditioner(A.diagonal()) {
+    if (!A.has_diagonal() && A.size() > 0) {
+        throw std::invalid_argument("Jacobi preconditioner requires an operator with a known diagonal.");
+    }
+}
+
+void JacobiPreconditioner::apply(const double* r, double* z) const {
+    for (std::size_t i = 0; i < inverse_diagonal_.size(); ++i) {
+        z[i] = inverse_diagonal_[i] * r[i];
+    }
+}
+
+// --- ILU(0) ---
+
+Ilu0Preconditioner::Ilu0Preconditioner(const SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    const int n = A.rows();
+    const std::vector<int>& ptr = A.row_pointers();
+    const std::vector<int>& idx = A.col_indices();
+    std::vector<double> val = A.values();
+
+    diagonal_pos_.assign(n, -1);
+    for (int i = 0; i < n; ++i) {
+        auto first = idx.begin() + ptr[i];
+        auto last = idx.begin() + ptr[i + 1];
+        auto it = std::lower_bound(first, last, i);
+        if (it == last || *it != i) {
+            throw std::invalid_argument("ILU(0) requires every diagonal entry to be stored.");
+        }
+        diagonal_pos_[i] = static_cast<int>(it - idx.begin());
+    }
+
+    // Wariant IKJ eliminacji Gaussa ograniczony do struktury A
+    std::vector<int> position(n, -1); // position[j] = pozycja (i, j) w bieżącym wierszu
+    for (int i = 0; i < n; ++i) {
+        for (int p = ptr[i]; p < ptr[i + 1]; ++p) {
+            position[idx[p]] = p;
+        }
+        for (int p = ptr[i]; p < diagonal_pos_[i]; ++p) {
+            const int k = idx[p];
+            val[p] /= val[diagonal_pos_[k]];
+            const double lik = val[p];
+            for (int q = diagonal_pos_[k] + 1; q < ptr[k + 1]; ++q) {
+                const int pos = position[idx[q]];
+                if (pos >= 0) {
+                    val[pos] -= lik * val[q];
+                }
+            }
+        }
+        if (val[diagonal_pos_[i]] == 0.0) {
+            throw std::runtime_error("ILU(0) breakdown: zero pivot.");
+        }
+        for (int p = ptr[i]; p < ptr[i + 1]; ++p) {
+            position[idx[p]] = -1;
+        }
+    }
+    lu_ = SparseMatrix(n, n, ptr, idx, std::move(val));
+}
+
+void Ilu0Preconditioner::apply(const double* r, double* z) const {
+    const int n = lu_.rows();
+    const std::vector<int>& ptr = lu_.row_pointers();
+    const std::vector<int>& idx = lu_.col_indices();
+    const std::vector<double>& val = lu_.values();
+    // L y = r (jedynki na przekątnej)
+    for (int i = 0; i < n; ++i) {
+        double sum = r[i];
+        for (int p = ptr[i]; p < diagonal_pos_[i]; ++p) {
+            sum -= val[p] * z[idx[p]];
+        }
+        z[i] = sum;
+    }
+    // U z = y
+    for (int i = n - 1; i >= 0; --i) {
+        double sum = z[i];
+        for (int p = diagonal_pos_[i] + 1; p < ptr[i + 1]; ++p) {
+            sum -= val[p] * z[idx[p]];
+        }
+        z[i] = sum / val[diagonal_pos_[i]];
+    }
+}
+
+// --- IC(0) ---
+
+IncompleteCholeskyPreconditioner::IncompleteCholeskyPreconditioner(const SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    const int n = A.rows();
+    const std::vector<int>& a_ptr = A.row_pointers();
+    const std::vector<int>& a_idx = A.col_indices();
+    const std::vector<double>& a_val = A.values();
+
+    // Struktura dolnego trójkąta (z przekątną, która musi istnieć)
+    std::vector<int> ptr(n + 1, 0);
+    std::vector<int> idx;
+    std::vector<double> val;
+    for (int i = 0; i < n; ++i) {
+        for (int p = a_ptr[i]; p < a_ptr[i + 1] && a_idx[p] <= i; ++p) {
+            idx.push_back(a_idx[p]);
+            val.push_back(a_val[p]);
+        }
+        if (idx.size() == static_cast<std::size_t>(ptr[i]) || idx.back() != i) {
+            throw std::runtime_error("Incomplete Cholesky breakdown: matrix is not positive definite.");
+        }
+        ptr[i + 1] = static_cast<int>(idx.size());
+    }
+
+    // l_ij = (a_ij - sum_{k<j} l_ik l_jk) / l_jj,  l_ii = sqrt(a_ii - sum_{k<i} l_ik^2)
+    for (int i = 0; i < n; ++i) {
+        for (int p = ptr[i]; p < ptr[i + 1]; ++p) {
+            const int j = idx[p];
+            // Iloczyn skalarny wierszy i oraz j ograniczony do kolumn k < j (obie listy są posortowane)
+            double sum = 0.0;
+            int pi = ptr[i];
+            int pj = ptr[j];
+            while (pi < p && pj < ptr[j + 1] - 1) {
+                if (idx[pi] == idx[pj]) {
+                    sum += val[pi++] * val[pj++];
+                }
+                else if (idx[pi] < idx[pj]) {
+                    ++pi;
+                }
+                else {
+                    ++pj;
+                }
+            }
+            if (j < i) {
+                val[p] = (val[p] - sum) / val[ptr[j + 1] - 1];
+            }
+            else {
+                const double d = val[p] - sum;
+                if (!(d > 0.0)) {
+                    throw std::runtime_error("Incomplete Cholesky breakdown: matrix is not positive definite.");
+                }
+                val[p] = std::sqrt(d);
+            }
+        }
+    }
+    l_ = SparseMatrix(n, n, std::move(ptr), std::move(idx), std::move(val));
+}
+
+void IncompleteCholeskyPreconditioner::apply(const double* r, double* z) const {
+    const int n = l_.rows();
+    const std::vector<int>& ptr = l_.row_pointers();
+    const std::vector<int>& idx = l_.col_indices();
+    const std::vector<double>& val = l_.values();
+    // L y = r
+    for (int i = 0; i < n; ++i) {
+        double sum = r[i];
+        for (int p = ptr[i]; p < ptr[i + 1] - 1; ++p) {
+            sum -= val[p] * z[idx[p]];
+        }
+        z[i] = sum / val[ptr[i + 1] - 1];
+    }
+    // L^T z = y (kolumnowo, po wierszach L)
+    for (int i = n - 1; i >= 0; --i) {
+        z[i] /= val[ptr[i + 1] - 1];
+        const double zi = z[i];
+        for (int p = ptr[i]; p < ptr[i + 1] - 1; ++p) {
+            z[idx[p]] -= val[p] * zi;
+        }
+    }
+}
+
+// --- Metoda gradientów sprzężonych ---
+
+Vector conjugate_gradient(const LinearOperator& A, const Vector& b, const Preconditioner* M,
+                          double tolerance, int max_iterations, std::vector<KrylovIteration>* history) {
+    validate_arguments(A, b, tolerance, max_iterations);
+    const int n = A.size();
+    Vector x(n, 0.0);
+    const double b_norm = norm2(b);
+    if (b_norm == 0.0) {
+        return x;
+    }
+
+    Vector r = b;
+    Vector z(n), q(n);
+    precondition(M, r, z);
+    Vector p = z;
+    double rz = dot(r, z);
+
+    for (int k = 1; k <= max_iterations; ++k) {
+        A.apply(p.data(), q.data());
+        const double pq = dot(p, q);
+        if (!(pq > 0.0)) {
+            throw std::runtime_error("Conjugate gradient breakdown: operator is not positive definite.");
+        }
+        const double alpha = rz / pq;
+        axpy(alpha, p, x);
+        axpy(-alpha, q, r);
+
+        const double r_norm = norm2(r);
+        record(history, k, r_norm, b_norm);
+        if (r_norm <= tolerance * b_norm) {
+            return x;
+        }
+
+        precondition(M, r, z);
+        const double rz_next = dot(r, z);
+        const double beta = rz_next / rz;
+        rz = rz_next;
+        for (int i = 0; i < n; ++i) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+    throw std::runtime_error("Conjugate gradient did not converge within the maximum number of iterations.");
+}
+
+// --- BiCGSTAB ---
+
+Vector bicgstab(const LinearOperator& A, const Vector& b, const Preconditioner* M,
+                double tolerance, int max_iterations, std::vector<KrylovIteration>* history) {
+    validate_arguments(A, b, tolerance, max_iterations);
+    const int n = A.size();
+    Vector x(n, 0.0);
+    const double b_norm = norm2(b);
+    if (b_norm == 0.0) {
+        return x;
+    }
+
+    Vector r = b;
+    const Vector r_hat = r; // stały wektor "cienia"
+    Vector p(n, 0.0), v(n, 0.0), s(n), t(n), p_hat(n), s_hat(n);
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+
+    for (int k = 1; k <= max_iterations; ++k) {
+        const double rho_next = dot(r_hat, r);
+        if (rho_next == 0.0 || omega == 0.0) {
+            throw std::runtime_error("BiCGSTAB breakdown.");
+        }
+        const double beta = (rho_next / rho) * (alpha / omega);
+        rho = rho_next;
+        for (int i = 0; i < n; ++i) {
+            p[i] = r[i] + beta * (p[i] - omega * v[i]);
+        }
+        precondition(M, p, p_hat);
+        A.apply(p_hat.data(), v.data());
+        const double rv = dot(r_hat, v);
+        if (rv == 0.0) {
+            throw std::runtime_error("BiCGSTAB breakdown.");
+        }
+        alpha = rho / rv;
+        for (int i = 0; i < n; ++i) {
+            s[i] = r[i] - alpha * v[i];
+        }
+
+        // Wczesne zakończenie po połowie kroku
+        const double s_norm = norm2(s);
+        if (s_norm <= tolerance * b_norm) {
+            axpy(alpha, p_hat, x);
+            record(history, k, s_norm, b_norm);
+            return x;
+        }
+
+        precondition(M, s, s_hat);
+        A.apply(s_hat.data(), t.data());
+        const double tt = dot(t, t);
+        omega = tt > 0.0 ? dot(t, s) / tt : 0.0;
+        for (int i = 0; i < n; ++i) {
+            x[i] += alpha * p_hat[i] + omega * s_hat[i];
+            r[i] = s[i] - omega * t[i];
+        }
+
+        const double r_norm = norm2(r);
+        record(history, k, r_norm, b_norm);
+        if (r_norm <= tolerance * b_norm) {
+            return x;
+        }
+    }
+    throw std::runtime_error("BiCGSTAB did not converge within the maximum number of iterations.");
+}
+
+// --- GMRES(m) ---
+
+Vector gmres(const LinearOperator& A, const Vector& b, const Preconditioner* M,
+             int restart, double tolerance, int max_iterations, std::vector<KrylovIteration>* history) {
+    validate_arguments(A, b, tolerance, max_iterations);
+    if (restart <= 0) {
+        throw std::invalid_argument("GMRES restart length must be positive.");
+    }
+    const int n = A.size();
+    Vector x(n, 0.0);
+    const double b_norm = norm2(b);
+    if (b_norm == 0.0) {
+        return x;
+    }
+    const int m = std::min(restart, std::max(n, 1));
+
+    std::vector<Vector> V(m + 1, Vector(n));
+    std::vector<Vector> H(m + 1, Vector(m, 0.0)); // H[i][j], macierz Hessenberga (m+1) x m
+    Vector cs(m), sn(m), g(m + 1), y(m), w(n), z(n);
+    Vector r(n);
+
+    int iteration = 0;
+    while (iteration < max_iterations) {
+        // r = b - A x
+        A.apply(x.data(), r.data());
+        for (int i = 0; i < n; ++i) {
+            r[i] = b[i] - r[i];
+        }
+        double beta = norm2(r);
+        if (beta <= tolerance * b_norm) {
+            return x;
+        }
+        for (int i = 0; i < n; ++i) {
+            V[0][i] = r[i] / beta;
+        }
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        int j = 0;
+        bool converged = false;
+        for (; j < m && iteration < max_iterations; ++j) {
+            ++iteration;
+            // w = A M^{-1} v_j, ortogonalizacja względem v_0..v_j
+            precondition(M, V[j], z);
+            A.apply(z.data(), w.data());
+            for (int i = 0; i <= j; ++i) {
+                H[i][j] = dot(w, V[i]);
+                axpy(-H[i][j], V[i], w);
+            }
+            H[j + 1][j] = norm2(w);
+            if (H[j + 1][j] != 0.0) {
+                for (int i = 0; i < n; ++i) {
+                    V[j + 1][i] = w[i] / H[j + 1][j];
+                }
+            }
+
+            // Dotychczasowe rotacje Givensa i nowa rotacja zerująca H[j+1][j]
+            for (int i = 0; i < j; ++i) {
+                const double temp = cs[i] * H[i][j] + sn[i] * H[i + 1][j];
+                H[i + 1][j] = -sn[i] * H[i][j] + cs[i] * H[i + 1][j];
+                H[i][j] = temp;
+            }
+            const double denom = std::hypot(H[j][j], H[j + 1][j]);
+            if (denom == 0.0) {
+                throw std::runtime_error("GMRES breakdown: singular Hessenberg matrix.");
+            }
+            cs[j] = H[j][j] / denom;
+            sn[j] = H[j + 1][j] / denom;
+            H[j][j] = denom;
+            H[j + 1][j] = 0.0;
+            g[j + 1] = -sn[j] * g[j];
+            g[j] = cs[j] * g[j];
+
+            const double r_norm = std::abs(g[j + 1]);
+            record(history, iteration, r_norm, b_norm);
+            if (r_norm <= tolerance * b_norm) {
+                converged = true;
+                ++j;
+                break;
+            }
+        }
+
+        // y = H^{-1} g (układ trójkątny j x j), x += M^{-1} V y
+        for (int i = j - 1; i >= 0; --i) {
+            double sum = g[i];
+            for (int k = i + 1; k < j; ++k) {
+                sum -= H[i][k] * y[k];
+            }
+            y[i] = sum / H[i][i];
+        }
+        std::fill(w.begin(), w.end(), 0.0);
+        for (int i = 0; i < j; ++i) {
+            axpy(y[i], V[i], w);
+        }
+        precondition(M, w, z);
+        axpy(1.0, z, x);
+
+        if (converged) {
+            return x;
+        }
+    }
+    throw std::runtime_error("GMRES did not converge within the maximum number of iterations.");
+}
\ No newline at end of file
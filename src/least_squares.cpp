@@ -0,0 +1,355 @@
+#include "linear_algebra.h"
+#include "dense_kernels.h"
+#include <stdexcept>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+namespace {
+    // Szerokość panelu kolumn blokowego rozkładu QR (liczba odbić łączonych w Q = I - V T V^T)
+    constexpr int QR_BLOCK_SIZE = 32;
+
+    // Stosuje odbicie j (wektor w kolumnie j pod przekątną) do kolumn c0..c1-1 wierszy j..m-1.
+    // Obie pętle biegną wzdłuż wierszy, więc wewnętrzna pętla po kolumnach jest ciągła w pamięci.
+    void apply_reflector(DenseMatrix& A, int j, double tau, int c0, int c1, Vector& w) {
+        if (tau == 0.0 || c0 >= c1) {
+            return;
+        }
+        const int m = A.rows();
+        const int width = c1 - c0;
+        double* wp = w.data();
+        const double* top = A.row(j) + c0;
+        for (int c = 0; c < width; ++c) {
+            wp[c] = top[c];
+        }
+        for (int i = j + 1; i < m; ++i) {
+            const double v = A(i, j);
+            const double* row = A.row(i) + c0;
+            for (int c = 0; c < width; ++c) {
+                wp[c] += v * row[c];
+            }
+        }
+        for (int c = 0; c < width; ++c) {
+            wp[c] *= tau;
+        }
+        double* top_out = A.row(j) + c0;
+        for (int c = 0; c < width; ++c) {
+            top_out[c] -= wp[c];
+        }
+        for (int i = j + 1; i < m; ++i) {
+            const double v = A(i, j);
+            double* row = A.row(i) + c0;
+            for (int c = 0; c < width; ++c) {
+                row[c] -= v * wp[c];
+            }
+        }
+    }
+
+    // Rozkład blokowy: panel rozkładany odbiciami, reszta macierzy aktualizowana przez GEMM
+    void factor_blocked(DenseMatrix& A, Vector& tau) {
+        const int m = A.rows();
+        const int n = A.cols();
+        const int ld = A.stride();
+        Vector w(n);
+        std::vector<double, AlignedAllocator<double>> V, T, W;
+
+        for (int k0 = 0; k0 < n; k0 += QR_BLOCK_SIZE) {
+            const int nb = std::min(QR_BLOCK_SIZE, n - k0);
+            const int k1 = k0 + nb;
+            for (int j = k0; j < k1; ++j) {
+                tau[j] = kernels::householder(A(j, j), m - j - 1, j + 1 < m ? &A(j + 1, j) : nullptr, ld);
+                apply_reflector(A, j, tau[j], j + 1, k1, w);
+            }
+            const int n2 = n - k1;
+            if (n2 == 0) {
+                break;
+            }
+
+            // V (mr x nb) z jawnymi jedynkami na przekątnej i zerami nad nią
+            const int mr = m - k0;
+            V.assign(static_cast<std::size_t>(mr) * nb, 0.0);
+            for (int i = 0; i < mr; ++i) {
+                const double* src = A.row(k0 + i) + k0;
+                double* dst = V.data() + static_cast<std::size_t>(i) * nb;
+                const int last = std::min(i, nb);
+                for (int p = 0; p < last; ++p) {
+                    dst[p] = src[p];
+                }
+                if (i < nb) {
+                    dst[i] = 1.0;
+                }
+            }
+
+            // T górnotrójkątna (nb x nb) taka, że H_k0 ... H_{k1-1} = I - V T V^T (jak dlarft)
+            T.assign(static_cast<std::size_t>(nb) * nb, 0.0);
+            for (int p = 0; p < nb; ++p) {
+                const double tp = tau[k0 + p];
+                T[static_cast<std::size_t>(p) * nb + p] = tp;
+                if (p == 0 || tp == 0.0) {
+                    continue;
+                }
+                // z = V(:, 0:p)^T v_p, następnie T(0:p, p) = -tau_p T(0:p, 0:p) z
+                double* z = w.data();
+                std::fill(z, z + p, 0.0);
+                for (int i = p; i < mr; ++i) {
+                    const double* vrow = V.data() + static_cast<std::size_t>(i) * nb;
+                    const double vp = vrow[p];
+                    for (int q = 0; q < p; ++q) {
+                        z[q] += vrow[q] * vp;
+                    }
+                }
+                for (int q = 0; q < p; ++q) {
+                    double sum = 0.0;
+                    for (int r = q; r < p; ++r) {
+                        sum += T[static_cast<std::size_t>(q) * nb + r] * z[r];
+                    }
+                    T[static_cast<std::size_t>(q) * nb + p] = -tp * sum;
+                }
+            }
+
+            // A2 := (I - V T^T V^T) A2: W = V^T A2, W = T^T W, A2 -= V W
+            double* A2 = A.row(k0) + k1;
+            W.assign(static_cast<std::size_t>(nb) * n2, 0.0);
+            kernels::gemm_strided(nb, n2, mr, 1.0, V.data(), 1, nb, A2, ld, 1, W.data(), n2);
+            for (int i = nb - 1; i >= 0; --i) {
+                double* wi = W.data() + static_cast<std::size_t>(i) * n2;
+                const double tii = T[static_cast<std::size_t>(i) * nb + i];
+                for (int c = 0; c < n2; ++c) {
+                    wi[c] *= tii;
+                }
+                for (int p = 0; p < i; ++p) {
+                    const double tpi = T[static_cast<std::size_t>(p) * nb + i];
+                    const double* wp = W.data() + static_cast<std::size_t>(p) * n2;
+                    for (int c = 0; c < n2; ++c) {
+                        wi[c] += tpi * wp[c];
+                    }
+                }
+            }
+            kernels::gemm_strided(mr, n2, nb, -1.0, V.data(), nb, 1, W.data(), n2, 1, A2, ld);
+        }
+    }
+
+    // Rozkład z pivotowaniem kolumn (jak dgeqpf): normy pozostałych części kolumn są pomniejszane
+    // po każdym kroku i liczone od nowa, gdy utrata cyfr znaczących czyni aktualizację niewiarygodną.
+    void factor_pivoted(DenseMatrix& A, Vector& tau, std::vector<int>& perm) {
+        const int m = A.rows();
+        const int n = A.cols();
+        const int ld = A.stride();
+        const double tol3z = std::sqrt(std::numeric_limits<double>::epsilon());
+        Vector w(n), norms(n), norms_exact(n);
+        for (int c = 0; c < n; ++c) {
+            norms[c] = norms_exact[c] = kernels::norm2(m, &A(0, c), ld);
+        }
+
+        for (int j = 0; j < n; ++j) {
+            const int p = static_cast<int>(std::max_element(norms.begin() + j, norms.end()) - norms.begin());
+            if (p != j) {
+                for (int i = 0; i < m; ++i) {
+                    std::swap(A(i, j), A(i, p));
+                }
+                std::swap(perm[j], perm[p]);
+                norms[p] = norms[j];
+                norms_exact[p] = norms_exact[j];
+            }
+            tau[j] = kernels::householder(A(j, j), m - j - 1, j + 1 < m ? &A(j + 1, j) : nullptr, ld);
+            apply_reflector(A, j, tau[j], j + 1, n, w);
+
+            for (int c = j + 1; c < n; ++c) {
+                if (norms[c] == 0.0) {
+                    continue;
+                }
+                const double ratio = std::abs(A(j, c)) / norms[c];
+                const double temp = std::max(0.0, 1.0 - ratio * ratio);
+                const double scaled = norms[c] / norms_exact[c];
+                if (temp * scaled * scaled <= tol3z) {
+                    norms[c] = norms_exact[c] = (j + 1 < m) ? kernels::norm2(m - j - 1, &A(j + 1, c), ld) : 0.0;
+                } else {
+                    norms[c] *= std::sqrt(temp);
+                }
+            }
+        }
+    }
+} // anonymous namespace
+
+QrFactorization::QrFactorization(DenseMatrix A, bool column_pivoting)
+    : qr_(std::move(A)), rows_(qr_.rows()), pivoted_(column_pivoting) {
+    const int m = qr_.rows();
+    const int n = qr_.cols();
+    if (m == 0 || n == 0 || m < n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    tau_.assign(n, 0.0);
+    perm_.resize(n);
+    for (int j = 0; j < n; ++j) {
+        perm_[j] = j;
+    }
+    if (column_pivoting) {
+        factor_pivoted(qr_, tau_, perm_);
+    } else {
+        factor_blocked(qr_, tau_);
+    }
+}
+
+int QrFactorization::rank(double tolerance) const {
+    const int n = qr_.cols();
+    if (tolerance < 0.0) {
+        tolerance = std::max(rows_, n) * std::numeric_limits<double>::epsilon();
+    }
+    double largest = 0.0;
+    for (int k = 0; k < n; ++k) {
+        largest = std::max(largest, std::abs(qr_(k, k)));
+    }
+    int r = 0;
+    for (int k = 0; k < n; ++k) {
+        if (std::abs(qr_(k, k)) > tolerance * largest) {
+            ++r;
+        }
+    }
+    return r;
+}
+
+Vector QrFactorization::solve(const Vector& b, double* residual_norm) const {
+    if (static_cast<int>(b.size()) != rows_) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    const int m = qr_.rows();
+    const int n = qr_.cols();
+    const int r = rank();
+    if (!pivoted_ && r < n) {
+        throw std::runtime_error("Matrix is rank deficient, QR least squares failed.");
+    }
+
+    // c = Q^T b dla pierwotnych wierszy
+    Vector c(b.begin(), b.begin() + m);
+    for (int j = 0; j < n; ++j) {
+        if (tau_[j] == 0.0) {
+            continue;
+        }
+        double sum = c[j];
+        for (int i = j + 1; i < m; ++i) {
+            sum += qr_(i, j) * c[i];
+        }
+        sum *= tau_[j];
+        c[j] -= sum;
+        for (int i = j + 1; i < m; ++i) {
+            c[i] -= sum * qr_(i, j);
+        }
+    }
+    double residual_sq = 0.0;
+    for (int i = n; i < m; ++i) {
+        residual_sq += c[i] * c[i];
+    }
+
+    // Odbicia z kolejnych append_rows działają na [c(0:n); fragment b dopisanych wierszy]
+    int offset = m;
+    Vector d;
+    for (const AppendedBlock& block : appended_) {
+        const int k = block.rows.rows();
+        d.assign(b.begin() + offset, b.begin() + offset + k);
+        for (int j = 0; j < n; ++j) {
+            if (block.tau[j] == 0.0) {
+                continue;
+            }
+            double sum = c[j];
+            for (int i = 0; i < k; ++i) {
+                sum += block.rows(i, j) * d[i];
+            }
+            sum *= block.tau[j];
+            c[j] -= sum;
+            for (int i = 0; i < k; ++i) {
+                d[i] -= sum * block.rows(i, j);
+            }
+        }
+        for (int i = 0; i < k; ++i) {
+            residual_sq += d[i] * d[i];
+        }
+        offset += k;
+    }
+
+    // R(0:r, 0:r) y = c(0:r); składowe r..n-1 zerowe, więc c(r:n) należy do residuum
+    for (int k = r; k < n; ++k) {
+        residual_sq += c[k] * c[k];
+    }
+    kernels::trsv(false, false, r, qr_.data(), qr_.stride(), 1, c.data());
+    Vector x(n, 0.0);
+    for (int k = 0; k < r; ++k) {
+        x[perm_[k]] = c[k];
+    }
+    if (residual_norm != nullptr) {
+        *residual_norm = std::sqrt(residual_sq);
+    }
+    return x;
+}
+
+void QrFactorization::append_rows(const DenseMatrix& W) {
+    const int n = qr_.cols();
+    if (W.cols() != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    const int k = W.rows();
+    if (k == 0) {
+        return;
+    }
+
+    // Kolumny W w kolejności kolumn R
+    AppendedBlock block{ DenseMatrix(k, n), Vector(n, 0.0) };
+    DenseMatrix& V = block.rows;
+    for (int i = 0; i < k; ++i) {
+        for (int j = 0; j < n; ++j) {
+            V(i, j) = W(i, perm_[j]);
+        }
+    }
+
+    // Odbicie j zeruje kolumnę j bloku V względem R(j, j) i działa na wiersz j R oraz kolumny V w prawo
+    Vector w(n);
+    for (int j = 0; j < n; ++j) {
+        const double tau = kernels::householder(qr_(j, j), k, &V(0, j), V.stride());
+        block.tau[j] = tau;
+        if (tau == 0.0 || j + 1 == n) {
+            continue;
+        }
+        const int width = n - j - 1;
+        double* rrow = qr_.row(j) + j + 1;
+        for (int c = 0; c < width; ++c) {
+            w[c] = rrow[c];
+        }
+        for (int i = 0; i < k; ++i) {
+            const double v = V(i, j);
+            const double* vrow = V.row(i) + j + 1;
+            for (int c = 0; c < width; ++c) {
+                w[c] += v * vrow[c];
+            }
+        }
+        for (int c = 0; c < width; ++c) {
+            w[c] *= tau;
+            rrow[c] -= w[c];
+        }
+        for (int i = 0; i < k; ++i) {
+            const double v = V(i, j);
+            double* vrow = V.row(i) + j + 1;
+            for (int c = 0; c < width; ++c) {
+                vrow[c] -= v * w[c];
+            }
+        }
+    }
+    appended_.push_back(std::move(block));
+    rows_ += k;
+}
+
+DenseMatrix QrFactorization::r() const {
+    const int n = qr_.cols();
+    DenseMatrix R(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = i; j < n; ++j) {
+            R(i, j) = qr_(i, j);
+        }
+    }
+    return R;
+}
+
+Vector solve_least_squares(DenseMatrix A, const Vector& b, bool column_pivoting) {
+    if (static_cast<int>(b.size()) != A.rows()) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    return QrFactorization(std::move(A), column_pivoting).solve(b);
+}
\ No newline at end of file
@@ -1,50 +1,456 @@
 #include "linear_algebra.h"
+#include "dense_kernels.h"
+#include "thread_pool.h"
 #include <stdexcept>
 #include <cmath>
 #include <algorithm> // dla std::swap
+#include <type_traits>
+#include <limits>
 
-// --- Implementacja metody Gaussa ---
+// --- Implementacja DenseMatrix ---
 
-Vector solve_gauss(Matrix A, Vector b) {
-    int n = A.size();
-    if (n == 0 || A[0].size() != n || b.size() != n) {
-        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+namespace {
+    // Dugo wiersza w pamici zaokrglona do wielokrotnoci linii cache (8 wartoci double)
+    int padded_stride(int cols) {
+        const int per_line = 64 / static_cast<int>(sizeof(double));
+        return (cols + per_line - 1) / per_line * per_line;
     }
+} // anonymous namespace
 
-    for (int i = 0; i < n; i++) {
-        // Pivotowanie (wybr elementu gwnego w kolumnie)
-        int max_row = i;
-        for (int k = i + 1; k < n; k++) {
-            if (std::abs(A[k][i]) > std::abs(A[max_row][i])) {
-                max_row = k;
+DenseMatrix::DenseMatrix(int rows, int cols, double value)
+    : rows_(rows), cols_(cols), stride_(padded_stride(cols)) {
+    if (rows < 0 || cols < 0) {
+        throw std::invalid_argument("Matrix dimensions must be non-negative.");
+    }
+    data_.assign(static_cast<std::size_t>(rows_) * stride_, 0.0);
+    for (int i = 0; i < rows_; ++i) {
+        std::fill(row(i), row(i) + cols_, value);
+    }
+}
+
+DenseMatrix::DenseMatrix(std::initializer_list<std::initializer_list<double>> values)
+    : DenseMatrix(static_cast<int>(values.size()), values.size() == 0 ? 0 : static_cast<int>(values.begin()->size())) {
+    int i = 0;
+    for (const auto& r : values) {
+        if (static_cast<int>(r.size()) != cols_) {
+            throw std::invalid_argument("All matrix rows must have the same length.");
+        }
+        std::copy(r.begin(), r.end(), row(i++));
+    }
+}
+
+DenseMatrix::DenseMatrix(const Matrix& m)
+    : DenseMatrix(static_cast<int>(m.size()), m.empty() ? 0 : static_cast<int>(m[0].size())) {
+    for (int i = 0; i < rows_; ++i) {
+        if (static_cast<int>(m[i].size()) != cols_) {
+            throw std::invalid_argument("All matrix rows must have the same length.");
+        }
+        std::copy(m[i].begin(), m[i].end(), row(i));
+    }
+}
+
+void DenseMatrix::swap_rows(int i, int j) {
+    if (i != j) {
+        std::swap_ranges(row(i), row(i) + cols_, row(j));
+    }
+}
+
+Matrix DenseMatrix::to_matrix() const {
+    Matrix m(rows_);
+    for (int i = 0; i < rows_; ++i) {
+        m[i].assign(row(i), row(i) + cols_);
+    }
+    return m;
+}
+
+// --- Blokowa dekompozycja LU (wsplna dla metody Gaussa i LU) ---
+
+namespace {
+    // Szeroko panelu (dobrana eksperymentalnie dla n rzdu 2000-5000);
+    // aktualizacja reszty macierzy to mnoenie (n x NB) * (NB x n).
+    constexpr int LU_BLOCK_SIZE = 192;
+    // Panele wsze ni ta warto s rozkadane bez dalszej rekurencji.
+    constexpr int PANEL_BASE_WIDTH = 16;
+    constexpr double PIVOT_TOLERANCE = 1e-12;
+
+    // Widok na macierz pojedynczej precyzji (kopia robocza w solve_mixed_precision).
+    struct FloatMatrixView {
+        float* data = nullptr;
+        int rows = 0;
+        int cols = 0;
+        int stride = 0;
+
+        float& operator()(int i, int j) const { return data[static_cast<std::size_t>(i) * stride + j]; }
+        float* row(int i) const { return data + static_cast<std::size_t>(i) * stride; }
+    };
+
+    // Typ elementu widoku; ponisze funkcje rozkadu dziaaj zarwno na double, jak i na float.
+    template <typename View>
+    using ElementOf = std::remove_pointer_t<decltype(View::data)>;
+
+    // Rozkad panelu (kolumny k0 .. k0+kb-1, wiersze k0 .. n-1) z czciowym pivotowaniem.
+    // Zamiany wierszy obejmuj tylko kolumny panelu; ipiv[j] to wiersz zamieniony z k0+j.
+    // Zwraca indeks zerowego elementu gwnego albo -1.
+    template <typename View>
+    int factor_panel(View A, int k0, int kb, int* ipiv) {
+        using T = ElementOf<View>;
+        const int n = A.rows;
+        for (int j = k0; j < k0 + kb; ++j) {
+            int max_row = j;
+            T max_val = std::abs(A(j, j));
+            for (int i = j + 1; i < n; ++i) {
+                T v = std::abs(A(i, j));
+                if (v > max_val) {
+                    max_val = v;
+                    max_row = i;
+                }
+            }
+            ipiv[j - k0] = max_row;
+            if (max_val < PIVOT_TOLERANCE) {
+                return j;
+            }
+            if (max_row != j) {
+                std::swap_ranges(A.row(j) + k0, A.row(j) + k0 + kb, A.row(max_row) + k0);
             }
+
+            const T* row_j = A.row(j);
+            const T inv_pivot = T(1) / row_j[j];
+            for (int i = j + 1; i < n; ++i) {
+                T* row_i = A.row(i);
+                const T factor = row_i[j] * inv_pivot;
+                row_i[j] = factor;
+                for (int c = j + 1; c < k0 + kb; ++c) {
+                    row_i[c] -= factor * row_j[c];
+                }
+            }
+        }
+        return -1;
+    }
+
+    // Przenosi zamiany wierszy panelu na kolumny [c0, c1).
+    template <typename View>
+    void apply_row_swaps(View A, int k0, int kb, const int* ipiv, int c0, int c1) {
+        if (c0 >= c1) return;
+        for (int j = 0; j < kb; ++j) {
+            if (ipiv[j] != k0 + j) {
+                std::swap_ranges(A.row(k0 + j) + c0, A.row(k0 + j) + c1, A.row(ipiv[j]) + c0);
+            }
+        }
+    }
+
+    // Rekurencyjny rozkad panelu: lewa poowa, aktualizacja prawej poowy przez
+    // TRSM + GEMM, prawa poowa. Dziki temu rwnie panel korzysta z jdra mnoenia macierzy.
+    template <typename View>
+    int factor_panel_recursive(View A, int k0, int kb, int* ipiv) {
+        if (kb <= PANEL_BASE_WIDTH) {
+            return factor_panel(A, k0, kb, ipiv);
         }
-        std::swap(A[i], A[max_row]);
-        std::swap(b[i], b[max_row]);
+        const int n = A.rows;
+        const int h = kb / 2;
+        int info = factor_panel_recursive(A, k0, h, ipiv);
+        if (info >= 0) {
+            return info;
+        }
+        apply_row_swaps(A, k0, h, ipiv, k0 + h, k0 + kb);
+        kernels::trsm_lower_unit(h, kb - h, A.row(k0) + k0, A.stride, A.row(k0) + k0 + h, A.stride);
+        kernels::gemm_accumulate(n - k0 - h, kb - h, h, ElementOf<View>(-1),
+                                 A.row(k0 + h) + k0, A.stride,
+                                 A.row(k0) + k0 + h, A.stride,
+                                 A.row(k0 + h) + k0 + h, A.stride);
 
-        // Sprawdzenie osobliwoci
-        if (std::abs(A[i][i]) < 1e-12) {
-            throw std::runtime_error("Matrix is singular or nearly singular.");
+        info = factor_panel_recursive(A, k0 + h, kb - h, ipiv + h);
+        if (info >= 0) {
+            return info;
         }
+        apply_row_swaps(A, k0 + h, kb - h, ipiv + h, k0, k0 + h);
+        return -1;
+    }
+
+    // Aktualizacja kolumn [c0, c1) po rozkadzie panelu zaczynajcego si w k0:
+    // U12 = L11^{-1} A12 (rozwizanie trjktne), A22 -= L21 * U12 (mnoenie z jdrem SIMD).
+    template <typename View>
+    void update_trailing_columns(View A, int k0, int kb, int c0, int c1) {
+        if (c0 >= c1) return;
+        const int w = c1 - c0;
+        kernels::trsm_lower_unit(kb, w, A.row(k0) + k0, A.stride, A.row(k0) + c0, A.stride);
+        kernels::gemm_accumulate(A.rows - k0 - kb, w, kb, ElementOf<View>(-1),
+                                 A.row(k0 + kb) + k0, A.stride,
+                                 A.row(k0) + c0, A.stride,
+                                 A.row(k0 + kb) + c0, A.stride);
+    }
+
+    // Zapisuje zamiany panelu w permutacji i przenosi je na kolumny spoza panelu.
+    template <typename View>
+    void finish_panel_swaps(View A, int k0, int kb, const int* ipiv, int* perm) {
+        for (int j = 0; j < kb; ++j) {
+            std::swap(perm[k0 + j], perm[ipiv[j]]);
+        }
+        apply_row_swaps(A, k0, kb, ipiv, 0, k0);
+        apply_row_swaps(A, k0, kb, ipiv, k0 + kb, A.rows);
+    }
 
-        // Eliminacja
-        for (int k = i + 1; k < n; k++) {
-            double factor = A[k][i] / A[i][i];
-            b[k] -= factor * b[i];
-            for (int j = i; j < n; j++) {
-                A[k][j] -= factor * A[i][j];
+    /**
+     * Wielowtkowa wersja dekompozycji z wyprzedzeniem (lookahead) o jeden panel.
+     * W kroku k kolumny na prawo od nastpnego panelu dzielone s na kafelki aktualizowane
+     * przez pul wtkw; w tym czasie wtek wywoujcy aktualizuje kolumny nastpnego panelu
+     * i od razu go rozkada. Zamiany wierszy panelu dotycz tylko jego kolumn, wic nie
+     * koliduj z trwajcymi aktualizacjami; na pozostae kolumny przenoszone s po wait().
+     */
+    template <typename View>
+    int lu_factor_parallel(View A, int* perm, ThreadPool& pool) {
+        const int n = A.rows;
+        int ipiv[LU_BLOCK_SIZE];
+        int next_ipiv[LU_BLOCK_SIZE];
+
+        int k0 = 0;
+        int kb = std::min(LU_BLOCK_SIZE, n);
+        int info = factor_panel_recursive(A, k0, kb, ipiv);
+        while (info < 0) {
+            finish_panel_swaps(A, k0, kb, ipiv, perm);
+            const int next = k0 + kb;
+            if (next >= n) {
+                break;
+            }
+            const int next_kb = std::min(LU_BLOCK_SIZE, n - next);
+
+            // Okoo czterech kafelkw na wtek wyrwnuje obcienie; szeroko zaokrglona do 16 kolumn.
+            const int remaining = n - next - next_kb;
+            int tile = remaining / (4 * pool.size());
+            tile = std::max(64, (tile + 15) / 16 * 16);
+            for (int c0 = next + next_kb; c0 < n; c0 += tile) {
+                const int c1 = std::min(n, c0 + tile);
+                pool.submit([A, k0, kb, c0, c1] { update_trailing_columns(A, k0, kb, c0, c1); });
             }
+
+            update_trailing_columns(A, k0, kb, next, next + next_kb);
+            info = factor_panel_recursive(A, next, next_kb, next_ipiv);
+            pool.wait();
+
+            std::copy(next_ipiv, next_ipiv + next_kb, ipiv);
+            k0 = next;
+            kb = next_kb;
         }
+        return info;
     }
 
-    // Podstawienie wsteczne (Back Substitution)
-    Vector x(n);
-    for (int i = n - 1; i >= 0; i--) {
-        x[i] = b[i];
-        for (int j = i + 1; j < n; j++) {
-            x[i] -= A[i][j] * x[j];
+    /**
+     * Prawostronna (right-looking) blokowa dekompozycja PA = LU w miejscu:
+     *   1. rozkad wskiego panelu,
+     *   2. U12 = L11^{-1} A12 (rozwizanie trjktne),
+     *   3. A22 -= L21 * U12 (mnoenie macierzy z jdrem SIMD).
+     * perm[i] otrzymuje indeks oryginalnego wiersza na pozycji i.
+     * Przy threads != 1 i macierzy wikszej ni dwa panele uywana jest wersja wielowtkowa.
+     * Zwraca indeks kolumny z zerowym elementem gwnym albo -1 w razie sukcesu.
+     */
+    template <typename View>
+    int lu_factor_blocked(View A, int* perm, int threads) {
+        const int n = A.rows;
+        for (int i = 0; i < n; ++i) {
+            perm[i] = i;
         }
-        x[i] /= A[i][i];
+
+        threads = ThreadPool::resolve_thread_count(threads);
+        if (threads > 1 && n > 2 * LU_BLOCK_SIZE) {
+            ThreadPool pool(threads);
+            return lu_factor_parallel(A, perm, pool);
+        }
+
+        int ipiv[LU_BLOCK_SIZE];
+        for (int k0 = 0; k0 < n; k0 += LU_BLOCK_SIZE) {
+            const int kb = std::min(LU_BLOCK_SIZE, n - k0);
+            const int info = factor_panel_recursive(A, k0, kb, ipiv);
+            if (info >= 0) {
+                return info;
+            }
+            finish_panel_swaps(A, k0, kb, ipiv, perm);
+            update_trailing_columns(A, k0, kb, k0 + kb, n);
+        }
+        return -1;
+    }
+
+    // Rozwizuje LUx = Pb na podstawie zwartego rozkadu (x i b to rne bufory).
+    void lu_substitute(ConstMatrixView LU, const int* perm, const double* b, double* x) {
+        const int n = LU.rows;
+        for (int i = 0; i < n; i++) {
+            x[i] = b[perm[i]];
+        }
+        kernels::trsv(true, true, n, LU.data, LU.stride, 1, x);
+        kernels::trsv(false, false, n, LU.data, LU.stride, 1, x);
+    }
+
+    // Rozwizuje A^T x = b: z PA = LU wynika U^T L^T (Px) = b, wic najpierw dwa ukady
+    // trjktne z transponowanymi czynnikami (kroki wiersza i kolumny zamienione), potem permutacja.
+    void lu_substitute_transposed(ConstMatrixView LU, const int* perm, const double* b, double* x, double* work) {
+        const int n = LU.rows;
+        std::copy(b, b + n, work);
+        kernels::trsv(true, false, n, LU.data, 1, LU.stride, work);
+        kernels::trsv(false, true, n, LU.data, 1, LU.stride, work);
+        for (int i = 0; i < n; i++) {
+            x[perm[i]] = work[i];
+        }
+    }
+
+    double norm_inf(const Vector& v) {
+        double result = 0.0;
+        for (double value : v) {
+            result = std::max(result, std::abs(value));
+        }
+        return result;
+    }
+
+    // Norma ||A||_1 (najwiksza suma moduw w kolumnie), liczona wierszami dla cigego dostpu.
+    // column_sums to bufor roboczy o dugoci A.cols.
+    double matrix_norm1(ConstMatrixView A, double* column_sums) {
+        std::fill(column_sums, column_sums + A.cols, 0.0);
+        for (int i = 0; i < A.rows; ++i) {
+            const double* row_i = A.row(i);
+            for (int j = 0; j < A.cols; ++j) {
+                column_sums[j] += std::abs(row_i[j]);
+            }
+        }
+        return A.cols == 0 ? 0.0 : *std::max_element(column_sums, column_sums + A.cols);
+    }
+
+    double matrix_norm1(ConstMatrixView A) {
+        std::vector<double> column_sums(A.cols);
+        return matrix_norm1(A, column_sums.data());
+    }
+
+    // Norma ||A||_inf (najwiksza suma moduw w wierszu).
+    double matrix_norm_inf(ConstMatrixView A) {
+        double result = 0.0;
+        for (int i = 0; i < A.rows; ++i) {
+            double row_sum = 0.0;
+            for (int j = 0; j < A.cols; ++j) {
+                row_sum += std::abs(A(i, j));
+            }
+            result = std::max(result, row_sum);
+        }
+        return result;
+    }
+
+    // r = b - Ax w penej precyzji; zwraca ||r||_inf.
+    double residual_inf(const DenseMatrix& A, const Vector& x, const Vector& b, Vector& r) {
+        std::copy(b.begin(), b.end(), r.begin());
+        kernels::gemv_accumulate(A.rows(), A.cols(), -1.0, A.data(), A.stride(), 1, x.data(), r.data());
+        return norm_inf(r);
+    }
+
+    /**
+     * Oszacowanie ||A^{-1}||_1 metod Hagera-Highama (Higham, 1988; LAPACK dlacn2) z rozkadu PA = LU.
+     * Iteracja gradientowa po wierzchokach kuli jednostkowej normy 1: x = A^{-1} e_j, kierunek
+     * z = A^{-T} sign(x), kolejne j = argmax |z_j|; zwykle koczy si po 2-3 krokach. Na koniec
+     * wynik porwnywany jest z oszacowaniem dla wektora o naprzemiennych znakach, ktre chroni
+     * przed przypadkami, w ktrych iteracja utyka.
+     */
+    double estimate_inverse_norm1(ConstMatrixView LU, const int* perm) {
+        constexpr int MAX_STEPS = 5;
+        const int n = LU.rows;
+        Vector x(n, 1.0 / n), y(n), sign(n), work(n);
+        const auto norm1_of = [](const Vector& v) {
+            double sum = 0.0;
+            for (double value : v) sum += std::abs(value);
+            return sum;
+        };
+
+        lu_substitute(LU, perm, x.data(), y.data());
+        if (n == 1) {
+            return std::abs(y[0]);
+        }
+        double estimate = norm1_of(y);
+        for (int i = 0; i < n; ++i) {
+            sign[i] = y[i] >= 0.0 ? 1.0 : -1.0;
+        }
+        lu_substitute_transposed(LU, perm, sign.data(), x.data(), work.data());
+        int j = static_cast<int>(std::max_element(x.begin(), x.end(), [](double a, double b) {
+            return std::abs(a) < std::abs(b);
+        }) - x.begin());
+
+        for (int step = 2; step <= MAX_STEPS; ++step) {
+            std::fill(x.begin(), x.end(), 0.0);
+            x[j] = 1.0;
+            lu_substitute(LU, perm, x.data(), y.data());
+            const double previous = estimate;
+            estimate = norm1_of(y);
+
+            // Ten sam wektor znakw lub brak wzrostu: dalsze kroki nic nie zmieni
+            bool same_sign = true;
+            for (int i = 0; i < n && same_sign; ++i) {
+                same_sign = (y[i] >= 0.0 ? 1.0 : -1.0) == sign[i];
+            }
+            if (same_sign || estimate <= previous) {
+                estimate = std::max(estimate, previous);
+                break;
+            }
+            for (int i = 0; i < n; ++i) {
+                sign[i] = y[i] >= 0.0 ? 1.0 : -1.0;
+            }
+            lu_substitute_transposed(LU, perm, sign.data(), x.data(), work.data());
+            const int last = j;
+            j = static_cast<int>(std::max_element(x.begin(), x.end(), [](double a, double b) {
+                return std::abs(a) < std::abs(b);
+            }) - x.begin());
+            if (std::abs(x[last]) == std::abs(x[j])) {
+                break;
+            }
+        }
+
+        // Wektor testowy x_i = (-1)^i (1 + i / (n - 1)) wychwytuje przypadki, w ktrych iteracja utyka
+        for (int i = 0; i < n; ++i) {
+            x[i] = (i % 2 == 0 ? 1.0 : -1.0) * (1.0 + static_cast<double>(i) / (n - 1));
+        }
+        lu_substitute(LU, perm, x.data(), y.data());
+        return std::max(estimate, 2.0 * norm1_of(y) / (3.0 * n));
+    }
+
+    // Uzupenia diagnostyk rozwizania: oszacowanie uwarunkowania z rozkadu i residuum wzgldem A.
+    void fill_diagnostics(const DenseMatrix& A, ConstMatrixView LU, const int* perm,
+                          const Vector& x, const Vector& b, SolveDiagnostics& diagnostics) {
+        Vector r(b.size());
+        diagnostics.condition_estimate = matrix_norm1(A.view()) * estimate_inverse_norm1(LU, perm);
+        diagnostics.residual_norm = residual_inf(A, x, b, r);
+        const double denominator = matrix_norm_inf(A.view()) * norm_inf(x) + norm_inf(b);
+        diagnostics.backward_error = denominator > 0.0 ? diagnostics.residual_norm / denominator : 0.0;
+    }
+
+    // Wariant lu_substitute nadpisujcy b rozwizaniem; work to bufor pomocniczy na n elementw.
+    void lu_substitute_in_place(ConstMatrixView LU, const int* perm, double* b, double* work) {
+        lu_substitute(LU, perm, b, work);
+        std::copy(work, work + LU.rows, b);
+    }
+} // anonymous namespace
+
+
+// --- Implementacja metody Gaussa ---
+
+Vector solve_gauss(const Matrix& A, const Vector& b) {
+    int n = A.size();
+    if (n == 0 || A[0].size() != n || b.size() != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    return solve_gauss(DenseMatrix(A), b);
+}
+
+Vector solve_gauss(DenseMatrix A, Vector b, int threads, SolveDiagnostics* diagnostics) {
+    int n = A.rows();
+    if (n == 0 || A.cols() != n || static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    // Residuum liczone jest wzgldem oryginalnej macierzy, wic przy diagnostyce zachowujemy kopi
+    const DenseMatrix original = diagnostics != nullptr ? A : DenseMatrix();
+
+    // Eliminacja (blokowa, z pivotowaniem) zapisuje mnoniki pod przektn;
+    // te same operacje na wektorze b wykonuje podstawienie w przd.
+    std::vector<int> perm(n);
+    if (lu_factor_blocked(A.view(), perm.data(), threads) >= 0) {
+        throw std::runtime_error("Matrix is singular or nearly singular.");
+    }
+
+    // Podstawienie w przd i wsteczne (Back Substitution)
+    Vector x(n);
+    lu_substitute(A.view(), perm.data(), b.data(), x.data());
+    if (diagnostics != nullptr) {
+        fill_diagnostics(original, A.view(), perm.data(), x, b, *diagnostics);
     }
     return x;
 }
@@ -52,64 +458,279 @@ Vector solve_gauss(Matrix A, Vector b) {
 
 // --- Implementacja metody LU ---
 
-Vector solve_lu(Matrix A, Vector b) {
+Vector solve_lu(const Matrix& A, const Vector& b) {
     int n = A.size();
     if (n == 0 || A[0].size() != n || b.size() != n) {
         throw std::invalid_argument("Invalid matrix or vector dimensions.");
     }
+    return solve_lu(DenseMatrix(A), b);
+}
+
+Vector solve_lu(DenseMatrix A, Vector b, int threads, SolveDiagnostics* diagnostics) {
+    int n = A.rows();
+    if (n == 0 || A.cols() != n || static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    if (diagnostics == nullptr) {
+        return LuFactorization(std::move(A), threads).solve(b);
+    }
+    LuFactorization lu(A, threads);
+    Vector x = lu.solve(b);
+    fill_diagnostics(A, lu.packed_lu().view(), lu.permutation().data(), x, b, *diagnostics);
+    return x;
+}
+
+
+// --- Warianty dziaajce w miejscu ---
+
+void SolveWorkspace::reserve(int n) {
+    if (n > capacity()) {
+        pivots_.resize(n);
+        scratch_.resize(n);
+    }
+}
+
+void solve_in_place(MatrixView A, double* b, SolveWorkspace& workspace) {
+    int n = A.rows;
+    if (n == 0 || A.cols != n || A.data == nullptr || b == nullptr) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    workspace.reserve(n);
+
+    // Rozkad sekwencyjny: wersja wielowtkowa tworzyaby pul wtkw, czyli alokowaa pami
+    if (lu_factor_blocked(A, workspace.pivots(), 1) >= 0) {
+        throw std::runtime_error("Matrix is singular or nearly singular.");
+    }
+    lu_substitute_in_place(A, workspace.pivots(), b, workspace.scratch());
+}
+
+void solve_in_place(DenseMatrix& A, Vector& b, SolveWorkspace& workspace) {
+    if (static_cast<int>(b.size()) != A.rows()) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    solve_in_place(A.view(), b.data(), workspace);
+}
+
+
+// --- Implementacja klasy LuFactorization ---
+
+LuFactorization::LuFactorization(const Matrix& A, int threads) : LuFactorization(DenseMatrix(A), threads) {}
+
+LuFactorization::LuFactorization(DenseMatrix A, int threads) : lu_(std::move(A)) {
+    int n = lu_.rows();
+    if (n == 0 || lu_.cols() != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+
+    perm_.resize(n);
+    column_sums_.resize(n);
+    norm1_ = matrix_norm1(lu_.view(), column_sums_.data());
+    // Dekompozycja PA = LU w miejscu: pod przektn czynniki L (jedynki na przektnej
+    // s domylne), na przektnej i nad ni macierz U.
+    if (lu_factor_blocked(lu_.view(), perm_.data(), threads) >= 0) {
+        throw std::runtime_error("Matrix is singular, LU decomposition failed.");
+    }
+}
+
+Vector LuFactorization::solve(const Vector& b) const {
+    int n = size();
+    if (static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
 
-    Matrix L(n, Vector(n, 0.0));
-    Matrix U = A;
+    // Rozwizanie Lz = Pb (podstawienie w przd), a nastpnie Ux = z (podstawienie wstecz)
+    Vector x(n);
+    lu_substitute(lu_.view(), perm_.data(), b.data(), x.data());
+    return x;
+}
+
+void LuFactorization::solve_in_place(Vector& b, SolveWorkspace& workspace) const {
+    if (static_cast<int>(b.size()) != size()) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    solve_in_place(b.data(), workspace);
+}
 
-    // Krok 1: Dekompozycja LU z pivotowaniem (wersja uproszczona, modyfikujca b)
+void LuFactorization::solve_in_place(double* b, SolveWorkspace& workspace) const {
+    if (b == nullptr) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    workspace.reserve(size());
+    lu_substitute_in_place(lu_.view(), perm_.data(), b, workspace.scratch());
+}
+
+void LuFactorization::refactor(ConstMatrixView A, int threads) {
+    int n = size();
+    if (A.rows != n || A.cols != n || A.data == nullptr) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
     for (int i = 0; i < n; ++i) {
-        L[i][i] = 1.0;
+        std::copy(A.row(i), A.row(i) + n, lu_.row(i));
+    }
+    norm1_ = matrix_norm1(A, column_sums_.data());
+    if (lu_factor_blocked(lu_.view(), perm_.data(), threads) >= 0) {
+        throw std::runtime_error("Matrix is singular, LU decomposition failed.");
     }
+}
 
-    for (int k = 0; k < n; k++) {
-        // Pivotowanie
-        int max_row = k;
-        for (int i = k + 1; i < n; i++) {
-            if (std::abs(U[i][k]) > std::abs(U[max_row][k])) {
-                max_row = i;
-            }
+Vector LuFactorization::solve_transposed(const Vector& b) const {
+    int n = size();
+    if (static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    Vector x(n), work(n);
+    lu_substitute_transposed(lu_.view(), perm_.data(), b.data(), x.data(), work.data());
+    return x;
+}
+
+double LuFactorization::condition_estimate() const {
+    return norm1_ * estimate_inverse_norm1(lu_.view(), perm_.data());
+}
+
+DenseMatrix LuFactorization::solve(const DenseMatrix& B) const {
+    int n = size();
+    if (B.rows() != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    int m = B.cols();
+
+    // Wiersze X odpowiadaj rwnaniom, wic operacje na caych wierszach
+    // przetwarzaj wszystkie prawe strony jednoczenie.
+    DenseMatrix X(n, m);
+    for (int i = 0; i < n; i++) {
+        std::copy(B.row(perm_[i]), B.row(perm_[i]) + m, X.row(i));
+    }
+
+    kernels::trsm_lower_unit(n, m, lu_.data(), lu_.stride(), X.data(), X.stride());
+    kernels::trsm(false, false, n, m, lu_.data(), lu_.stride(), 1, X.data(), X.stride());
+    return X;
+}
+
+
+// --- Rozwizanie w mieszanej precyzji ---
+
+namespace {
+    // Dugo wiersza kopii float zaokrglona do wielokrotnoci linii cache (16 wartoci float)
+    int padded_stride_float(int cols) {
+        const int per_line = 64 / static_cast<int>(sizeof(float));
+        return (cols + per_line - 1) / per_line * per_line;
+    }
+
+    // Rozwizuje LUd = Pr rozkadem pojedynczej precyzji. Residuum jest skalowane przez
+    // 1 / ||r||_inf przed konwersj do float, aby mae wartoci nie znikay poza zakresem typu.
+    void lu_substitute_float(FloatMatrixView LU, const int* perm, const Vector& r, double r_norm,
+                             float* work, Vector& d) {
+        const int n = LU.rows;
+        const double scale = r_norm > 0.0 ? 1.0 / r_norm : 1.0;
+        for (int i = 0; i < n; ++i) {
+            work[i] = static_cast<float>(r[perm[i]] * scale);
         }
-        if (max_row != k) {
-            std::swap(U[k], U[max_row]);
-            std::swap(b[k], b[max_row]); // Pivotujemy rwnie wektor b
+        kernels::trsv(true, true, n, LU.data, LU.stride, 1, work);
+        kernels::trsv(false, false, n, LU.data, LU.stride, 1, work);
+        for (int i = 0; i < n; ++i) {
+            d[i] = static_cast<double>(work[i]) * r_norm;
         }
+    }
+} // anonymous namespace
 
-        if (std::abs(U[k][k]) < 1e-12) {
-            throw std::runtime_error("Matrix is singular, LU decomposition failed.");
+Vector solve_mixed_precision(const DenseMatrix& A, const Vector& b, RefinementInfo* info,
+                             int max_iterations, int threads) {
+    int n = A.rows();
+    if (n == 0 || A.cols() != n || static_cast<int>(b.size()) != n || max_iterations < 0) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+
+    double a_norm = 0.0;
+    bool fits_float = true;
+    for (int i = 0; i < n; ++i) {
+        double row_sum = 0.0;
+        for (int j = 0; j < n; ++j) {
+            const double v = std::abs(A(i, j));
+            fits_float = fits_float && v <= std::numeric_limits<float>::max();
+            row_sum += v;
         }
+        a_norm = std::max(a_norm, row_sum);
+    }
+    const double b_norm = norm_inf(b);
+    // Kryterium zbienoci jak w LAPACK dsgesv: ||r|| <= ||x|| * ||A|| * eps * sqrt(n)
+    const double tolerance = a_norm * std::numeric_limits<double>::epsilon() * std::sqrt(static_cast<double>(n));
 
-        // Tworzenie macierzy L i U
-        for (int i = k + 1; i < n; i++) {
-            double factor = U[i][k] / U[k][k];
-            L[i][k] = factor;
-            for (int j = k; j < n; j++) {
-                U[i][j] -= factor * U[k][j];
+    RefinementInfo result;
+    Vector x(n, 0.0);
+    Vector r = b;
+    double r_norm = b_norm;
+    bool converged = false;
+
+    if (fits_float) {
+        const int stride = padded_stride_float(n);
+        std::vector<float, AlignedAllocator<float>> lu(static_cast<std::size_t>(n) * stride);
+        FloatMatrixView view{ lu.data(), n, n, stride };
+        for (int i = 0; i < n; ++i) {
+            const double* row_i = A.row(i);
+            std::transform(row_i, row_i + n, view.row(i), [](double v) { return static_cast<float>(v); });
+        }
+
+        std::vector<int> perm(n);
+        if (lu_factor_blocked(view, perm.data(), threads) < 0) {
+            std::vector<float> work(n);
+            Vector d(n);
+            // Pierwszy krok (x = 0, r = b) daje rozwizanie z rozkadu float, kolejne je poprawiaj
+            double previous = std::numeric_limits<double>::infinity();
+            for (int iteration = 0; iteration <= max_iterations + 1; ++iteration) {
+                if (r_norm <= norm_inf(x) * tolerance) {
+                    converged = true;
+                    break;
+                }
+                // Residuum nie maleje wystarczajco szybko (lub pojawio si NaN): poprawianie utkno
+                if (iteration > max_iterations || !(r_norm < 0.5 * previous)) {
+                    break;
+                }
+                lu_substitute_float(view, perm.data(), r, r_norm, work.data(), d);
+                for (int i = 0; i < n; ++i) {
+                    x[i] += d[i];
+                }
+                previous = r_norm;
+                r_norm = residual_inf(A, x, b, r);
+                result.iterations = iteration;
             }
         }
     }
 
-    // Krok 2: Rozwizanie Lz = b (Podstawienie w przd)
-    Vector z(n);
-    for (int i = 0; i < n; i++) {
-        z[i] = b[i];
-        for (int j = 0; j < i; j++) {
-            z[i] -= L[i][j] * z[j];
-        }
+    if (!converged) {
+        x = LuFactorization(A, threads).solve(b);
+        r_norm = residual_inf(A, x, b, r);
+        result.used_double_fallback = true;
     }
 
-    // Krok 3: Rozwizanie Ux = z (Podstawienie wstecz)
-    Vector x(n);
-    for (int i = n - 1; i >= 0; i--) {
-        x[i] = z[i];
-        for (int j = i + 1; j < n; j++) {
-            x[i] -= U[i][j] * x[j];
-        }
-        x[i] /= U[i][i];
+    const double denominator = a_norm * norm_inf(x) + b_norm;
+    result.backward_error = denominator > 0.0 ? r_norm / denominator : 0.0;
+    if (info != nullptr) {
+        *info = result;
     }
     return x;
+}
+
+
+// --- Implementacja wsadowego rozwizywania maych ukadw ---
+
+SystemBatch::SystemBatch(int n, int count) : n_(n), count_(count) {
+    if (n <= 0 || count < 0) {
+        throw std::invalid_argument("Invalid batch dimensions.");
+    }
+    a_.assign(static_cast<std::size_t>(n) * n * count, 0.0);
+    b_.assign(static_cast<std::size_t>(n) * count, 0.0);
+}
+
+void solve_batched(SystemBatch& batch) {
+    solve_batched(batch.size(), batch.count(), batch.matrix_data(), batch.rhs_data());
+}
+
+void solve_batched(int n, int count, double* a, double* b) {
+    if (n <= 0 || count < 0 || (count > 0 && (a == nullptr || b == nullptr))) {
+        throw std::invalid_argument("Invalid batch dimensions.");
+    }
+    const int singular = kernels::solve_batched_soa(n, count, a, b);
+    if (singular >= 0) {
+        throw std::runtime_error("Matrix is singular or nearly singular (system " + std::to_string(singular) + " in batch).");
+    }
 }
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "linear_algebra.h"
+#include "blas.h"
+#include "sparse_matrix.h"
+#include <stdexcept>
+#include <utility>
+
+LinearOperator::LinearOperator(int n, ApplyFunction apply, Vector diagonal)
+    : n_(n), apply_(std::move(apply)), diagonal_(std::move(diagonal)) {
+    if (n < 0 || !apply_) {
+        throw std::invalid_argument("Linear operator needs a non-negative size and an apply function.");
+    }
+    if (!diagonal_.empty() && static_cast<int>(diagonal_.size()) != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+}
+
+LinearOperator::LinearOperator(const DenseMatrix& A) : n_(A.rows()) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    const DenseMatrix* M = &A;
+    apply_ = [M](const double* x, double* y) {
+        gemv(Transpose::No, 1.0, M->view(), x, 0.0, y);
+    };
+    diagonal_.resize(n_);
+    for (int i = 0; i < n_; ++i) {
+        diagonal_[i] = A(i, i);
+    }
+}
+
+LinearOperator::LinearOperator(const SparseMatrix& A) : n_(A.rows()) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    const SparseMatrix* M = &A;
+    apply_ = [M](const double* x, double* y) { M->multiply(x, y); };
+    diagonal_.resize(n_);
+    for (int i = 0; i < n_; ++i) {
+        diagonal_[i] = A.at(i, i);
+    }
+}
+
+Vector LinearOperator::apply(const Vector& x) const {
+    if (static_cast<int>(x.size()) != n_) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    Vector y(n_);
+    apply_(x.data(), y.data());
+    return y;
+}
\ No newline at end of file
@@ -0,0 +1,621 @@
+#include "sparse_matrix.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <queue>
+#include <functional>
+#include <utility>
+
+namespace {
+    // Próg, poniżej którego element główny uznajemy za zerowy (jak w gęstej dekompozycji)
+    const double PIVOT_TOLERANCE = 1e-12;
+
+    // Transpozycja skompresowanej struktury (CSR <-> CSC) przez zliczanie; wynikowe indeksy są posortowane
+    void compressed_transpose(int major, int minor,
+                              const std::vector<int>& ptr, const std::vector<int>& idx, const std::vector<double>& val,
+                              std::vector<int>& out_ptr, std::vector<int>& out_idx, std::vector<double>& out_val) {
+        out_ptr.assign(minor + 1, 0);
+        for (int j : idx) {
+            ++out_ptr[j + 1];
+        }
+        for (int j = 0; j < minor; ++j) {
+            out_ptr[j + 1] += out_ptr[j];
+        }
+        out_idx.resize(idx.size());
+        out_val.resize(val.size());
+        std::vector<int> next(out_ptr.begin(), out_ptr.end() - 1);
+        for (int i = 0; i < major; ++i) {
+            for (int p = ptr[i]; p < ptr[i + 1]; ++p) {
+                int q = next[idx[p]]++;
+                out_idx[q] = i;
+                out_val[q] = val[p];
+            }
+        }
+    }
+
+    // Sprawdza spójność tablic skompresowanego formatu
+    void validate_compressed(int major, int minor, const std::vector<int>& ptr,
+                             const std::vector<int>& idx, const std::vector<double>& val) {
+        if (major < 0 || minor < 0) {
+            throw std::invalid_argument("Matrix dimensions must be non-negative.");
+        }
+        if (static_cast<int>(ptr.size()) != major + 1 || ptr[0] != 0 ||
+            idx.size() != val.size() || ptr[major] != static_cast<int>(idx.size())) {
+            throw std::invalid_argument("Inconsistent compressed sparse matrix arrays.");
+        }
+        for (int i = 0; i < major; ++i) {
+            if (ptr[i] > ptr[i + 1]) {
+                throw std::invalid_argument("Inconsistent compressed sparse matrix arrays.");
+            }
+            for (int p = ptr[i]; p < ptr[i + 1]; ++p) {
+                if (idx[p] < 0 || idx[p] >= minor || (p > ptr[i] && idx[p] <= idx[p - 1])) {
+                    throw std::invalid_argument("Sparse matrix indices must be in range and strictly increasing.");
+                }
+            }
+        }
+    }
+} // anonymous namespace
+
+// --- SparseMatrix (CSR) ---
+
+SparseMatrix::SparseMatrix(int rows, int cols, std::vector<int> row_ptr, std::vector<int> col_idx, std::vector<double> values)
+    : rows_(rows), cols_(cols), row_ptr_(std::move(row_ptr)), col_idx_(std::move(col_idx)), values_(std::move(values)) {
+    validate_compressed(rows_, cols_, row_ptr_, col_idx_, values_);
+}
+
+SparseMatrix SparseMatrix::from_triplets(int rows, int cols, const std::vector<Triplet>& triplets) {
+    if (rows < 0 || cols < 0) {
+        throw std::invalid_argument("Matrix dimensions must be non-negative.");
+    }
+    // Rozdzielenie trójek na wiersze (sortowanie przez zliczanie)
+    std::vector<int> row_ptr(rows + 1, 0);
+    for (const Triplet& t : triplets) {
+        if (t.row < 0 || t.row >= rows || t.col < 0 || t.col >= cols) {
+            throw std::invalid_argument("Triplet index out of matrix bounds.");
+        }
+        ++row_ptr[t.row + 1];
+    }
+    for (int i = 0; i < rows; ++i) {
+        row_ptr[i + 1] += row_ptr[i];
+    }
+    std::vector<std::pair<int, double>> entries(triplets.size());
+    std::vector<int> next(row_ptr.begin(), row_ptr.end() - 1);
+    for (const Triplet& t : triplets) {
+        entries[next[t.row]++] = { t.col, t.value };
+    }
+
+    // Sortowanie kolumn w obrębie wiersza i sumowanie duplikatów
+    SparseMatrix result;
+    result.rows_ = rows;
+    result.cols_ = cols;
+    result.row_ptr_.assign(rows + 1, 0);
+    result.col_idx_.reserve(entries.size());
+    result.values_.reserve(entries.size());
+    for (int i = 0; i < rows; ++i) {
+        auto first = entries.begin() + row_ptr[i];
+        auto last = entries.begin() + row_ptr[i + 1];
+        std::sort(first, last, [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (auto it = first; it != last; ++it) {
+            if (static_cast<int>(result.col_idx_.size()) > result.row_ptr_[i] && result.col_idx_.back() == it->first) {
+                result.values_.back() += it->second;
+            }
+            else {
+                result.col_idx_.push_back(it->first);
+                result.values_.push_back(it->second);
+            }
+        }
+        result.row_ptr_[i + 1] = static_cast<int>(result.col_idx_.size());
+    }
+    return result;
+}
+
+double SparseMatrix::at(int i, int j) const {
+    if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+        throw std::out_of_range("Sparse matrix index out of range.");
+    }
+    auto first = col_idx_.begin() + row_ptr_[i];
+    auto last = col_idx_.begin() + row_ptr_[i + 1];
+    auto it = std::lower_bound(first, last, j);
+    return (it != last && *it == j) ? values_[it - col_idx_.begin()] : 0.0;
+}
+
+void SparseMatrix::multiply(const double* x, double* y) const {
+    for (int i = 0; i < rows_; ++i) {
+        double sum = 0.0;
+        for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+            sum += values_[p] * x[col_idx_[p]];
+        }
+        y[i] = sum;
+    }
+}
+
+Vector SparseMatrix::multiply(const Vector& x) const {
+    if (static_cast<int>(x.size()) != cols_) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    Vector y(rows_);
+    multiply(x.data(), y.data());
+    return y;
+}
+
+Vector SparseMatrix::multiply_transpose(const Vector& x) const {
+    if (static_cast<int>(x.size()) != rows_) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    Vector y(cols_, 0.0);
+    for (int i = 0; i < rows_; ++i) {
+        for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+            y[col_idx_[p]] += values_[p] * x[i];
+        }
+    }
+    return y;
+}
+
+SparseMatrix SparseMatrix::transpose() const {
+    SparseMatrix result;
+    result.rows_ = cols_;
+    result.cols_ = rows_;
+    compressed_transpose(rows_, cols_, row_ptr_, col_idx_, values_, result.row_ptr_, result.col_idx_, result.values_);
+    return result;
+}
+
+CscMatrix SparseMatrix::to_csc() const {
+    // Kolumny A to wiersze A^T, więc CSC macierzy A ma te same tablice co CSR jej transpozycji
+    std::vector<int> col_ptr, row_idx;
+    std::vector<double> values;
+    compressed_transpose(rows_, cols_, row_ptr_, col_idx_, values_, col_ptr, row_idx, values);
+    return CscMatrix(rows_, cols_, std::move(col_ptr), std::move(row_idx), std::move(values));
+}
+
+DenseMatrix SparseMatrix::to_dense() const {
+    DenseMatrix D(rows_, cols_);
+    for (int i = 0; i < rows_; ++i) {
+        for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+            D(i, col_idx_[p]) = values_[p];
+        }
+    }
+    return D;
+}
+
+// --- CscMatrix ---
+
+CscMatrix::CscMatrix(int rows, int cols, std::vector<int> col_ptr, std::vector<int> row_idx, std::vector<double> values)
+    : rows_(rows), cols_(cols), col_ptr_(std::move(col_ptr)), row_idx_(std::move(row_idx)), values_(std::move(values)) {
+    validate_compressed(cols_, rows_, col_ptr_, row_idx_, values_);
+}
+
+Vector CscMatrix::multiply(const Vector& x) const {
+    if (static_cast<int>(x.size()) != cols_) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    Vector y(rows_, 0.0);
+    for (int j = 0; j < cols_; ++j) {
+        const double xj = x[j];
+        for (int p = col_ptr_[j]; p < col_ptr_[j + 1]; ++p) {
+            y[row_idx_[p]] += values_[p] * xj;
+        }
+    }
+    return y;
+}
+
+SparseMatrix CscMatrix::to_csr() const {
+    std::vector<int> row_ptr, col_idx;
+    std::vector<double> values;
+    compressed_transpose(cols_, rows_, col_ptr_, row_idx_, values_, row_ptr, col_idx, values);
+    return SparseMatrix(rows_, cols_, std::move(row_ptr), std::move(col_idx), std::move(values));
+}
+
+// --- Porządek approximate minimum degree ---
+
+std::vector<int> approximate_minimum_degree(const SparseMatrix& A) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    const int n = A.rows();
+
+    // Graf A + A^T bez pętli: sąsiedzi zmiennej i to zmienne j z a_ij != 0 lub a_ji != 0
+    const SparseMatrix At = A.transpose();
+    std::vector<std::vector<int>> adjacent(n);
+    for (int i = 0; i < n; ++i) {
+        const int* a_first = A.col_indices().data() + A.row_pointers()[i];
+        const int* a_last = A.col_indices().data() + A.row_pointers()[i + 1];
+        const int* t_first = At.col_indices().data() + At.row_pointers()[i];
+        const int* t_last = At.col_indices().data() + At.row_pointers()[i + 1];
+        std::set_union(a_first, a_last, t_first, t_last, std::back_inserter(adjacent[i]));
+        adjacent[i].erase(std::remove(adjacent[i].begin(), adjacent[i].end(), i), adjacent[i].end());
+    }
+
+    // Graf ilorazowy: elements[i] to elementy sąsiadujące ze zmienną i, members[e] to zmienne elementu e.
+    // Zmienne nierozróżnialne (o identycznych sąsiedztwach) łączone są w superzmienne o wadze weight[i];
+    // zmienna dołączona do innej (MERGED) jest eliminowana razem z nią.
+    enum : char { VARIABLE, ELEMENT, ABSORBED, MERGED };
+    std::vector<char> state(n, VARIABLE);
+    std::vector<int> weight(n, 1);
+    std::vector<int> next_merged(n, -1), last_merged(n);
+    std::iota(last_merged.begin(), last_merged.end(), 0);
+    std::vector<std::vector<int>> elements(n);
+    std::vector<std::vector<int>> members(n);
+    std::vector<int> element_weight(n, 0);
+    std::vector<int> degree(n);
+
+    using Entry = std::pair<int, int>; // (stopień, zmienna)
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+    for (int i = 0; i < n; ++i) {
+        degree[i] = static_cast<int>(adjacent[i].size());
+        queue.push({ degree[i], i });
+    }
+
+    std::vector<int> in_pivot(n, -1);     // in_pivot[v] == step, gdy v należy do L_p w bieżącym kroku
+    std::vector<int> external(n, 0);      // waga L_e \ L_p dla elementów sąsiadujących z L_p
+    std::vector<int> external_step(n, -1);
+    std::vector<int> seen(n, -1);         // znaczniki przy porównywaniu sąsiedztw
+    int seen_stamp = 0;
+    std::vector<int> order;
+    order.reserve(n);
+
+    int eliminated = 0;
+    for (int step = 0; eliminated < n; ++step) {
+        // Superzmienna o najmniejszym (przybliżonym) stopniu; nieaktualne wpisy kolejki są pomijane
+        int p = -1;
+        while (p < 0) {
+            Entry top = queue.top();
+            queue.pop();
+            if (state[top.second] == VARIABLE && top.first == degree[top.second]) {
+                p = top.second;
+            }
+        }
+        for (int v = p; v >= 0; v = next_merged[v]) {
+            order.push_back(v);
+        }
+        eliminated += weight[p];
+        state[p] = ELEMENT;
+        in_pivot[p] = step;
+
+        // L_p: sąsiedzi p w grafie zmiennych i zmienne wszystkich elementów sąsiadujących z p
+        std::vector<int> pivot_set;
+        for (int v : adjacent[p]) {
+            if (state[v] == VARIABLE && in_pivot[v] != step) {
+                in_pivot[v] = step;
+                pivot_set.push_back(v);
+            }
+        }
+        for (int e : elements[p]) {
+            if (state[e] != ELEMENT) {
+                continue;
+            }
+            for (int v : members[e]) {
+                if (state[v] == VARIABLE && in_pivot[v] != step) {
+                    in_pivot[v] = step;
+                    pivot_set.push_back(v);
+                }
+            }
+            // Element e jest w całości zawarty w nowym elemencie p
+            state[e] = ABSORBED;
+            std::vector<int>().swap(members[e]);
+        }
+        std::vector<int>().swap(adjacent[p]);
+        std::vector<int>().swap(elements[p]);
+
+        int pivot_weight = 0;
+        for (int i : pivot_set) {
+            pivot_weight += weight[i];
+        }
+
+        // Waga L_e \ L_p = waga L_e minus wagi zmiennych L_p, które sąsiadują z e
+        for (int i : pivot_set) {
+            for (int e : elements[i]) {
+                if (state[e] != ELEMENT) {
+                    continue;
+                }
+                if (external_step[e] != step) {
+                    external_step[e] = step;
+                    external[e] = element_weight[e];
+                }
+                external[e] -= weight[i];
+            }
+        }
+
+        // Aktualizacja list E_i i A_i; partial[j] to składnik stopnia niezależny od łączenia superzmiennych
+        std::vector<int> partial(pivot_set.size());
+        std::vector<std::pair<unsigned, int>> hashes(pivot_set.size());
+        for (std::size_t s = 0; s < pivot_set.size(); ++s) {
+            const int i = pivot_set[s];
+            unsigned hash = 0;
+
+            // E_i: usunięcie elementów pochłoniętych (także tych zawartych w L_p) i dodanie p
+            std::vector<int>& ei = elements[i];
+            int external_sum = 0;
+            std::size_t kept = 0;
+            for (int e : ei) {
+                if (state[e] != ELEMENT) {
+                    continue;
+                }
+                if (external[e] == 0) {
+                    state[e] = ABSORBED;
+                    std::vector<int>().swap(members[e]);
+                    continue;
+                }
+                ei[kept++] = e;
+                external_sum += external[e];
+                hash += static_cast<unsigned>(e);
+            }
+            ei.resize(kept);
+            ei.push_back(p);
+            hash += static_cast<unsigned>(p);
+
+            // A_i: krawędzie do zmiennych z L_p są już reprezentowane przez element p
+            std::vector<int>& ai = adjacent[i];
+            int adjacent_weight = 0;
+            kept = 0;
+            for (int v : ai) {
+                if (state[v] == VARIABLE && in_pivot[v] != step) {
+                    ai[kept++] = v;
+                    adjacent_weight += weight[v];
+                    hash += static_cast<unsigned>(v);
+                }
+            }
+            ai.resize(kept);
+
+            partial[s] = adjacent_weight + external_sum;
+            hashes[s] = { hash, static_cast<int>(s) };
+        }
+
+        // Wykrywanie superzmiennych: zmienne o tych samych listach E i A są nierozróżnialne
+        std::sort(hashes.begin(), hashes.end());
+        for (std::size_t first = 0; first < hashes.size();) {
+            std::size_t last = first + 1;
+            while (last < hashes.size() && hashes[last].first == hashes[first].first) {
+                ++last;
+            }
+            for (std::size_t a = first; a + 1 < last; ++a) {
+                const int i = pivot_set[hashes[a].second];
+                if (state[i] != VARIABLE) {
+                    continue;
+                }
+                ++seen_stamp;
+                for (int e : elements[i]) seen[e] = seen_stamp;
+                for (int v : adjacent[i]) seen[v] = seen_stamp;
+                for (std::size_t b = a + 1; b < last; ++b) {
+                    const int j = pivot_set[hashes[b].second];
+                    if (state[j] != VARIABLE || elements[j].size() != elements[i].size() ||
+                        adjacent[j].size() != adjacent[i].size()) {
+                        continue;
+                    }
+                    bool same = true;
+                    for (int e : elements[j]) same = same && seen[e] == seen_stamp;
+                    for (int v : adjacent[j]) same = same && seen[v] == seen_stamp;
+                    if (!same) {
+                        continue;
+                    }
+                    weight[i] += weight[j];
+                    weight[j] = 0;
+                    state[j] = MERGED;
+                    next_merged[last_merged[i]] = j;
+                    last_merged[i] = last_merged[j];
+                    std::vector<int>().swap(elements[j]);
+                    std::vector<int>().swap(adjacent[j]);
+                }
+            }
+            first = last;
+        }
+
+        // Przybliżony stopień (górne oszacowanie) z algorytmu AMD
+        const int remaining = n - eliminated;
+        std::size_t kept = 0;
+        for (std::size_t s = 0; s < pivot_set.size(); ++s) {
+            const int i = pivot_set[s];
+            if (state[i] != VARIABLE) {
+                continue;
+            }
+            pivot_set[kept++] = i;
+            const int d = std::min(partial[s] + pivot_weight - weight[i], remaining - weight[i]);
+            if (d != degree[i]) {
+                degree[i] = d;
+                queue.push({ d, i });
+            }
+        }
+        pivot_set.resize(kept);
+        element_weight[p] = pivot_weight;
+        members[p] = std::move(pivot_set);
+    }
+    return order;
+}
+
+// --- Rzadka dekompozycja LU ---
+
+namespace {
+    // Przeszukiwanie w głąb grafu kolumn L od wiersza start. Wiersz j, który był już elementem
+    // głównym (pinv[j] >= 0), prowadzi do wierszy kolumny pinv[j] czynnika L. Odwiedzone wiersze
+    // trafiają do reach[top..n) w porządku topologicznym; funkcja zwraca nowe top.
+    int depth_first(int start, const std::vector<int>& l_ptr, const std::vector<int>& l_idx,
+                    const std::vector<int>& pinv, std::vector<char>& visited,
+                    std::vector<int>& stack, std::vector<int>& position, std::vector<int>& reach, int top) {
+        int head = 0;
+        stack[0] = start;
+        while (head >= 0) {
+            const int j = stack[head];
+            const int jnew = pinv[j];
+            if (!visited[j]) {
+                visited[j] = 1;
+                position[head] = jnew < 0 ? 0 : l_ptr[jnew] + 1; // pierwszy element kolumny to przekątna
+            }
+            bool done = true;
+            const int end = jnew < 0 ? 0 : l_ptr[jnew + 1];
+            for (int p = position[head]; p < end; ++p) {
+                const int i = l_idx[p];
+                if (visited[i]) {
+                    continue;
+                }
+                position[head] = p + 1;
+                stack[++head] = i;
+                done = false;
+                break;
+            }
+            if (done) {
+                --head;
+                reach[--top] = j;
+            }
+        }
+        return top;
+    }
+} // anonymous namespace
+
+SparseLuFactorization::SparseLuFactorization(const SparseMatrix& A, SparseOrdering ordering, double pivot_threshold) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    if (!(pivot_threshold > 0.0 && pivot_threshold <= 1.0)) {
+        throw std::invalid_argument("Pivot threshold must be in (0, 1].");
+    }
+    n_ = A.rows();
+    if (ordering == SparseOrdering::ApproximateMinimumDegree) {
+        q_ = approximate_minimum_degree(A);
+    }
+    else {
+        q_.resize(n_);
+        std::iota(q_.begin(), q_.end(), 0);
+    }
+
+    const CscMatrix C = A.to_csc();
+    const std::vector<int>& a_ptr = C.col_pointers();
+    const std::vector<int>& a_idx = C.row_indices();
+    const std::vector<double>& a_val = C.values();
+
+    // Podczas rozkładu L przechowuje oryginalne numery wierszy; pinv[i] to krok, w którym
+    // wiersz i został elementem głównym (-1, jeśli jeszcze nie był)
+    std::vector<int> pinv(n_, -1);
+    std::vector<double> x(n_, 0.0);
+    std::vector<int> reach(n_), stack(n_), position(n_);
+    std::vector<char> visited(n_, 0);
+
+    l_col_ptr_.assign(n_ + 1, 0);
+    u_col_ptr_.assign(n_ + 1, 0);
+    const std::size_t estimate = 4 * static_cast<std::size_t>(A.non_zeros()) + n_;
+    l_row_idx_.reserve(estimate);
+    l_values_.reserve(estimate);
+    u_row_idx_.reserve(estimate);
+    u_values_.reserve(estimate);
+
+    for (int k = 0; k < n_; ++k) {
+        const int col = q_[k];
+        l_col_ptr_[k] = static_cast<int>(l_values_.size());
+        u_col_ptr_[k] = static_cast<int>(u_values_.size());
+
+        // 1. Struktura rozwiązania L x = A(:, col): wiersze osiągalne z niezerowych elementów kolumny
+        int top = n_;
+        for (int p = a_ptr[col]; p < a_ptr[col + 1]; ++p) {
+            if (!visited[a_idx[p]]) {
+                top = depth_first(a_idx[p], l_col_ptr_, l_row_idx_, pinv, visited, stack, position, reach, top);
+            }
+        }
+        for (int t = top; t < n_; ++t) {
+            visited[reach[t]] = 0;
+        }
+
+        // 2. Rzadkie podstawienie w przód w porządku topologicznym
+        for (int p = a_ptr[col]; p < a_ptr[col + 1]; ++p) {
+            x[a_idx[p]] = a_val[p];
+        }
+        for (int t = top; t < n_; ++t) {
+            const int j = reach[t];
+            const int jnew = pinv[j];
+            if (jnew < 0) {
+                continue;
+            }
+            const double xj = x[j];
+            for (int p = l_col_ptr_[jnew] + 1; p < l_col_ptr_[jnew + 1]; ++p) {
+                x[l_row_idx_[p]] -= l_values_[p] * xj;
+            }
+        }
+
+        // 3. Kolumna U oraz wybór elementu głównego spośród wierszy, które nim jeszcze nie były
+        int pivot_row = -1;
+        double max_abs = -1.0;
+        for (int t = top; t < n_; ++t) {
+            const int i = reach[t];
+            if (pinv[i] < 0) {
+                if (std::abs(x[i]) > max_abs) {
+                    max_abs = std::abs(x[i]);
+                    pivot_row = i;
+                }
+            }
+            else {
+                u_row_idx_.push_back(pinv[i]);
+                u_values_.push_back(x[i]);
+            }
+        }
+        if (pivot_row < 0 || max_abs < PIVOT_TOLERANCE) {
+            throw std::runtime_error("Matrix is singular, LU decomposition failed.");
+        }
+        // Element "przekątniowy" zachowuje strukturę wyznaczoną przez porządek AMD
+        if (pinv[col] < 0 && std::abs(x[col]) >= pivot_threshold * max_abs) {
+            pivot_row = col;
+        }
+        const double pivot = x[pivot_row];
+        pinv[pivot_row] = k;
+        u_row_idx_.push_back(k);
+        u_values_.push_back(pivot);
+
+        // 4. Kolumna L: jedynka na przekątnej, potem mnożniki
+        l_row_idx_.push_back(pivot_row);
+        l_values_.push_back(1.0);
+        for (int t = top; t < n_; ++t) {
+            const int i = reach[t];
+            if (pinv[i] < 0) {
+                l_row_idx_.push_back(i);
+                l_values_.push_back(x[i] / pivot);
+            }
+            x[i] = 0.0;
+        }
+    }
+    l_col_ptr_[n_] = static_cast<int>(l_values_.size());
+    u_col_ptr_[n_] = static_cast<int>(u_values_.size());
+
+    // Przenumerowanie wierszy L na numerację elementów głównych
+    p_.resize(n_);
+    for (int i = 0; i < n_; ++i) {
+        p_[pinv[i]] = i;
+    }
+    for (int& i : l_row_idx_) {
+        i = pinv[i];
+    }
+}
+
+Vector SparseLuFactorization::solve(const Vector& b) const {
+    if (static_cast<int>(b.size()) != n_) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    // P A Q = L U, więc A x = b  <=>  L U (Q^T x) = P b
+    Vector y(n_);
+    for (int k = 0; k < n_; ++k) {
+        y[k] = b[p_[k]];
+    }
+    for (int j = 0; j < n_; ++j) {
+        const double yj = y[j];
+        for (int p = l_col_ptr_[j] + 1; p < l_col_ptr_[j + 1]; ++p) {
+            y[l_row_idx_[p]] -= l_values_[p] * yj;
+        }
+    }
+    for (int j = n_ - 1; j >= 0; --j) {
+        const int diag = u_col_ptr_[j + 1] - 1;
+        y[j] /= u_values_[diag];
+        const double yj = y[j];
+        for (int p = u_col_ptr_[j]; p < diag; ++p) {
+            y[u_row_idx_[p]] -= u_values_[p] * yj;
+        }
+    }
+    Vector x(n_);
+    for (int k = 0; k < n_; ++k) {
+        x[q_[k]] = y[k];
+    }
+    return x;
+}
+
+Vector solve_lu(const SparseMatrix& A, const Vector& b) {
+    if (A.rows() != A.cols() || static_cast<int>(b.size()) != A.rows()) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    return SparseLuFactorization(A).solve(b);
+}
\ No newline at end of file
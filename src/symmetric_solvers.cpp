@@ -0,0 +1,368 @@
+#include "linear_algebra.h"
+#include "dense_kernels.h"
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+
+namespace {
+    // Próg, poniżej którego element główny uznajemy za zerowy (jak w solverach gęstych)
+    constexpr double PIVOT_TOLERANCE = 1e-12;
+
+    // Szerokość panelu kolumn rozkładu Cholesky'ego, kafelka aktualizacji i najmniejszego panelu rekurencji
+    constexpr int CHOLESKY_BLOCK_SIZE = 240;
+    constexpr int CHOLESKY_TILE_WIDTH = 120;
+    constexpr int CHOLESKY_PANEL_BASE = 16;
+
+    // x += alpha * y na n elementach (ciągłe kolumny spakowanego trójkąta)
+    void axpy(int n, double alpha, const double* y, double* x) {
+        for (int i = 0; i < n; ++i) {
+            x[i] += alpha * y[i];
+        }
+    }
+
+    // Bufory robocze aktualizacji (wielokrotnie używane w obrębie jednego rozkładu)
+    struct CholeskyWorkspace {
+        std::vector<double, AlignedAllocator<double>> P, PT, T;
+    };
+
+    // A(i, j) -= sum_{p0 <= p < p1} L(i, p) L(j, p) dla kolumn j0 <= j < j1 i wierszy i >= j.
+    // Kolumny p0..p1-1 są już rozłożone; iloczyn liczony jest kafelkami kolumn przez GEMM.
+    void update_columns(SymmetricMatrix& L, int j0, int j1, int p0, int p1, CholeskyWorkspace& w) {
+        const int n = L.size();
+        const int m = n - j0;
+        const int kb = p1 - p0;
+        if (m == 0 || j1 <= j0 || kb == 0) {
+            return;
+        }
+        // P: wiersze j0..n-1 kolumn panelu (row-major m x kb), PT: to samo transponowane (kb x m)
+        w.P.resize(static_cast<std::size_t>(m) * kb);
+        w.PT.resize(static_cast<std::size_t>(kb) * m);
+        for (int c = 0; c < kb; ++c) {
+            const double* col = L.column(p0 + c) + (j0 - p0 - c);
+            std::copy(col, col + m, w.PT.data() + static_cast<std::size_t>(c) * m);
+            for (int r = 0; r < m; ++r) {
+                w.P[static_cast<std::size_t>(r) * kb + c] = col[r];
+            }
+        }
+        // Kafelek liczony jest w transpozycji (T: jb x rows, wiersz c to kolumna t0 + c od wiersza t0),
+        // dzięki czemu kopiowanie do i z kolumn spakowanego trójkąta odbywa się ciągłymi blokami
+        for (int t0 = j0; t0 < j1; t0 += CHOLESKY_TILE_WIDTH) {
+            const int jb = std::min(CHOLESKY_TILE_WIDTH, j1 - t0);
+            const int rows = n - t0;
+            w.T.resize(static_cast<std::size_t>(jb) * rows);
+            for (int c = 0; c < jb; ++c) {
+                const double* col = L.column(t0 + c);
+                std::copy(col, col + (rows - c), w.T.data() + static_cast<std::size_t>(c) * rows + c);
+            }
+            kernels::gemm_accumulate(jb, rows, kb, -1.0,
+                                     w.P.data() + static_cast<std::size_t>(t0 - j0) * kb, kb,
+                                     w.PT.data() + (t0 - j0), m,
+                                     w.T.data(), rows);
+            for (int c = 0; c < jb; ++c) {
+                const double* src = w.T.data() + static_cast<std::size_t>(c) * rows + c;
+                std::copy(src, src + (rows - c), L.column(t0 + c));
+            }
+        }
+    }
+
+    // Rozkład kolumn k0..k1-1 (wraz ze wszystkimi wierszami pod nimi), gdy wkład kolumn < k0 jest już
+    // odjęty. Panel dzielony jest rekurencyjnie na połowy, aby większość pracy wykonał GEMM.
+    // Zwraca false, jeśli macierz nie jest dodatnio określona.
+    bool factor_panel(SymmetricMatrix& L, int k0, int k1, CholeskyWorkspace& w) {
+        const int n = L.size();
+        if (k1 - k0 <= CHOLESKY_PANEL_BASE) {
+            // Wariant lewostronny: kolumna j pomniejszana o wcześniejsze kolumny panelu, potem skalowana
+            for (int j = k0; j < k1; ++j) {
+                double* col_j = L.column(j);
+                for (int p = k0; p < j; ++p) {
+                    const double* col_p = L.column(p) + (j - p);
+                    axpy(n - j, -col_p[0], col_p, col_j);
+                }
+                if (!(col_j[0] > PIVOT_TOLERANCE)) {
+                    return false;
+                }
+                col_j[0] = std::sqrt(col_j[0]);
+                const double inv = 1.0 / col_j[0];
+                for (int i = 1; i < n - j; ++i) {
+                    col_j[i] *= inv;
+                }
+            }
+            return true;
+        }
+        const int mid = k0 + (k1 - k0) / 2;
+        if (!factor_panel(L, k0, mid, w)) {
+            return false;
+        }
+        update_columns(L, mid, k1, k0, mid, w);
+        return factor_panel(L, mid, k1, w);
+    }
+} // anonymous namespace
+
+// --- SymmetricMatrix ---
+
+SymmetricMatrix::SymmetricMatrix(int n, double value) : n_(n) {
+    if (n < 0) {
+        throw std::invalid_argument("Matrix dimensions must be non-negative.");
+    }
+    data_.assign(static_cast<std::size_t>(n) * (n + 1) / 2, value);
+}
+
+SymmetricMatrix::SymmetricMatrix(const DenseMatrix& A) : SymmetricMatrix(A.rows()) {
+    if (A.rows() != A.cols()) {
+        throw std::invalid_argument("Matrix must be square.");
+    }
+    for (int j = 0; j < n_; ++j) {
+        double* col = column(j);
+        for (int i = j; i < n_; ++i) {
+            col[i - j] = A(i, j);
+        }
+    }
+}
+
+DenseMatrix SymmetricMatrix::to_dense() const {
+    DenseMatrix D(n_, n_);
+    for (int j = 0; j < n_; ++j) {
+        const double* col = column(j);
+        for (int i = j; i < n_; ++i) {
+            D(i, j) = col[i - j];
+            D(j, i) = col[i - j];
+        }
+    }
+    return D;
+}
+
+// --- Blokowa dekompozycja Cholesky'ego ---
+
+CholeskyFactorization::CholeskyFactorization(const DenseMatrix& A) : CholeskyFactorization(SymmetricMatrix(A)) {}
+
+CholeskyFactorization::CholeskyFactorization(SymmetricMatrix A) : l_(std::move(A)) {
+    const int n = l_.size();
+    if (n == 0) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+
+    CholeskyWorkspace workspace;
+    for (int k0 = 0; k0 < n; k0 += CHOLESKY_BLOCK_SIZE) {
+        const int k1 = std::min(n, k0 + CHOLESKY_BLOCK_SIZE);
+        // Panel kolumn k0..k1-1, a następnie A22 -= L21 L21^T (tylko dolny trójkąt)
+        if (!factor_panel(l_, k0, k1, workspace)) {
+            throw std::runtime_error("Matrix is not positive definite, Cholesky decomposition failed.");
+        }
+        update_columns(l_, k1, n, k0, k1, workspace);
+    }
+}
+
+Vector CholeskyFactorization::solve(const Vector& b) const {
+    const int n = size();
+    if (static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    Vector x = b;
+    // L y = b (kolumnami)
+    for (int j = 0; j < n; ++j) {
+        const double* col = l_.column(j);
+        x[j] /= col[0];
+        axpy(n - j - 1, -x[j], col + 1, x.data() + j + 1);
+    }
+    // L^T x = y (iloczyny skalarne z kolumnami)
+    for (int j = n - 1; j >= 0; --j) {
+        const double* col = l_.column(j);
+        double sum = x[j];
+        for (int i = 1; i < n - j; ++i) {
+            sum -= col[i] * x[j + i];
+        }
+        x[j] = sum / col[0];
+    }
+    return x;
+}
+
+// --- Dekompozycja L D L^T z pivotowaniem Buncha-Kaufmana ---
+
+LdltFactorization::LdltFactorization(SymmetricMatrix A) : ld_(std::move(A)) {
+    const int n = ld_.size();
+    if (n == 0) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    pivots_.resize(n);
+    SymmetricMatrix& a = ld_;
+    const double alpha = (1.0 + std::sqrt(17.0)) / 8.0;
+
+    int k = 0;
+    while (k < n) {
+        int step = 1;
+        int kp = k;
+        const double absakk = std::abs(a(k, k));
+
+        // Największy element pozadiagonalny w kolumnie k
+        int imax = k;
+        double colmax = 0.0;
+        for (int i = k + 1; i < n; ++i) {
+            if (std::abs(a(i, k)) > colmax) {
+                colmax = std::abs(a(i, k));
+                imax = i;
+            }
+        }
+        if (std::max(absakk, colmax) < PIVOT_TOLERANCE) {
+            throw std::runtime_error("Matrix is singular, LDL^T decomposition failed.");
+        }
+
+        if (absakk < alpha * colmax) {
+            // Największy element pozadiagonalny w wierszu (i kolumnie) imax
+            double rowmax = 0.0;
+            for (int j = k; j < imax; ++j) {
+                rowmax = std::max(rowmax, std::abs(a(imax, j)));
+            }
+            for (int j = imax + 1; j < n; ++j) {
+                rowmax = std::max(rowmax, std::abs(a(j, imax)));
+            }
+            if (absakk >= alpha * colmax * (colmax / rowmax)) {
+                kp = k;
+            }
+            else if (std::abs(a(imax, imax)) >= alpha * rowmax) {
+                kp = imax;
+            }
+            else {
+                kp = imax;
+                step = 2;
+            }
+        }
+
+        // Symetryczna zamiana wierszy i kolumn kk oraz kp w pozostałej części macierzy
+        const int kk = k + step - 1;
+        if (kp != kk) {
+            for (int j = kp + 1; j < n; ++j) {
+                std::swap(a(j, kk), a(j, kp));
+            }
+            for (int j = kk + 1; j < kp; ++j) {
+                std::swap(a(j, kk), a(kp, j));
+            }
+            std::swap(a(kk, kk), a(kp, kp));
+            if (step == 2) {
+                std::swap(a(k + 1, k), a(kp, k));
+            }
+        }
+
+        if (step == 1) {
+            // A22 -= v v^T / d, potem v := v / d (kolumna L)
+            const double d = a(k, k);
+            if (std::abs(d) < PIVOT_TOLERANCE) {
+                throw std::runtime_error("Matrix is singular, LDL^T decomposition failed.");
+            }
+            const double r1 = 1.0 / d;
+            const double* v = a.column(k) + 1;
+            for (int j = k + 1; j < n; ++j) {
+                const double vj = v[j - k - 1];
+                axpy(n - j, -r1 * vj, v + (j - k - 1), a.column(j));
+            }
+            double* vm = a.column(k) + 1;
+            for (int i = 0; i < n - k - 1; ++i) {
+                vm[i] *= r1;
+            }
+            if (d < 0.0) {
+                ++negative_;
+            }
+            pivots_[k] = kp;
+        }
+        else {
+            // Blok 2 x 2 macierzy D (zawsze nieokreślony: jedna ujemna wartość własna)
+            double d21 = a(k + 1, k);
+            const double d11 = a(k + 1, k + 1) / d21;
+            const double d22 = a(k, k) / d21;
+            const double t = 1.0 / (d11 * d22 - 1.0);
+            d21 = t / d21;
+            double* ck = a.column(k);
+            double* ck1 = a.column(k + 1);
+            for (int j = k + 2; j < n; ++j) {
+                const double wk = d21 * (d11 * ck[j - k] - ck1[j - k - 1]);
+                const double wkp1 = d21 * (d22 * ck1[j - k - 1] - ck[j - k]);
+                double* cj = a.column(j);
+                for (int i = j; i < n; ++i) {
+                    cj[i - j] -= ck[i - k] * wk + ck1[i - k - 1] * wkp1;
+                }
+                ck[j - k] = wk;
+                ck1[j - k - 1] = wkp1;
+            }
+            ++negative_;
+            pivots_[k] = -(kp + 1);
+            pivots_[k + 1] = -(kp + 1);
+        }
+        k += step;
+    }
+}
+
+Vector LdltFactorization::solve(const Vector& b) const {
+    const int n = size();
+    if (static_cast<int>(b.size()) != n) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    const SymmetricMatrix& a = ld_;
+    Vector x = b;
+
+    // L D y = P b
+    int k = 0;
+    while (k < n) {
+        if (pivots_[k] >= 0) {
+            std::swap(x[k], x[pivots_[k]]);
+            const double* col = a.column(k);
+            axpy(n - k - 1, -x[k], col + 1, x.data() + k + 1);
+            x[k] /= col[0];
+            k += 1;
+        }
+        else {
+            std::swap(x[k + 1], x[-pivots_[k] - 1]);
+            const double* ck = a.column(k);
+            const double* ck1 = a.column(k + 1);
+            axpy(n - k - 2, -x[k], ck + 2, x.data() + k + 2);
+            axpy(n - k - 2, -x[k + 1], ck1 + 1, x.data() + k + 2);
+            const double akm1k = ck[1];
+            const double akm1 = ck[0] / akm1k;
+            const double ak = ck1[0] / akm1k;
+            const double denom = akm1 * ak - 1.0;
+            const double bkm1 = x[k] / akm1k;
+            const double bk = x[k + 1] / akm1k;
+            x[k] = (ak * bkm1 - bk) / denom;
+            x[k + 1] = (akm1 * bk - bkm1) / denom;
+            k += 2;
+        }
+    }
+
+    // L^T P x = y
+    k = n - 1;
+    while (k >= 0) {
+        const double* col = a.column(k);
+        double sum = 0.0;
+        for (int i = k + 1; i < n; ++i) {
+            sum += col[i - k] * x[i];
+        }
+        x[k] -= sum;
+        if (pivots_[k] >= 0) {
+            std::swap(x[k], x[pivots_[k]]);
+            k -= 1;
+        }
+        else {
+            const double* prev = a.column(k - 1);
+            double sum_prev = 0.0;
+            for (int i = k + 1; i < n; ++i) {
+                sum_prev += prev[i - k + 1] * x[i];
+            }
+            x[k - 1] -= sum_prev;
+            std::swap(x[k], x[-pivots_[k] - 1]);
+            k -= 2;
+        }
+    }
+    return x;
+}
+
+Vector solve_cholesky(SymmetricMatrix A, const Vector& b) {
+    if (A.size() == 0 || static_cast<int>(b.size()) != A.size()) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    return CholeskyFactorization(std::move(A)).solve(b);
+}
+
+Vector solve_ldlt(SymmetricMatrix A, const Vector& b) {
+    if (A.size() == 0 || static_cast<int>(b.size()) != A.size()) {
+        throw std::invalid_argument("Invalid matrix or vector dimensions.");
+    }
+    return LdltFactorization(std::move(A)).solve(b);
+}
\ No newline at end of file
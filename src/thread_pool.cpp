@@ -0,0 +1,100 @@
+#include "thread_pool.h"
+#include <stdexcept>
+
+int ThreadPool::resolve_thread_count(int requested) {
+    if (requested < 0) {
+        throw std::invalid_argument("Number of threads must be non-negative.");
+    }
+    if (requested == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1 : static_cast<int>(hw);
+    }
+    return requested;
+}
+
+ThreadPool::ThreadPool(int threads) {
+    int total = resolve_thread_count(threads);
+    workers_.reserve(total - 1);
+    for (int i = 1; i < total; ++i) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    task_available_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+        ++pending_;
+    }
+    task_available_.notify_one();
+}
+
+void ThreadPool::run_task(std::function<void()>& task) {
+    try {
+        task();
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+            error_ = std::current_exception();
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--pending_ == 0) {
+        all_done_.notify_all();
+    }
+}
+
+void ThreadPool::worker_loop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            task_available_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return; // stopping_ i brak pracy
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        run_task(task);
+    }
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (pending_ > 0) {
+        if (!tasks_.empty()) {
+            std::function<void()> task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            run_task(task);
+            lock.lock();
+        } else {
+            all_done_.wait(lock);
+        }
+    }
+    if (error_) {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::parallel_for(int count, const std::function<void(int)>& body) {
+    for (int i = 0; i < count; ++i) {
+        submit([&body, i] { body(i); });
+    }
+    wait();
+}
\ No newline at end of file
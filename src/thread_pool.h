@@ -0,0 +1,62 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @file thread_pool.h
+ * @brief Wewnętrzna pula wątków biblioteki (nie jest częścią publicznego API).
+ *
+ * Wątek wywołujący jest traktowany jako jeden z wątków puli: w wait() sam wykonuje
+ * oczekujące zadania, więc pula o rozmiarze 1 nie tworzy żadnych dodatkowych wątków.
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads Łączna liczba wątków (razem z wywołującym); 0 oznacza wszystkie rdzenie.
+     */
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Łączna liczba wątków wykonujących zadania.
+    int size() const { return static_cast<int>(workers_.size()) + 1; }
+
+    /// Dodaje zadanie do kolejki; wykona się najpóźniej w trakcie wait().
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Czeka na zakończenie wszystkich zleconych zadań, pomagając je wykonywać.
+     * @throws Pierwszy wyjątek rzucony przez któreś z zadań.
+     */
+    void wait();
+
+    /// Wykonuje body(i) dla i = 0 .. count-1 równolegle i czeka na zakończenie.
+    void parallel_for(int count, const std::function<void(int)>& body);
+
+    /// Zamienia żądaną liczbę wątków (0 = wszystkie rdzenie) na faktyczną, co najmniej 1.
+    static int resolve_thread_count(int requested);
+
+private:
+    void worker_loop();
+    void run_task(std::function<void()>& task);
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable task_available_;
+    std::condition_variable all_done_;
+    int pending_ = 0;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+};
+
+#endif // THREAD_POOL_H
\ No newline at end of file
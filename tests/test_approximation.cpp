@@ -2,6 +2,7 @@
 #include <iomanip>
 #include <cmath>
 #include <vector>
+#include <algorithm>
 #include <stdexcept> // Do obsługi std::exception
 #include "approximation.h" // Używamy naszej biblioteki
 
@@ -51,6 +52,23 @@ int main() {
         std::cerr << "Caught unexpected error in correct test: " << e.what() << std::endl;
     }
 
+    // --- Wysoki stopień: macierz Grama bliska osobliwości, Cholesky może odrzucić pivot ---
+    std::cout << "\n--- High Degree Test: sin(x) on [1, 3] ---" << std::endl;
+    for (int high_degree : { 10, 11, 14 }) {
+        try {
+            std::vector<double> coeffs = polynomial_approximation([](double x) { return std::sin(x); }, high_degree, 1.0, 3.0);
+            double max_error = 0.0;
+            for (int i = 0; i <= 100; ++i) {
+                const double x_val = 1.0 + 0.02 * i;
+                max_error = std::max(max_error, std::abs(evaluate_polynomial(coeffs, x_val) - std::sin(x_val)));
+            }
+            std::cout << "Degree " << high_degree << ", max error: " << std::scientific << std::setprecision(3) << max_error
+                      << std::fixed << std::setprecision(6) << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << "Caught unexpected error for degree " << high_degree << ": " << e.what() << std::endl;
+        }
+    }
+
     // --- Błędny test: Ujemny stopień wielomianu ---
     std::cout << "\n--- Error Test: Negative Polynomial Degree ---" << std::endl;
     int invalid_degree = -1; // Nieprawidłowy stopień
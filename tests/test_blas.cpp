@@ -0,0 +1,198 @@
+#include <iostream>
+#include <vector>
+#include <iomanip>
+#include <stdexcept>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include "blas.h" // Używamy naszej biblioteki
+
+// Losowa macierz rows x cols o elementach z przedziału [-1, 1] (stałe ziarno dla powtarzalności)
+DenseMatrix random_matrix(int rows, int cols, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    DenseMatrix M(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            M(i, j) = dist(gen);
+        }
+    }
+    return M;
+}
+
+// Element (i, j) macierzy op(A)
+double op_at(const DenseMatrix& A, Transpose t, int i, int j) {
+    return t == Transpose::No ? A(i, j) : A(j, i);
+}
+
+// Największa różnica między dwiema macierzami
+double max_difference(const DenseMatrix& A, const DenseMatrix& B) {
+    double worst = 0.0;
+    for (int i = 0; i < A.rows(); ++i) {
+        for (int j = 0; j < A.cols(); ++j) {
+            worst = std::max(worst, std::abs(A(i, j) - B(i, j)));
+        }
+    }
+    return worst;
+}
+
+const char* name(Transpose t) { return t == Transpose::No ? "N" : "T"; }
+
+int main() {
+    std::cout << "--- Example: Dense BLAS Operations ---" << std::endl;
+    std::cout << std::scientific << std::setprecision(3);
+    const Transpose both[] = { Transpose::No, Transpose::Yes };
+
+    // --- GEMV: porównanie z pętlą referencyjną ---
+    std::cout << "\n--- GEMV Test: 37x53 Matrix, y = 2 op(A) x - 0.5 y ---" << std::endl;
+    try {
+        DenseMatrix A = random_matrix(37, 53, 1);
+        for (Transpose t : both) {
+            const int rows = t == Transpose::No ? 37 : 53;
+            const int cols = t == Transpose::No ? 53 : 37;
+            Vector x(cols), y(rows, 1.0), expected(rows);
+            for (int j = 0; j < cols; ++j) x[j] = std::sin(j + 1.0);
+            for (int i = 0; i < rows; ++i) {
+                double sum = 0.0;
+                for (int j = 0; j < cols; ++j) sum += op_at(A, t, i, j) * x[j];
+                expected[i] = 2.0 * sum - 0.5 * y[i];
+            }
+            gemv(t, 2.0, A.view(), x, -0.5, y);
+            double worst = 0.0;
+            for (int i = 0; i < rows; ++i) worst = std::max(worst, std::abs(y[i] - expected[i]));
+            std::cout << "gemv(" << name(t) << ") max error: " << worst << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- GEMM: wszystkie kombinacje transpozycji, wymiary niebędące wielokrotnością kafelków ---
+    std::cout << "\n--- GEMM Test: C (67x51) = op(A) op(B) + 2 C with k = 45 ---" << std::endl;
+    try {
+        const int m = 67, n = 51, k = 45;
+        for (Transpose ta : both) {
+            for (Transpose tb : both) {
+                DenseMatrix A = ta == Transpose::No ? random_matrix(m, k, 2) : random_matrix(k, m, 2);
+                DenseMatrix B = tb == Transpose::No ? random_matrix(k, n, 3) : random_matrix(n, k, 3);
+                DenseMatrix C = random_matrix(m, n, 4);
+                DenseMatrix expected(m, n);
+                for (int i = 0; i < m; ++i) {
+                    for (int j = 0; j < n; ++j) {
+                        double sum = 0.0;
+                        for (int p = 0; p < k; ++p) sum += op_at(A, ta, i, p) * op_at(B, tb, p, j);
+                        expected(i, j) = sum + 2.0 * C(i, j);
+                    }
+                }
+                gemm(ta, tb, 1.0, A.view(), B.view(), 2.0, C.view());
+                std::cout << "gemm(" << name(ta) << name(tb) << ") max error: " << max_difference(C, expected) << std::endl;
+            }
+        }
+
+        DenseMatrix A = random_matrix(300, 200, 5);
+        DenseMatrix B = random_matrix(200, 250, 6);
+        DenseMatrix AB = multiply(A, B);
+        double worst = 0.0;
+        for (int i = 0; i < 300; i += 37) {
+            for (int j = 0; j < 250; j += 29) {
+                double sum = 0.0;
+                for (int p = 0; p < 200; ++p) sum += A(i, p) * B(p, j);
+                worst = std::max(worst, std::abs(AB(i, j) - sum));
+            }
+        }
+        std::cout << "multiply(300x200, 200x250) sampled max error: " << worst << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- TRSV i TRSM: x = op(T)^{-1} (op(T) x_true) dla wszystkich wariantów ---
+    std::cout << "\n--- TRSV/TRSM Test: Triangular Solves with n = 150 ---" << std::endl;
+    try {
+        const int n = 150, nrhs = 7;
+        DenseMatrix T = random_matrix(n, n, 7);
+        // Małe elementy poza przekątną: macierz trójkątna (również z jedynkami) jest dobrze uwarunkowana
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                T(i, j) = i == j ? 2.0 + std::abs(T(i, j)) : 0.1 * T(i, j);
+            }
+        }
+        const Triangle triangles[] = { Triangle::Lower, Triangle::Upper };
+        const Diagonal diagonals[] = { Diagonal::NonUnit, Diagonal::Unit };
+        for (Triangle uplo : triangles) {
+            for (Transpose t : both) {
+                for (Diagonal diag : diagonals) {
+                    // Element (i, j) macierzy op(T) ograniczonej do wybranego trójkąta
+                    const auto tri = [&](int i, int j) {
+                        const int r = t == Transpose::No ? i : j;
+                        const int c = t == Transpose::No ? j : i;
+                        if (r == c) return diag == Diagonal::Unit ? 1.0 : T(r, c);
+                        const bool inside = uplo == Triangle::Lower ? c < r : c > r;
+                        return inside ? T(r, c) : 0.0;
+                    };
+                    Vector x_true(n), x(n, 0.0);
+                    DenseMatrix X_true = random_matrix(n, nrhs, 8), X(n, nrhs);
+                    for (int i = 0; i < n; ++i) x_true[i] = std::cos(i + 1.0);
+                    for (int i = 0; i < n; ++i) {
+                        for (int j = 0; j < n; ++j) {
+                            x[i] += tri(i, j) * x_true[j];
+                            for (int c = 0; c < nrhs; ++c) X(i, c) += tri(i, j) * X_true(j, c);
+                        }
+                    }
+                    trsv(uplo, t, diag, T.view(), x);
+                    trsm(uplo, t, diag, T.view(), X.view());
+                    double worst = 0.0;
+                    for (int i = 0; i < n; ++i) worst = std::max(worst, std::abs(x[i] - x_true[i]));
+                    std::cout << (uplo == Triangle::Lower ? "lower" : "upper") << " " << name(t)
+                              << (diag == Diagonal::Unit ? " unit    " : " non-unit")
+                              << "  trsv error: " << worst << "  trsm error: " << max_difference(X, X_true) << std::endl;
+                }
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Operacje na fragmencie większej macierzy (widok z innym stride) ---
+    std::cout << "\n--- View Test: GEMV on a Sub-Block ---" << std::endl;
+    try {
+        DenseMatrix A = {
+            {1, 2, 3, 4},
+            {5, 6, 7, 8},
+            {9, 10, 11, 12}
+        };
+        Vector x = { 1, 1 };
+        Vector y(2);
+        gemv(Transpose::No, 1.0, A.block(1, 2, 2, 2), x, 0.0, y);
+        std::cout << std::fixed << std::setprecision(4);
+        std::cout << "y = [ " << y[0] << " " << y[1] << " ] (expected [15 23])" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Błędne przypadki ---
+    std::cout << "\n--- Erroneous Test: Mismatched Dimensions ---" << std::endl;
+    try {
+        DenseMatrix A(3, 4), B(3, 4), C(3, 4);
+        gemm(Transpose::No, Transpose::No, 1.0, A.view(), B.view(), 0.0, C.view());
+        std::cout << "Unexpected success." << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting a triangular solve with a non-square matrix:" << std::endl;
+    try {
+        DenseMatrix T(3, 4, 1.0);
+        Vector x(3, 1.0);
+        trsv(Triangle::Lower, Transpose::No, Diagonal::NonUnit, T.view(), x);
+        std::cout << "Unexpected success." << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
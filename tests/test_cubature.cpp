@@ -0,0 +1,143 @@
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <cmath>
+#include <vector>
+#include "cubature.h" // Używamy naszej biblioteki
+
+const double PI = 3.14159265358979323846;
+
+// exp(x_1 + ... + x_d) na [0, 1]^d: całka (e - 1)^d
+double exp_sum(const double* x, int d) {
+    double s = 0.0;
+    for (int k = 0; k < d; ++k) s += x[k];
+    return std::exp(s);
+}
+
+// Iloczyn (pi / 2) sin(pi x_k) na [0, 1]^d: całka 1
+double sine_product(const double* x, int d) {
+    double p = 1.0;
+    for (int k = 0; k < d; ++k) p *= 0.5 * PI * std::sin(PI * x[k]);
+    return p;
+}
+
+void print_result(const std::string& name, const CubatureResult& r, double exact) {
+    std::cout << name << ": " << std::fixed << std::setprecision(10) << r.value << std::scientific << std::setprecision(3)
+              << ", error " << std::abs(r.value - exact) << ", estimate " << r.error_estimate
+              << ", evaluations " << r.evaluations << std::endl;
+}
+
+int main() {
+    std::cout << "--- Example: Multidimensional Cubature ---" << std::endl;
+
+    // --- Iloczyn tensorowy kwadratur Gaussa ---
+    std::cout << "\n--- Tensor-Product Gauss-Legendre ---" << std::endl;
+    try {
+        const int d = 3;
+        MultivariateFunction f = [](const double* x) { return exp_sum(x, 3); };
+        std::vector<double> lower(d, 0.0), upper(d, 1.0);
+        const double exact = std::pow(std::exp(1.0) - 1.0, d);
+        print_result("exp(x + y + z), 5 nodes", tensor_gauss_cubature(f, lower, upper, 5), exact);
+
+        // Dokładność dla wielomianów stopnia 2n - 1 względem każdej zmiennej, przedział niesymetryczny
+        MultivariateFunction poly = [](const double* x) { return std::pow(x[0], 5) * std::pow(x[1], 3); };
+        CubatureResult p = tensor_gauss_cubature(poly, { -1.0, 0.0 }, { 2.0, 3.0 }, 3);
+        print_result("x^5 y^3 on [-1, 2] x [0, 3], 3 nodes", p, (64.0 - 1.0) / 6.0 * 81.0 / 4.0);
+
+        CubatureResult serial = tensor_gauss_cubature(f, lower, upper, 20, 1);
+        CubatureResult parallel = tensor_gauss_cubature(f, lower, upper, 20, 4);
+        std::cout << "20^3 nodes, 1 and 4 threads bit-identical: " << (serial.value == parallel.value ? "yes" : "no") << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Siatki rzadkie Smolyaka ---
+    std::cout << "\n--- Smolyak Sparse Grids ---" << std::endl;
+    try {
+        // Stopień całkowity 5 w 4 wymiarach: poziom 3 jest dokładny
+        MultivariateFunction poly = [](const double* x) { return x[0] * x[0] * x[1] * x[2] * x[3] + x[3] * x[3] * x[3] * x[3]; };
+        print_result("Degree-5 polynomial in 4-D, level 3",
+                     sparse_grid_cubature(poly, std::vector<double>(4, 0.0), std::vector<double>(4, 1.0), 3), 1.0 / 24.0 + 0.2);
+
+        const int d = 6;
+        MultivariateFunction f = [](const double* x) { return exp_sum(x, 6); };
+        std::vector<double> lower(d, 0.0), upper(d, 1.0);
+        const double exact = std::pow(std::exp(1.0) - 1.0, d);
+        for (int level = 2; level <= 6; level += 2) {
+            print_result("exp(sum x) in 6-D, level " + std::to_string(level), sparse_grid_cubature(f, lower, upper, level), exact);
+        }
+        print_result("Tensor Gauss in 6-D, 4 nodes     ", tensor_gauss_cubature(f, lower, upper, 4), exact);
+
+        CubatureResult serial = sparse_grid_cubature(f, lower, upper, 5, 1);
+        CubatureResult parallel = sparse_grid_cubature(f, lower, upper, 5, 3);
+        std::cout << "Level 5, 1 and 3 threads bit-identical: " << (serial.value == parallel.value ? "yes" : "no") << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Quasi-Monte Carlo ---
+    std::cout << "\n--- Quasi-Monte Carlo (8-D) ---" << std::endl;
+    try {
+        const int d = 8;
+        MultivariateFunction f = [](const double* x) { return sine_product(x, 8); };
+        std::vector<double> lower(d, 0.0), upper(d, 1.0);
+        for (long long n : { 1LL << 13, 1LL << 17 }) {
+            print_result("Sobol,  " + std::to_string(n) + " points", quasi_monte_carlo_cubature(f, lower, upper, n), 1.0);
+            print_result("Halton, " + std::to_string(n) + " points",
+                         quasi_monte_carlo_cubature(f, lower, upper, n, QmcSequence::Halton), 1.0);
+        }
+        CubatureResult serial = quasi_monte_carlo_cubature(f, lower, upper, 1 << 15, QmcSequence::Sobol, 1);
+        CubatureResult parallel = quasi_monte_carlo_cubature(f, lower, upper, 1 << 15, QmcSequence::Sobol, 0);
+        std::cout << "Sobol, 1 thread and all cores bit-identical: " << (serial.value == parallel.value ? "yes" : "no") << std::endl;
+
+        // Przedział niejednostkowy: średnia z x_1 x_2 na [1, 3] x [-2, 0] razy pole 4
+        MultivariateFunction g = [](const double* x) { return x[0] * x[1]; };
+        print_result("x y on [1, 3] x [-2, 0], Sobol", quasi_monte_carlo_cubature(g, { 1.0, -2.0 }, { 3.0, 0.0 }, 1 << 12), -8.0);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Błędne przypadki ---
+    MultivariateFunction one = [](const double*) { return 1.0; };
+
+    std::cout << "\nAttempting cubature with mismatched bounds:" << std::endl;
+    try {
+        CubatureResult r = tensor_gauss_cubature(one, { 0.0, 0.0 }, { 1.0 }, 3);
+        std::cout << "Unexpected success: " << r.value << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting a sparse grid of level 0:" << std::endl;
+    try {
+        CubatureResult r = sparse_grid_cubature(one, { 0.0 }, { 1.0 }, 0);
+        std::cout << "Unexpected success: " << r.value << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting a Sobol sequence in 17 dimensions:" << std::endl;
+    try {
+        CubatureResult r = quasi_monte_carlo_cubature(one, std::vector<double>(17, 0.0), std::vector<double>(17, 1.0), 1024);
+        std::cout << "Unexpected success: " << r.value << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting quasi-Monte Carlo with too few points:" << std::endl;
+    try {
+        CubatureResult r = quasi_monte_carlo_cubature(one, { 0.0 }, { 1.0 }, 4);
+        std::cout << "Unexpected success: " << r.value << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include <iostream>
+#include <vector>
+#include <iomanip>
+#include <stdexcept>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include "eigen_solvers.h" // Używamy naszej biblioteki
+#include "sparse_matrix.h"
+
+const double PI = 3.14159265358979323846;
+
+// Losowa macierz symetryczna n x n o elementach z przedziału [-1, 1] (stałe ziarno dla powtarzalności)
+DenseMatrix random_symmetric(int n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    DenseMatrix M(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            M(i, j) = M(j, i) = dist(gen);
+        }
+    }
+    return M;
+}
+
+// Największe residuum ||A z_k - lambda_k z_k||_inf po wszystkich parach
+double max_eigen_residual(const LinearOperator& A, const EigenPairs& pairs) {
+    const int n = A.size();
+    Vector z(n), Az(n);
+    double worst = 0.0;
+    for (int k = 0; k < static_cast<int>(pairs.values.size()); ++k) {
+        for (int i = 0; i < n; ++i) z[i] = pairs.vectors(i, k);
+        A.apply(z.data(), Az.data());
+        for (int i = 0; i < n; ++i) {
+            worst = std::max(worst, std::abs(Az[i] - pairs.values[k] * z[i]));
+        }
+    }
+    return worst;
+}
+
+// max |Z^T Z - I| dla kolumn macierzy Z
+double orthogonality_error(const DenseMatrix& Z) {
+    double worst = 0.0;
+    for (int a = 0; a < Z.cols(); ++a) {
+        for (int b = 0; b < Z.cols(); ++b) {
+            double s = 0.0;
+            for (int i = 0; i < Z.rows(); ++i) s += Z(i, a) * Z(i, b);
+            worst = std::max(worst, std::abs(s - (a == b ? 1.0 : 0.0)));
+        }
+    }
+    return worst;
+}
+
+// Macierz 5-punktowego laplasjanu na siatce mx x my
+SparseMatrix poisson_2d(int mx, int my) {
+    std::vector<Triplet> t;
+    for (int i = 0; i < mx; ++i) {
+        for (int j = 0; j < my; ++j) {
+            int row = i * my + j;
+            t.push_back({ row, row, 4.0 });
+            if (i > 0) t.push_back({ row, row - my, -1.0 });
+            if (i < mx - 1) t.push_back({ row, row + my, -1.0 });
+            if (j > 0) t.push_back({ row, row - 1, -1.0 });
+            if (j < my - 1) t.push_back({ row, row + 1, -1.0 });
+        }
+    }
+    return SparseMatrix::from_triplets(mx * my, mx * my, t);
+}
+
+void print_values(const Vector& values, const std::string& name) {
+    std::cout << name << ": [ ";
+    for (double v : values) std::cout << v << " ";
+    std::cout << "]" << std::endl;
+}
+
+int main() {
+    std::cout << "--- Example: Eigenvalues of Symmetric Matrices ---" << std::endl;
+    std::cout << std::fixed << std::setprecision(6);
+
+    // --- Rozkład gęsty: macierz o znanym widmie ---
+    std::cout << "\n--- Dense Test: 1-D Laplacian (n = 3) ---" << std::endl;
+    try {
+        DenseMatrix L = {
+            {2, -1, 0},
+            {-1, 2, -1},
+            {0, -1, 2}
+        };
+        EigenPairs pairs = symmetric_eigen(L);
+        print_values(pairs.values, "Eigenvalues");
+        std::cout << "Expected:    [ " << 2.0 - std::sqrt(2.0) << " 2.000000 " << 2.0 + std::sqrt(2.0) << " ]" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- Dense Test: Random Symmetric 300x300 Matrix ---" << std::endl;
+    try {
+        DenseMatrix R = random_symmetric(300, 7);
+        EigenPairs pairs = symmetric_eigen(R);
+        EigenPairs values_only = symmetric_eigen(R, false);
+        double max_diff = 0.0, trace = 0.0, sum = 0.0;
+        for (int k = 0; k < 300; ++k) {
+            max_diff = std::max(max_diff, std::abs(pairs.values[k] - values_only.values[k]));
+            trace += R(k, k);
+            sum += pairs.values[k];
+        }
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Max residual |Az - lambda z|: " << max_eigen_residual(LinearOperator(R), pairs) << std::endl;
+        std::cout << "Orthogonality error |Z^T Z - I|: " << orthogonality_error(pairs.vectors) << std::endl;
+        std::cout << "Values-only vs. full decomposition: " << max_diff << std::endl;
+        std::cout << "|trace - sum of eigenvalues|: " << std::abs(trace - sum) << std::endl;
+        std::cout << std::fixed << std::setprecision(6);
+        std::cout << "Sorted ascending: " << (std::is_sorted(pairs.values.begin(), pairs.values.end()) ? "yes" : "no")
+                  << ", QL iterations: " << pairs.iterations << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Lanczos: skrajne wartości własne laplasjanu 2D (widmo znane analitycznie) ---
+    std::cout << "\n--- Lanczos Test: Poisson 2D (40x37, n = 1480) ---" << std::endl;
+    try {
+        // Siatka prostokątna: widmo bez wielokrotnych wartości własnych
+        const int mx = 40, my = 37;
+        SparseMatrix P = poisson_2d(mx, my);
+        LinearOperator op(P);
+        std::vector<double> exact;
+        for (int i = 1; i <= mx; ++i) {
+            for (int j = 1; j <= my; ++j) {
+                exact.push_back(4.0 - 2.0 * std::cos(i * PI / (mx + 1)) - 2.0 * std::cos(j * PI / (my + 1)));
+            }
+        }
+        std::sort(exact.begin(), exact.end());
+
+        EigenPairs largest = lanczos_eigen(op, 4, EigenTarget::Largest);
+        EigenPairs smallest = lanczos_eigen(op, 4, EigenTarget::Smallest);
+        print_values(largest.values, "Largest 4 ");
+        print_values(Vector(exact.rbegin(), exact.rbegin() + 4), "Expected   ");
+        print_values(smallest.values, "Smallest 4");
+        print_values(Vector(exact.begin(), exact.begin() + 4), "Expected   ");
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Max residual (largest): " << max_eigen_residual(op, largest)
+                  << ", (smallest): " << max_eigen_residual(op, smallest) << std::endl;
+        std::cout << "Orthogonality error: " << orthogonality_error(smallest.vectors) << std::endl;
+        std::cout << std::fixed << std::setprecision(6);
+        std::cout << "Operator applications: " << largest.iterations << " (largest), "
+                  << smallest.iterations << " (smallest)" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- Lanczos Test: Matrix-Free Operator and Small Dense Operator ---" << std::endl;
+    try {
+        // Najmniejsza wartość własna 1-D laplasjanu: 2 - 2 cos(pi / (n + 1))
+        const int n = 200;
+        LinearOperator laplace(n, [n](const double* x, double* y) {
+            for (int i = 0; i < n; ++i) {
+                y[i] = 2.0 * x[i] - (i > 0 ? x[i - 1] : 0.0) - (i < n - 1 ? x[i + 1] : 0.0);
+            }
+        });
+        EigenPairs lowest = lanczos_eigen(laplace, 1, EigenTarget::Smallest, 1e-10, 20000);
+        std::cout << std::scientific << std::setprecision(8);
+        std::cout << "Smallest eigenvalue: " << lowest.values[0]
+                  << " (expected " << 2.0 - 2.0 * std::cos(PI / (n + 1)) << ")" << std::endl;
+        std::cout << std::fixed << std::setprecision(6);
+
+        // Przestrzeń Kryłowa wypełnia całą przestrzeń: wynik dokładny jak dla rozkładu gęstego
+        DenseMatrix R = random_symmetric(10, 3);
+        EigenPairs all = lanczos_eigen(LinearOperator(R), 10, EigenTarget::Smallest);
+        EigenPairs dense = symmetric_eigen(R, false);
+        double max_diff = 0.0;
+        for (int k = 0; k < 10; ++k) max_diff = std::max(max_diff, std::abs(all.values[k] - dense.values[k]));
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Full spectrum of a 10x10 matrix, max difference vs. dense: " << max_diff << std::endl;
+        std::cout << std::fixed << std::setprecision(6);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Metoda potęgowa: macierz niesymetryczna ---
+    std::cout << "\n--- Power Iteration Test: Nonsymmetric Matrix ---" << std::endl;
+    try {
+        DenseMatrix N = {
+            {4, 1, 0},
+            {2, 3, 0},
+            {0, 1, 1}
+        };
+        EigenPairs dominant = power_iteration(LinearOperator(N));
+        std::cout << "Dominant eigenvalue: " << dominant.values[0] << " (expected 5) after "
+                  << dominant.iterations << " iterations" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Błędne przypadki ---
+    std::cout << "\nAttempting the dense eigensolver on a non-square matrix:" << std::endl;
+    try {
+        EigenPairs pairs = symmetric_eigen(DenseMatrix(2, 3));
+        std::cout << "Unexpected success: " << pairs.values.size() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting Lanczos with more eigenpairs than the operator size:" << std::endl;
+    try {
+        EigenPairs pairs = lanczos_eigen(LinearOperator(DenseMatrix{ {1, 0}, {0, 2} }), 3);
+        std::cout << "Unexpected success: " << pairs.values.size() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting Lanczos with an iteration limit too small:" << std::endl;
+    try {
+        EigenPairs pairs = lanczos_eigen(LinearOperator(poisson_2d(30, 30)), 2, EigenTarget::Smallest, 1e-12, 30);
+        std::cout << "Unexpected success: " << pairs.values.size() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include <iomanip>
 #include <limits> // Required for std::numeric_limits
 #include <stdexcept> // Required for std::invalid_argument (if using exceptions)
+#include <functional>
+#include <thread>
+#include <vector>
+#include <algorithm>
 #include "integration.h" // Use our library
 
 // Test function
@@ -37,6 +41,442 @@ int main() {
     std::cout << "Gauss-Legendre (" << gl_nodes << " nodes, " << gl_subintervals << " sub): " << result_gl 
               << ", Error: " << std::abs(exact_f1 - result_gl) << std::endl;
 
+    // --- Template and Batch Overloads ---
+    std::cout << "\n--- Template and Batch Overloads ---" << std::endl;
+    {
+        // Lambda passed directly: the template overload is used and the call is inlined
+        auto poly = [](double x) { return 3.0 * x * x - 2.0 * x + 1.0; };
+        double exact_poly = 6.0; // integral of 3x^2 - 2x + 1 over [0, 2] = 8 - 4 + 2
+        std::cout << "Simpson (lambda): " << simpson_rule(poly, 0.0, 2.0, 10)
+                  << ", Error: " << std::abs(simpson_rule(poly, 0.0, 2.0, 10) - exact_poly) << std::endl;
+        std::cout << "Gauss-Legendre (lambda, 2 nodes, 1 sub): " << gauss_legendre_quadrature(poly, 0.0, 2.0, 2, 1)
+                  << ", Error: " << std::abs(gauss_legendre_quadrature(poly, 0.0, 2.0, 2, 1) - exact_poly) << std::endl;
+
+        // Batch callback: one call fills a whole block of function values
+        int batch_calls = 0;
+        auto f1_batch = [&batch_calls](const double* x, double* fx, int count) {
+            ++batch_calls;
+            for (int i = 0; i < count; ++i) {
+                fx[i] = f1(x[i]);
+            }
+        };
+        std::function<double(double)> f1_function = f1;
+        double diff_rect = std::abs(rectangle_rule(f1_batch, a, b, intervals) - rectangle_rule(f1_function, a, b, intervals));
+        double diff_trap = std::abs(trapezoid_rule(f1_batch, a, b, intervals) - trapezoid_rule(f1_function, a, b, intervals));
+        double diff_simp = std::abs(simpson_rule(f1_batch, a, b, intervals) - simpson_rule(f1_function, a, b, intervals));
+        double diff_gl = std::abs(gauss_legendre_quadrature(f1_batch, a, b, gl_nodes, gl_subintervals) -
+                                  gauss_legendre_quadrature(f1_function, a, b, gl_nodes, gl_subintervals));
+        std::cout << "Batch vs. std::function difference (rect, trap, simpson, gauss): "
+                  << diff_rect << " " << diff_trap << " " << diff_simp << " " << diff_gl << std::endl;
+        batch_calls = 0;
+        double result_batch = simpson_rule(f1_batch, a, b, intervals);
+        std::cout << "Simpson (batch): " << result_batch << ", Error: " << std::abs(exact_f1 - result_batch)
+                  << ", callback calls: " << batch_calls << " for " << intervals + 1 << " nodes" << std::endl;
+    }
+
+    // --- Arbitrary-Order Gauss-Legendre Rules ---
+    std::cout << "\n--- Arbitrary-Order Gauss-Legendre Rules ---" << std::endl;
+    try {
+        // A 4-node rule must match the closed-form nodes used before
+        const GaussRule& g4 = gauss_legendre_rule(4);
+        double closed_form = std::sqrt((3.0 + 2.0 * std::sqrt(6.0 / 5.0)) / 7.0);
+        std::cout << "4 nodes, largest node error: " << std::scientific << std::setprecision(2)
+                  << std::abs(g4.nodes[3] - closed_form) << ", weight error: "
+                  << std::abs(g4.weights[3] - (18.0 - std::sqrt(30.0)) / 36.0) << std::endl;
+
+        // An n-node rule integrates x^(2n-2) exactly: integral over [-1, 1] is 2 / (2n - 1)
+        for (int n : { 20, 64, 200 }) {
+            const GaussRule& g = gauss_legendre_rule(n);
+            double weight_sum = 0.0, moment = 0.0;
+            for (int i = 0; i < n; ++i) {
+                weight_sum += g.weights[i];
+                moment += g.weights[i] * std::pow(g.nodes[i], 2 * n - 2);
+            }
+            std::cout << n << " nodes: |sum(w) - 2| = " << std::abs(weight_sum - 2.0)
+                      << ", |x^" << 2 * n - 2 << " moment error| = " << std::abs(moment - 2.0 / (2 * n - 1)) << std::endl;
+        }
+
+        // Repeated requests (also from several threads) return the same cached rule
+        const GaussRule* cached = &gauss_legendre_rule(20);
+        std::vector<const GaussRule*> seen(4, nullptr);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([t, &seen] { seen[t] = &gauss_legendre_rule(t % 2 == 0 ? 20 : 33); });
+        }
+        for (std::thread& th : threads) th.join();
+        std::cout << "Cached rule reused across threads: "
+                  << (seen[0] == cached && seen[2] == cached && seen[1] == seen[3] ? "yes" : "no") << std::endl;
+
+        double result_g20 = gauss_legendre_quadrature(f1, a, b, 20, 4);
+        std::cout << "Gauss-Legendre (20 nodes, 4 sub), Error: " << std::abs(exact_f1 - result_g20) << std::endl;
+        std::cout << std::fixed << std::setprecision(10);
+    } catch (const std::exception& e) {
+        std::cout << "Caught unexpected exception: " << e.what() << std::endl;
+    }
+
+    // --- Adaptive Gauss-Kronrod ---
+    std::cout << "\n--- Adaptive Gauss-Kronrod ---" << std::endl;
+    try {
+        QuadratureResult r15 = adaptive_gauss_kronrod(f1, a, b, 1e-12, 1e-12, KronrodRule::GK15);
+        QuadratureResult r21 = adaptive_gauss_kronrod(f1, a, b, 1e-12, 1e-12, KronrodRule::GK21);
+        std::cout << "G7/K15:  " << r15.value << ", Error: " << std::abs(exact_f1 - r15.value)
+                  << ", estimate: " << std::scientific << std::setprecision(2) << r15.error_estimate << std::fixed
+                  << std::setprecision(10) << ", evaluations: " << r15.evaluations << std::endl;
+        std::cout << "G10/K21: " << r21.value << ", Error: " << std::abs(exact_f1 - r21.value)
+                  << ", estimate: " << std::scientific << std::setprecision(2) << r21.error_estimate << std::fixed
+                  << std::setprecision(10) << ", evaluations: " << r21.evaluations << std::endl;
+
+        // Narrow peak: subintervals concentrate around x = 0
+        double eps_peak = 1e-4;
+        auto peak = [eps_peak](double x) { return 1.0 / (eps_peak + x * x); };
+        double exact_peak = 2.0 / std::sqrt(eps_peak) * std::atan(1.0 / std::sqrt(eps_peak));
+        QuadratureResult rp = adaptive_gauss_kronrod(peak, -1.0, 1.0, 0.0, 1e-10);
+        std::cout << "Peak 1/(1e-4 + x^2): " << rp.value << ", Relative error: " << std::scientific << std::setprecision(2)
+                  << std::abs(rp.value - exact_peak) / exact_peak << std::fixed << std::setprecision(10)
+                  << ", evaluations: " << rp.evaluations << ", subintervals: " << rp.subintervals << std::endl;
+        double simpson_peak = simpson_rule(peak, -1.0, 1.0, rp.evaluations);
+        std::cout << "Simpson with the same number of nodes, Relative error: " << std::scientific << std::setprecision(2)
+                  << std::abs(simpson_peak - exact_peak) / exact_peak << std::fixed << std::setprecision(10) << std::endl;
+
+        // Integrable endpoint singularity (Kronrod nodes never touch the endpoints)
+        QuadratureResult rs = adaptive_gauss_kronrod([](double x) { return 1.0 / std::sqrt(x); }, 0.0, 1.0, 1e-10, 0.0);
+        std::cout << "1/sqrt(x) on [0, 1]: " << rs.value << ", Error: " << std::abs(rs.value - 2.0)
+                  << ", evaluations: " << rs.evaluations << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << "Caught unexpected exception: " << e.what() << std::endl;
+    }
+
+    std::cout << "Attempting adaptive quadrature with a subinterval limit too small: ";
+    try {
+        QuadratureResult r = adaptive_gauss_kronrod([](double x) { return 1.0 / (1e-6 + x * x); }, -1.0, 1.0,
+                                                    1e-14, 1e-14, KronrodRule::GK15, 5);
+        std::cout << "Unexpected result: " << r.value << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    std::cout << "Attempting adaptive quadrature of a NaN integrand: ";
+    try {
+        QuadratureResult r = adaptive_gauss_kronrod([](double) { return std::nan(""); }, 0.0, 1.0, 1e-10, 1e-10);
+        std::cout << "Unexpected result: " << r.value << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    std::cout << "Attempting adaptive quadrature of 1/x on [-1, 1] (infinite at the centre node): ";
+    try {
+        QuadratureResult r = adaptive_gauss_kronrod([](double x) { return 1.0 / x; }, -1.0, 1.0, 1e-10, 1e-10);
+        std::cout << "Unexpected result: " << r.value << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    std::cout << "Attempting adaptive quadrature with zero tolerances: ";
+    try {
+        QuadratureResult r = adaptive_gauss_kronrod(f1, a, b, 0.0, 0.0);
+        std::cout << "Unexpected result: " << r.value << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    // --- Many Integrands on a Shared Grid ---
+    std::cout << "\n--- Many Integrands on a Shared Grid ---" << std::endl;
+    {
+        // Momenty x^k, k = 0..5, na [0, 1] (dokładnie 1 / (k + 1)) oraz f1 jako ostatnia składowa
+        const int count = 7;
+        int calls = 0;
+        auto moments = [&calls](double x, double* fx) {
+            ++calls;
+            double power = 1.0;
+            for (int k = 0; k < 6; ++k) {
+                fx[k] = power;
+                power *= x;
+            }
+            fx[6] = f1(x);
+        };
+        std::vector<double> gl = gauss_legendre_quadrature_multi(moments, count, 0.0, 1.0, 4, 1);
+        double max_err = 0.0;
+        for (int k = 0; k < 6; ++k) max_err = std::max(max_err, std::abs(gl[k] - 1.0 / (k + 1)));
+        std::cout << "Gauss-Legendre (4 nodes) moments 0..5, max error: " << std::scientific << max_err
+                  << std::fixed << ", function calls: " << calls << std::endl;
+
+        std::vector<double> simp = simpson_rule_multi(moments, count, a, b, 1000);
+        std::vector<double> trap = trapezoid_rule_multi(moments, count, a, b, 1000);
+        std::cout << "f1 as a component (Simpson / trapezoid): " << simp[6] << " / " << trap[6] << std::endl;
+        std::cout << "Separate calls (Simpson / trapezoid):    " << simpson_rule(f1, a, b, 1000) << " / "
+                  << trapezoid_rule(f1, a, b, 1000) << std::endl;
+
+        std::vector<std::function<double(double)>> funcs = {
+            [](double x) { return std::sin(x); }, [](double x) { return std::cos(x); }, f1
+        };
+        std::vector<double> set = simpson_rule_multi(funcs, 0.0, std::acos(-1.0), 1000);
+        std::cout << "Set of functions on [0, pi] (sin, cos): " << set[0] << ", " << set[1] << std::endl;
+    }
+
+    std::cout << "Attempting a multi-integrand rule with no integrands: ";
+    try {
+        std::vector<double> r = simpson_rule_multi(std::vector<std::function<double(double)>>(), a, b, 100);
+        std::cout << "Unexpected result: " << r.size() << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    // --- Tabulated and Streaming Samples ---
+    std::cout << "\n--- Tabulated and Streaming Samples ---" << std::endl;
+    {
+        // sin na [0, pi] (całka 2): próbki równoodległe i zagęszczone przy końcu x = pi (t^2)
+        const double pi = std::acos(-1.0);
+        std::cout << std::scientific << std::setprecision(3);
+        for (int n : { 101, 100 }) {
+            std::vector<double> x(n), xu(n), y(n), yu(n);
+            const double dx = pi / (n - 1);
+            for (int i = 0; i < n; ++i) {
+                const double t = static_cast<double>(i) / (n - 1);
+                x[i] = pi * t * (2.0 - t);
+                y[i] = std::sin(x[i]);
+                yu[i] = std::sin(i * dx);
+            }
+            std::cout << n << " samples, errors: trapezoid " << std::abs(trapezoid_samples(yu.data(), n, dx) - 2.0)
+                      << ", Simpson " << std::abs(simpson_samples(yu.data(), n, dx) - 2.0)
+                      << ", unequal trapezoid " << std::abs(trapezoid_samples(x.data(), y.data(), n) - 2.0)
+                      << ", unequal Simpson " << std::abs(simpson_samples(x.data(), y.data(), n) - 2.0) << std::endl;
+
+            // Ten sam ciąg dopisywany porcjami po 7 próbek
+            SampleIntegrator equal(dx), unequal;
+            std::vector<double> cumulative(n);
+            for (int start = 0; start < n; start += 7) {
+                const int count = std::min(7, n - start);
+                equal.append(yu.data() + start, count, cumulative.data() + start);
+                unequal.append(x.data() + start, y.data() + start, count);
+            }
+            double cumulative_err = 0.0;
+            for (int i = 0; i < n; ++i) cumulative_err = std::max(cumulative_err, std::abs(cumulative[i] - (1.0 - std::cos(i * dx))));
+            std::cout << "  stream vs. arrays: " << std::abs(equal.simpson() - simpson_samples(yu.data(), n, dx)) << ", "
+                      << std::abs(unequal.simpson() - simpson_samples(x.data(), y.data(), n)) << ", "
+                      << std::abs(unequal.trapezoid() - trapezoid_samples(x.data(), y.data(), n))
+                      << "; cumulative error: " << cumulative_err << std::endl;
+        }
+        std::vector<double> y = { 1.0, 2.0, 3.0, 4.0 };
+        cumulative_trapezoid(y.data(), 4, 0.5, y.data());
+        std::cout << std::fixed << std::setprecision(10);
+        std::cout << "In-place cumulative integral of 1, 2, 3, 4: " << y[1] << ", " << y[2] << ", " << y[3] << std::endl;
+    }
+
+    std::cout << "Attempting Simpson's rule on non-increasing abscissae: ";
+    try {
+        const double x[3] = { 0.0, 1.0, 1.0 }, y[3] = { 1.0, 1.0, 1.0 };
+        double r = simpson_samples(x, y, 3);
+        std::cout << "Unexpected result: " << r << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    std::cout << "Attempting to stream unequally spaced samples into an equal-spacing integrator: ";
+    try {
+        SampleIntegrator stream(0.1);
+        const double x[1] = { 0.0 }, y[1] = { 1.0 };
+        stream.append(x, y, 1);
+        std::cout << "Unexpected success" << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    // --- Romberg Integration ---
+    std::cout << "\n--- Romberg Integration ---" << std::endl;
+    {
+        // Zagęszczanie metody trapezów bez ponownego liczenia starych węzłów
+        int calls = 0;
+        IncrementalTrapezoid trap([&calls](double x) { ++calls; return f1(x); }, a, b, 4);
+        for (int k = 0; k < 6; ++k) trap.refine();
+        std::cout << "Incremental trapezoid (" << trap.intervals() << " intervals): " << trap.value()
+                  << ", trapezoid_rule: " << trapezoid_rule(f1, a, b, trap.intervals()) << std::endl;
+        std::cout << "Richardson extrapolation from the same samples: " << trap.extrapolated() << std::scientific
+                  << " (error " << std::abs(trap.extrapolated() - exact_f1) << ")" << std::fixed << std::endl;
+        std::cout << "Function calls: " << calls << ", reported: " << trap.evaluations() << std::endl;
+
+        QuadratureResult r = romberg_integration(f1, a, b, 1e-12, 1e-12);
+        std::cout << "Romberg: " << r.value << std::scientific << ", error: " << std::abs(r.value - exact_f1)
+                  << ", estimate: " << r.error_estimate << std::fixed << ", evaluations: " << r.evaluations << std::endl;
+        QuadratureResult e = romberg_integration([](double x) { return std::exp(x); }, 0.0, 1.0);
+        std::cout << "Romberg for exp on [0, 1]: error " << std::scientific << std::abs(e.value - (std::exp(1.0) - 1.0))
+                  << std::fixed << " after " << e.evaluations << " evaluations" << std::endl;
+    }
+
+    std::cout << "Attempting Romberg integration with too few levels: ";
+    try {
+        QuadratureResult r = romberg_integration(f1, a, b, 1e-14, 1e-14, 3);
+        std::cout << "Unexpected result: " << r.value << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    std::cout << "Attempting an incremental trapezoid with 0 intervals: ";
+    try {
+        IncrementalTrapezoid t(f1, a, b, 0);
+        std::cout << "Unexpected result: " << t.value() << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    // --- Improper and Singular Integrals ---
+    std::cout << "\n--- Improper and Singular Integrals ---" << std::endl;
+    {
+        const double pi = std::acos(-1.0), inf = std::numeric_limits<double>::infinity();
+        struct Case {
+            const char* name;
+            std::function<double(double)> f;
+            double a, b, exact;
+        };
+        const Case cases[] = {
+            { "1/sqrt(x) on [0, 1]      ", [](double x) { return 1.0 / std::sqrt(x); }, 0.0, 1.0, 2.0 },
+            { "log(x) on [0, 1]         ", [](double x) { return std::log(x); }, 0.0, 1.0, -1.0 },
+            { "x^(-0.9) on [0, 1]       ", [](double x) { return std::pow(x, -0.9); }, 0.0, 1.0, 10.0 },
+            { "1/(1 + x^2) on [0, inf)  ", [](double x) { return 1.0 / (1.0 + x * x); }, 0.0, inf, 0.5 * pi },
+            { "exp(x) on (-inf, 0]      ", [](double x) { return std::exp(x); }, -inf, 0.0, 1.0 },
+            { "exp(-x^2) on (-inf, inf) ", [](double x) { return std::exp(-x * x); }, -inf, inf, std::sqrt(pi) },
+            { "f1 on [a, b]             ", f1, a, b, exact_f1 },
+        };
+        for (const Case& c : cases) {
+            QuadratureResult r = tanh_sinh_quadrature(c.f, c.a, c.b);
+            std::cout << "Tanh-sinh, " << c.name << ": " << r.value << std::scientific << ", error: "
+                      << std::abs(r.value - c.exact) << std::fixed << ", evaluations: " << r.evaluations << std::endl;
+        }
+        std::cout << "Reversed limits, 1/sqrt(x) from 1 to 0: "
+                  << tanh_sinh_quadrature([](double x) { return 1.0 / std::sqrt(x); }, 1.0, 0.0).value << std::endl;
+        std::cout << "Simpson with 100000 intervals on [1e-12, 1] for comparison: "
+                  << simpson_rule([](double x) { return 1.0 / std::sqrt(x); }, 1e-12, 1.0, 100000) << std::endl;
+
+        // Zwarty nośnik: (0.01 - x)^2 na [0, 0.01], zero dalej (dokładnie 1e-6 / 3). Środek i prawa strona
+        // dają same zera, co nie może uciąć sum przed węzłami bliskimi zera
+        QuadratureResult support = tanh_sinh_quadrature([](double x) { return x < 0.01 ? (0.01 - x) * (0.01 - x) : 0.0; }, 0.0, 1.0);
+        std::cout << "Tanh-sinh, compactly supported (0.01 - x)^2 on [0, 1]: error " << std::scientific
+                  << std::abs(support.value - 1e-6 / 3.0) << std::fixed << ", evaluations: " << support.evaluations << std::endl;
+        if (!(std::abs(support.value - 1e-6 / 3.0) < 1e-10 && support.value > 0.0)) {
+            std::cout << "Unexpected result: " << support.value << std::endl;
+        }
+
+        // Osobliwość w końcu różnym od zera: 1 / sqrt(x - c) na [c, c + 1] (dokładnie 2). Zwykły wariant
+        // traci cyfry x - c przy c = 1; wariant z odległością od końca dostaje ją bez zaokrągleń
+        QuadratureResult shifted = tanh_sinh_quadrature([](double x) { return 1.0 / std::sqrt(x - 1.0); }, 1.0, 2.0);
+        std::cout << "Tanh-sinh, 1/sqrt(x - 1) on [1, 2]: error " << std::scientific << std::abs(shifted.value - 2.0)
+                  << " (estimate " << shifted.error_estimate << ", rounding of x - 1 not covered)" << std::fixed << std::endl;
+        for (double c : { 1.0, 1e6 }) {
+            QuadratureResult r = tanh_sinh_quadrature_complement(
+                [c](double x, double xc) { return 1.0 / std::sqrt(xc < 0.0 ? -xc : x - c); }, c, c + 1.0);
+            const double error = std::abs(r.value - 2.0);
+            std::cout << "Tanh-sinh with endpoint distance, 1/sqrt(x - c) on [c, c + 1], c = " << static_cast<long long>(c) << ": error "
+                      << std::scientific << error << std::fixed << ", evaluations: " << r.evaluations << std::endl;
+            if (!(error < 1e-10)) {
+                std::cout << "Unexpected result: " << r.value << std::endl;
+            }
+        }
+
+        // Gauss-Laguerre: x^5 e^(-x) (dokładnie 5! = 120) oraz e^(-3 (x - 2)) cos x na [2, inf)
+        std::cout << "Gauss-Laguerre, x^5 (3 nodes): " << gauss_laguerre_quadrature([](double x) { return std::pow(x, 5); }, 3)
+                  << " (expected 120)" << std::endl;
+        std::cout << "Gauss-Laguerre, cos(x), a = 2, scale = 3 (20 nodes): "
+                  << gauss_laguerre_quadrature([](double x) { return std::cos(x); }, 20, 2.0, 3.0)
+                  << " (expected " << (3.0 * std::cos(2.0) - std::sin(2.0)) / 10.0 << ")" << std::endl;
+        // Gauss-Hermite: x^4 e^(-x^2) (3 sqrt(pi) / 4) oraz e^(-((x - 1) / 2)^2) x^2 (6 sqrt(pi))
+        std::cout << "Gauss-Hermite, x^4 (3 nodes): " << gauss_hermite_quadrature([](double x) { return x * x * x * x; }, 3)
+                  << " (expected " << 0.75 * std::sqrt(pi) << ")" << std::endl;
+        std::cout << "Gauss-Hermite, x^2, center = 1, scale = 2 (2 nodes): "
+                  << gauss_hermite_quadrature([](double x) { return x * x; }, 2, 1.0, 2.0)
+                  << " (expected " << 6.0 * std::sqrt(pi) << ")" << std::endl;
+
+        double laguerre_sum = 0.0, hermite_sum = 0.0;
+        for (double w : gauss_laguerre_rule(100).weights) laguerre_sum += w;
+        for (double w : gauss_hermite_rule(100).weights) hermite_sum += w;
+        std::cout << "Weight sums for 100 nodes (Laguerre - 1, Hermite - sqrt(pi)): " << std::scientific
+                  << laguerre_sum - 1.0 << ", " << hermite_sum - std::sqrt(pi) << std::fixed << std::endl;
+
+        // Duże rzędy: węzły ściśle rosnące, wagi skończone i sumujące się do całki wagi
+        for (int n : { 200, 500, 1000 }) {
+            const GaussRule* rules[2] = { &gauss_laguerre_rule(n), &gauss_hermite_rule(n) };
+            const double totals[2] = { 1.0, std::sqrt(pi) };
+            for (int family = 0; family < 2; ++family) {
+                const GaussRule& rule = *rules[family];
+                bool increasing = true;
+                double sum = 0.0;
+                for (std::size_t i = 0; i < rule.nodes.size(); ++i) {
+                    if (i > 0 && !(rule.nodes[i] > rule.nodes[i - 1])) increasing = false;
+                    sum += rule.weights[i];
+                }
+                const double deviation = std::abs(sum - totals[family]) / totals[family];
+                std::cout << (family == 0 ? "Gauss-Laguerre" : "Gauss-Hermite") << ", " << n << " nodes: increasing "
+                          << (increasing ? "yes" : "no") << ", relative weight sum error " << std::scientific
+                          << deviation << std::fixed << std::endl;
+                if (!increasing || !(deviation < 1e-12)) {
+                    std::cout << "Unexpected result: rule of order " << n << " is broken" << std::endl;
+                }
+            }
+        }
+        std::cout << "Cached rules reused: "
+                  << (&gauss_laguerre_rule(100) == &gauss_laguerre_rule(100) && &gauss_hermite_rule(7) == &gauss_hermite_rule(7)
+                      ? "yes" : "no") << std::endl;
+    }
+
+    std::cout << "Attempting Gauss-Hermite with a non-positive scale: ";
+    try {
+        double r = gauss_hermite_quadrature(f1, 10, 0.0, 0.0);
+        std::cout << "Unexpected result: " << r << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    std::cout << "Attempting tanh-sinh with endpoint distances on (-inf, inf): ";
+    try {
+        const double inf = std::numeric_limits<double>::infinity();
+        QuadratureResult r = tanh_sinh_quadrature_complement([](double, double xc) { return std::exp(-xc * xc); }, -inf, inf);
+        std::cout << "Unexpected result: " << r.value << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    std::cout << "Attempting tanh-sinh on a function that is infinite inside the interval: ";
+    try {
+        QuadratureResult r = tanh_sinh_quadrature([](double x) { return 1.0 / (x - 0.5); }, 0.0, 1.0);
+        std::cout << "Unexpected result: " << r.value << std::endl;
+    } catch (const std::runtime_error& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
+    // --- Multithreaded Quadrature ---
+    std::cout << "\n--- Multithreaded Quadrature ---" << std::endl;
+    {
+        const int intervals = 200000;
+        const int thread_counts[] = { 1, 2, 4, 0 };
+        double simp[4], gauss[4];
+        for (int t = 0; t < 4; ++t) {
+            simp[t] = simpson_rule(f1, a, b, intervals, thread_counts[t]);
+            gauss[t] = gauss_legendre_quadrature([](double x) { return x * x * std::sin(x) * std::sin(x) * std::sin(x); },
+                                                 a, b, 5, intervals / 10, thread_counts[t]);
+        }
+        bool identical = true;
+        for (int t = 1; t < 4; ++t) {
+            identical = identical && simp[t] == simp[0] && gauss[t] == gauss[0];
+        }
+        std::cout << "Simpson (parallel, 200000 intervals): " << simp[0]
+                  << ", difference from serial: " << std::abs(simp[0] - simpson_rule(f1, a, b, intervals)) << std::endl;
+        std::cout << "Gauss-Legendre (parallel, 5 nodes): " << gauss[0]
+                  << ", difference from serial: " << std::abs(gauss[0] - gauss_legendre_quadrature(f1, a, b, 5, intervals / 10))
+                  << std::endl;
+        std::cout << "Rectangle / trapezoid (parallel): " << rectangle_rule(f1, a, b, intervals, 2) << " / "
+                  << trapezoid_rule(f1, a, b, intervals, 2) << std::endl;
+        std::cout << "Bit-identical for 1, 2, 4 and all threads: " << (identical ? "yes" : "no") << std::endl;
+        // Mniej przedziałów niż porcji oraz więcej wątków niż porcji
+        std::cout << "Small problem on 8 threads: " << trapezoid_rule(f1, a, b, 3, 8)
+                  << " (serial " << trapezoid_rule(f1, a, b, 3) << ")" << std::endl;
+    }
+
+    std::cout << "Attempting parallel Simpson's Rule with -1 threads: ";
+    try {
+        double r = simpson_rule(f1, a, b, 100, -1);
+        std::cout << "Unexpected result: " << r << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+
     // --- Erroneous Test Case ---
     std::cout << "\n--- Erroneous Test: Invalid Input ---" << std::endl;
     int invalid_intervals_zero = 0; // Number of intervals cannot be zero
@@ -56,6 +496,15 @@ int main() {
     }
     std::cout << std::endl;
 
+    std::cout << "Attempting Gauss-Legendre with 0 nodes: ";
+    try {
+        double result_gl_err = gauss_legendre_quadrature(f1, a, b, 0, 10);
+        std::cout << "Unexpected result: " << result_gl_err << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cout << "Caught expected exception: " << e.what() << std::endl;
+    }
+    std::cout << std::endl;
+
     // Another erroneous test: Simpson's rule with an odd number of intervals
     int invalid_simp_intervals_odd = 999;
     std::cout << "Attempting Simpson's Rule with 999 (odd) intervals: ";
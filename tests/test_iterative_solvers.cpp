@@ -0,0 +1,246 @@
+#include <iostream>
+#include <vector>
+#include <iomanip>
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include "iterative_solvers.h" // Używamy naszej biblioteki
+
+// Maksymalna wartość bezwzględna residuum |Ax - b|
+double max_residual(const LinearOperator& A, const Vector& x, const Vector& b) {
+    Vector r = A.apply(x);
+    double worst = 0.0;
+    for (std::size_t i = 0; i < r.size(); ++i) {
+        worst = std::max(worst, std::abs(r[i] - b[i]));
+    }
+    return worst;
+}
+
+// Macierz 5-punktowego laplasjanu na siatce m x m (symetryczna, dodatnio określona)
+SparseMatrix poisson_2d(int m) {
+    std::vector<Triplet> t;
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < m; ++j) {
+            int row = i * m + j;
+            t.push_back({ row, row, 4.0 });
+            if (i > 0) t.push_back({ row, row - m, -1.0 });
+            if (i < m - 1) t.push_back({ row, row + m, -1.0 });
+            if (j > 0) t.push_back({ row, row - 1, -1.0 });
+            if (j < m - 1) t.push_back({ row, row + 1, -1.0 });
+        }
+    }
+    return SparseMatrix::from_triplets(m * m, m * m, t);
+}
+
+// Dyfuzja z konwekcją (schemat pod wiatr) na siatce m x m - macierz niesymetryczna
+SparseMatrix convection_diffusion_2d(int m, double velocity) {
+    std::vector<Triplet> t;
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < m; ++j) {
+            int row = i * m + j;
+            t.push_back({ row, row, 4.0 + velocity });
+            if (i > 0) t.push_back({ row, row - m, -1.0 });
+            if (i < m - 1) t.push_back({ row, row + m, -1.0 });
+            if (j > 0) t.push_back({ row, row - 1, -1.0 - velocity });
+            if (j < m - 1) t.push_back({ row, row + 1, -1.0 });
+        }
+    }
+    return SparseMatrix::from_triplets(m * m, m * m, t);
+}
+
+// Wypisuje liczbę iteracji i residuum końcowe
+void report(const std::string& name, const std::vector<KrylovIteration>& history,
+            const LinearOperator& A, const Vector& x, const Vector& b) {
+    std::cout << std::left << std::setw(28) << name << std::right
+              << " iterations: " << std::setw(4) << history.size()
+              << "  max residual: " << std::scientific << std::setprecision(3) << max_residual(A, x, b)
+              << std::fixed << std::setprecision(4) << std::endl;
+}
+
+int main() {
+    std::cout << "--- Example: Krylov Solvers with Preconditioners ---" << std::endl;
+    std::cout << std::fixed << std::setprecision(4);
+
+    // --- Symetryczny układ: Poisson 2D, 2500 niewiadomych ---
+    std::cout << "\n--- Correct Test: Conjugate Gradient on Poisson 2D (50x50) ---" << std::endl;
+    try {
+        SparseMatrix P = poisson_2d(50);
+        LinearOperator op(P);
+        Vector b(P.rows(), 1.0);
+        std::vector<KrylovIteration> h_none, h_jacobi, h_ic;
+
+        Vector x_none = conjugate_gradient(op, b, nullptr, 1e-10, 1000, &h_none);
+        report("CG (no preconditioner)", h_none, op, x_none, b);
+
+        JacobiPreconditioner jacobi(P);
+        Vector x_jacobi = conjugate_gradient(op, b, &jacobi, 1e-10, 1000, &h_jacobi);
+        report("CG + Jacobi", h_jacobi, op, x_jacobi, b);
+
+        IncompleteCholeskyPreconditioner ic(P);
+        Vector x_ic = conjugate_gradient(op, b, &ic, 1e-10, 1000, &h_ic);
+        report("CG + IC(0)", h_ic, op, x_ic, b);
+        std::cout << "IC(0) needs fewer iterations than no preconditioner: "
+                  << (h_ic.size() < h_none.size() ? "yes" : "no") << std::endl;
+
+        std::cout << "First iterations of CG + IC(0):" << std::endl;
+        std::cout << std::scientific << std::setprecision(3);
+        for (std::size_t k = 0; k < 3 && k < h_ic.size(); ++k) {
+            std::cout << "  iter " << h_ic[k].iteration_count << ": ||r|| = " << h_ic[k].residual_norm
+                      << ", ||r||/||b|| = " << h_ic[k].relative_residual << std::endl;
+        }
+        std::cout << std::fixed << std::setprecision(4);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Niesymetryczny układ: konwekcja-dyfuzja ---
+    std::cout << "\n--- Correct Test: BiCGSTAB and GMRES on Convection-Diffusion (50x50) ---" << std::endl;
+    try {
+        SparseMatrix C = convection_diffusion_2d(50, 2.0);
+        LinearOperator op(C);
+        Vector b(C.rows(), 1.0);
+        Ilu0Preconditioner ilu(C);
+        std::vector<KrylovIteration> h1, h2, h3, h4;
+
+        Vector x1 = bicgstab(op, b, nullptr, 1e-10, 1000, &h1);
+        report("BiCGSTAB", h1, op, x1, b);
+        Vector x2 = bicgstab(op, b, &ilu, 1e-10, 1000, &h2);
+        report("BiCGSTAB + ILU(0)", h2, op, x2, b);
+        Vector x3 = gmres(op, b, nullptr, 30, 1e-10, 2000, &h3);
+        report("GMRES(30)", h3, op, x3, b);
+        Vector x4 = gmres(op, b, &ilu, 30, 1e-10, 2000, &h4);
+        report("GMRES(30) + ILU(0)", h4, op, x4, b);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Operator zadany funkcją: 1-D laplasjan bez budowania macierzy ---
+    std::cout << "\n--- Correct Test: Matrix-Free Operator (1-D Laplacian, n = 200) ---" << std::endl;
+    try {
+        const int n = 200;
+        LinearOperator laplace(n, [n](const double* x, double* y) {
+            for (int i = 0; i < n; ++i) {
+                y[i] = 2.0 * x[i] - (i > 0 ? x[i - 1] : 0.0) - (i < n - 1 ? x[i + 1] : 0.0);
+            }
+        });
+        Vector b(n, 1.0);
+        std::vector<KrylovIteration> h;
+        Vector x = conjugate_gradient(laplace, b, nullptr, 1e-10, 1000, &h);
+        report("CG (matrix-free)", h, laplace, x, b);
+        std::cout << "x[n/2] = " << x[n / 2] << " (expected " << 0.5 * (n / 2 + 1) * (n - n / 2) << ")" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Operator zadany funkcją wraz z przekątną: preconditioner Jacobiego bez macierzy ---
+    std::cout << "\n--- Correct Test: Matrix-Free Operator with Diagonal (n = 2000) ---" << std::endl;
+    try {
+        // Laplasjan 1-D z silnie zmiennym członem reakcji: przekątna rozrzucona na trzy rzędy wielkości
+        const int n = 2000;
+        Vector diagonal(n);
+        for (int i = 0; i < n; ++i) {
+            diagonal[i] = 2.0 + std::pow(10.0, 3.0 * (i % 17) / 16.0);
+        }
+        LinearOperator reaction(n, [n, &diagonal](const double* x, double* y) {
+            for (int i = 0; i < n; ++i) {
+                y[i] = diagonal[i] * x[i] - (i > 0 ? x[i - 1] : 0.0) - (i < n - 1 ? x[i + 1] : 0.0);
+            }
+        }, diagonal);
+        Vector b(n, 1.0);
+        std::vector<KrylovIteration> h_none, h_jacobi;
+        Vector x_none = conjugate_gradient(reaction, b, nullptr, 1e-10, 2000, &h_none);
+        report("CG (matrix-free)", h_none, reaction, x_none, b);
+        JacobiPreconditioner jacobi(reaction);
+        Vector x_jacobi = conjugate_gradient(reaction, b, &jacobi, 1e-10, 2000, &h_jacobi);
+        report("CG + Jacobi from operator", h_jacobi, reaction, x_jacobi, b);
+        std::cout << "Jacobi needs fewer iterations: " << (h_jacobi.size() < h_none.size() ? "yes" : "no") << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Operator gęsty ---
+    std::cout << "\n--- Correct Test: Dense Operator with GMRES ---" << std::endl;
+    try {
+        DenseMatrix D = {
+            {4, 1, 0},
+            {1, 3, 1},
+            {0, 2, 5}
+        };
+        LinearOperator op(D);
+        JacobiPreconditioner jacobi(D);
+        Vector b = { 5, 5, 7 };
+        std::vector<KrylovIteration> h;
+        Vector x = gmres(op, b, &jacobi, 30, 1e-12, 100, &h);
+        std::cout << "x = [ " << x[0] << " " << x[1] << " " << x[2] << " ] (expected [1 1 1]) after "
+                  << h.size() << " iterations" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Błędne przypadki ---
+    std::cout << "\n--- Erroneous Test: Iteration Limit Too Small ---" << std::endl;
+    try {
+        SparseMatrix P = poisson_2d(30);
+        Vector x = conjugate_gradient(LinearOperator(P), Vector(P.rows(), 1.0), nullptr, 1e-12, 5);
+        std::cout << "Unexpected success: " << x.size() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting CG on an indefinite matrix:" << std::endl;
+    try {
+        SparseMatrix S = SparseMatrix::from_triplets(2, 2, { {0, 0, 1.0}, {1, 1, -1.0} });
+        Vector x = conjugate_gradient(LinearOperator(S), Vector{ 0.0, 1.0 });
+        std::cout << "Unexpected success: " << x.size() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting ILU(0) on a matrix with a missing diagonal entry:" << std::endl;
+    try {
+        SparseMatrix S = SparseMatrix::from_triplets(2, 2, { {0, 1, 1.0}, {1, 0, 1.0} });
+        Ilu0Preconditioner ilu(S);
+        std::cout << "Unexpected success." << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting a Jacobi preconditioner for an operator without a diagonal:" << std::endl;
+    try {
+        LinearOperator identity(3, [](const double* x, double* y) { for (int i = 0; i < 3; ++i) y[i] = x[i]; });
+        JacobiPreconditioner jacobi(identity);
+        std::cout << "Unexpected success." << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting an operator with a diagonal of the wrong size:" << std::endl;
+    try {
+        LinearOperator op(3, [](const double* x, double* y) { for (int i = 0; i < 3; ++i) y[i] = x[i]; }, Vector{ 1.0, 1.0 });
+        std::cout << "Unexpected success: " << op.size() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting to solve with mismatched dimensions:" << std::endl;
+    try {
+        SparseMatrix P = poisson_2d(3);
+        Vector x = bicgstab(LinearOperator(P), Vector(4, 1.0));
+        std::cout << "Unexpected success: " << x.size() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -2,8 +2,58 @@
 #include <vector>
 #include <iomanip>
 #include <stdexcept> // For std::runtime_error or std::invalid_argument
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <utility>
 #include "linear_algebra.h" // Używamy naszej biblioteki
 
+// Licznik alokacji na stercie: pozwala sprawdzić, że warianty "w miejscu" nie przydzielają pamięci
+std::atomic<std::size_t> heap_allocations{ 0 };
+
+void* operator new(std::size_t size) {
+    ++heap_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    operator delete(p);
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    ++heap_allocations;
+    // Przydzielamy nadmiar i zapamiętujemy oryginalny wskaźnik tuż przed wyrównanym blokiem
+    const std::size_t alignment = static_cast<std::size_t>(align);
+    void* raw = std::malloc(size + alignment + sizeof(void*));
+    if (raw == nullptr) {
+        throw std::bad_alloc();
+    }
+    std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*) + alignment - 1) & ~(alignment - 1);
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    if (p != nullptr) {
+        std::free(static_cast<void**>(p)[-1]);
+    }
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t align) noexcept {
+    operator delete(p, align);
+}
+
 // Pomocnicza funkcja do drukowania wektora
 void print_vector(const Vector& vec, const std::string& name) {
     std::cout << "Vector " << name << ": [ ";
@@ -13,6 +63,32 @@ void print_vector(const Vector& vec, const std::string& name) {
     std::cout << "]" << std::endl;
 }
 
+// Maksymalna wartość bezwzględna residuum |Ax - b|
+double max_residual(const DenseMatrix& A, const Vector& x, const Vector& b) {
+    double worst = 0.0;
+    for (int i = 0; i < A.rows(); ++i) {
+        double r = -b[i];
+        for (int j = 0; j < A.cols(); ++j) {
+            r += A(i, j) * x[j];
+        }
+        worst = std::max(worst, std::abs(r));
+    }
+    return worst;
+}
+
+// Losowa macierz n x n o elementach z przedziału [-1, 1] (stałe ziarno dla powtarzalności)
+DenseMatrix random_matrix(int n, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    DenseMatrix M(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            M(i, j) = dist(gen);
+        }
+    }
+    return M;
+}
+
 int main() {
     std::cout << "--- Example: Solving Linear Equations Ax = b ---" << std::endl;
     std::cout << std::fixed << std::setprecision(4);
@@ -95,5 +171,689 @@ int main() {
         std::cerr << "Caught expected error for LU Decomposition: " << e.what() << std::endl;
     }
 
+    // --- DenseMatrix: ciągła macierz i adapter dla typu Matrix ---
+    std::cout << "\n--- DenseMatrix Test: Contiguous Storage ---" << std::endl;
+    try {
+        DenseMatrix D(A);
+        std::cout << "DenseMatrix " << D.rows() << "x" << D.cols() << ", stride " << D.stride()
+                  << ", round trip equal: " << (D.to_matrix() == A ? "yes" : "no") << std::endl;
+        print_vector(solve_gauss(D, b), "x_gauss_dense");
+        print_vector(solve_lu(D, b), "x_lu_dense");
+
+        // Widok na blok 2x2 w prawym dolnym rogu
+        ConstMatrixView corner = D.block(1, 1, 2, 2);
+        std::cout << "Block (1,1) 2x2: [ " << corner(0, 0) << " " << corner(0, 1) << " ; "
+                  << corner(1, 0) << " " << corner(1, 1) << " ]" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting to build DenseMatrix from ragged rows:" << std::endl;
+    try {
+        Matrix ragged = { {1, 2, 3}, {4, 5} };
+        DenseMatrix D_ragged(ragged);
+        std::cout << "Unexpected success: " << D_ragged.rows() << "x" << D_ragged.cols() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    // --- LuFactorization: jeden rozkład, wiele prawych stron ---
+    std::cout << "\n--- LuFactorization Test: Many Right-Hand Sides ---" << std::endl;
+    try {
+        LuFactorization lu(A);
+        print_vector(lu.solve(b), "x_lu_factor");
+        print_vector(lu.solve(Vector{ 12, 15, 19 }), "x_lu_factor_2"); // oczekiwane [1 1 1]
+
+        DenseMatrix B = {
+            {1, 12},
+            {1, 15},
+            {1, 19}
+        };
+        DenseMatrix X = lu.solve(B);
+        std::cout << "Block solve X: [ ";
+        for (int i = 0; i < X.rows(); ++i) {
+            std::cout << X(i, 0) << " " << X(i, 1) << (i + 1 < X.rows() ? " ; " : " ");
+        }
+        std::cout << "]" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting to factor a singular matrix:" << std::endl;
+    try {
+        LuFactorization lu_singular(A_singular);
+        std::cout << "Unexpected success, n = " << lu_singular.size() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    // --- Blokowa dekompozycja: układ większy niż pojedynczy panel ---
+    std::cout << "\n--- Blocked Factorization Test: Random 500x500 System ---" << std::endl;
+    try {
+        DenseMatrix R = random_matrix(500, 42);
+        Vector rhs(500, 1.0);
+        Vector x_big_gauss = solve_gauss(R, rhs);
+        Vector x_big_lu = solve_lu(R, rhs);
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Max residual (Gauss): " << max_residual(R, x_big_gauss, rhs) << std::endl;
+        std::cout << "Max residual (LU):    " << max_residual(R, x_big_lu, rhs) << std::endl;
+
+        Vector x_big_parallel = solve_lu(R, rhs, 4);
+        std::cout << "Max residual (LU, 4 threads): " << max_residual(R, x_big_parallel, rhs) << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Rozkład wielowątkowy z wyprzedzeniem: te same czynniki co sekwencyjny (kilka paneli po 192 kolumny) ---
+    std::cout << "\n--- Parallel Factorization Test: 800x800, 1 vs 4 Threads ---" << std::endl;
+    try {
+        DenseMatrix R = random_matrix(800, 11);
+        LuFactorization serial(R, 1);
+        LuFactorization parallel(R, 4);
+        const bool same_permutation = serial.permutation() == parallel.permutation();
+        double max_difference = 0.0;
+        for (int i = 0; i < serial.size(); ++i) {
+            for (int j = 0; j < serial.size(); ++j) {
+                max_difference = std::max(max_difference, std::abs(serial.packed_lu()(i, j) - parallel.packed_lu()(i, j)));
+            }
+        }
+        std::cout << "Same permutation: " << (same_permutation ? "yes" : "no") << std::endl;
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Max difference of LU factors: " << max_difference << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+        if (!same_permutation || max_difference > 1e-12) {
+            std::cout << "Unexpected result: parallel factors differ from the sequential ones" << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Warianty w miejscu: wielokrotne użycie buforów bez alokacji ---
+    std::cout << "\n--- In-Place Solver Test: 50 Solves of a 300x300 System ---" << std::endl;
+    try {
+        const int n_in_place = 300;
+        DenseMatrix R = random_matrix(n_in_place, 7);
+        Vector rhs(n_in_place, 1.0);
+        DenseMatrix A_work(n_in_place, n_in_place);
+        Vector b_work(n_in_place);
+        SolveWorkspace workspace(n_in_place);
+        LuFactorization lu(R);
+
+        double worst_in_place = 0.0;
+        double worst_refactor = 0.0;
+        std::size_t allocations = 0;
+        for (int iter = 0; iter <= 50; ++iter) {
+            // Iteracja 0 rozgrzewa bufory jądra mnożenia macierzy i nie jest liczona
+            const std::size_t before = heap_allocations;
+            for (int i = 0; i < n_in_place; ++i) {
+                std::copy(R.row(i), R.row(i) + n_in_place, A_work.row(i));
+            }
+            std::fill(b_work.begin(), b_work.end(), 1.0);
+            solve_in_place(A_work, b_work, workspace);
+            if (iter > 0) {
+                worst_in_place = std::max(worst_in_place, max_residual(R, b_work, rhs));
+            }
+
+            lu.refactor(R.view());
+            std::fill(b_work.begin(), b_work.end(), 1.0);
+            lu.solve_in_place(b_work, workspace);
+            if (iter > 0) {
+                allocations += heap_allocations - before;
+                worst_refactor = std::max(worst_refactor, max_residual(R, b_work, rhs));
+            }
+        }
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Max residual (solve_in_place):          " << worst_in_place << std::endl;
+        std::cout << "Max residual (refactor + solve_in_place): " << worst_refactor << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+        std::cout << "Heap allocations in 50 iterations: " << allocations << std::endl;
+        if (allocations != 0) {
+            std::cout << "Unexpected allocations: " << allocations << " (expected none)" << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting an in-place solve of a singular matrix:" << std::endl;
+    try {
+        DenseMatrix S = { {1, 2}, {2, 4} };
+        Vector b_singular = { 1, 2 };
+        SolveWorkspace workspace;
+        solve_in_place(S, b_singular, workspace);
+        print_vector(b_singular, "x_in_place_singular");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    // --- Oszacowanie uwarunkowania: porównanie z dokładnym cond_1 z jawnej odwrotności ---
+    std::cout << "\n--- Condition Estimate Test: Hilbert and Random Matrices ---" << std::endl;
+    try {
+        // Dokładne cond_1(A) = ||A||_1 ||A^{-1}||_1 z odwrotności wyznaczonej kolumnami
+        const auto exact_condition = [](const DenseMatrix& A) {
+            const int n = A.rows();
+            DenseMatrix I(n, n);
+            for (int i = 0; i < n; ++i) I(i, i) = 1.0;
+            DenseMatrix inv = LuFactorization(A).solve(I);
+            double norm_a = 0.0, norm_inv = 0.0;
+            for (int j = 0; j < n; ++j) {
+                double sa = 0.0, si = 0.0;
+                for (int i = 0; i < n; ++i) {
+                    sa += std::abs(A(i, j));
+                    si += std::abs(inv(i, j));
+                }
+                norm_a = std::max(norm_a, sa);
+                norm_inv = std::max(norm_inv, si);
+            }
+            return norm_a * norm_inv;
+        };
+
+        DenseMatrix H(8, 8);
+        for (int i = 0; i < 8; ++i) {
+            for (int j = 0; j < 8; ++j) {
+                H(i, j) = 1.0 / (i + j + 1);
+            }
+        }
+        DenseMatrix R = random_matrix(200, 3);
+        std::cout << std::scientific << std::setprecision(3);
+        for (const auto& item : { std::make_pair("Hilbert 8x8", &H), std::make_pair("Random 200x200", &R) }) {
+            LuFactorization lu(*item.second);
+            const double estimate = lu.condition_estimate();
+            const double exact = exact_condition(*item.second);
+            std::cout << std::left << std::setw(16) << item.first << std::right
+                      << " estimate: " << estimate << "  exact: " << exact
+                      << "  ratio: " << std::fixed << std::setprecision(4) << estimate / exact
+                      << std::scientific << std::setprecision(3) << std::endl;
+        }
+
+        LuFactorization lu(R);
+        Vector rhs(200, 1.0);
+        Vector y = lu.solve_transposed(rhs);
+        double worst = 0.0;
+        for (int j = 0; j < 200; ++j) {
+            double sum = -rhs[j];
+            for (int i = 0; i < 200; ++i) sum += R(i, j) * y[i];
+            worst = std::max(worst, std::abs(sum));
+        }
+        std::cout << "Max residual of A^T y = b: " << worst << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- Solve Diagnostics Test: Well- and Ill-Conditioned Systems ---" << std::endl;
+    try {
+        DenseMatrix R = random_matrix(300, 5);
+        DenseMatrix H(10, 10);
+        for (int i = 0; i < 10; ++i) {
+            for (int j = 0; j < 10; ++j) {
+                H(i, j) = 1.0 / (i + j + 1);
+            }
+        }
+        SolveDiagnostics d_random, d_hilbert;
+        solve_lu(R, Vector(300, 1.0), 1, &d_random);
+        solve_gauss(H, Vector(10, 1.0), 1, &d_hilbert);
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Random 300x300: cond_1 ~ " << d_random.condition_estimate
+                  << ", ||r||_inf = " << d_random.residual_norm
+                  << ", backward error = " << d_random.backward_error << std::endl;
+        std::cout << "Hilbert 10x10:  cond_1 ~ " << d_hilbert.condition_estimate
+                  << ", ||r||_inf = " << d_hilbert.residual_norm
+                  << ", backward error = " << d_hilbert.backward_error << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Mieszana precyzja: rozkład float z poprawianiem iteracyjnym w double ---
+    std::cout << "\n--- Mixed-Precision Test: Random 400x400 System ---" << std::endl;
+    try {
+        DenseMatrix R = random_matrix(400, 11);
+        Vector rhs(400, 1.0);
+        RefinementInfo info;
+        Vector x_mixed = solve_mixed_precision(R, rhs, &info);
+        Vector x_double = solve_lu(R, rhs);
+        double diff = 0.0;
+        for (int i = 0; i < 400; ++i) {
+            diff = std::max(diff, std::abs(x_mixed[i] - x_double[i]));
+        }
+        std::cout << "Refinement steps: " << info.iterations
+                  << ", double fallback: " << (info.used_double_fallback ? "yes" : "no") << std::endl;
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Backward error: " << info.backward_error << std::endl;
+        std::cout << "Max residual (mixed): " << max_residual(R, x_mixed, rhs) << std::endl;
+        std::cout << "Max |x_mixed - x_lu|: " << diff << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- Mixed-Precision Test: Ill-Conditioned Hilbert Matrix (n = 10) ---" << std::endl;
+    try {
+        // cond(H_10) ~ 1e13 przekracza możliwości rozkładu float - oczekiwany powrót do double
+        const int n_hilbert = 10;
+        DenseMatrix H(n_hilbert, n_hilbert);
+        Vector ones(n_hilbert, 1.0);
+        Vector rhs(n_hilbert, 0.0);
+        for (int i = 0; i < n_hilbert; ++i) {
+            for (int j = 0; j < n_hilbert; ++j) {
+                H(i, j) = 1.0 / (i + j + 1);
+                rhs[i] += H(i, j);
+            }
+        }
+        RefinementInfo info;
+        Vector x = solve_mixed_precision(H, rhs, &info);
+        std::cout << "Double fallback: " << (info.used_double_fallback ? "yes" : "no") << std::endl;
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Backward error: " << info.backward_error << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+        print_vector(x, "x_hilbert (expected ~1)");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting a mixed-precision solve with mismatched dimensions:" << std::endl;
+    try {
+        Vector x = solve_mixed_precision(DenseMatrix(3, 3, 1.0), Vector(2, 1.0));
+        print_vector(x, "x_mixed_invalid");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    // --- Wsadowe rozwiązywanie wielu małych układów ---
+    std::cout << "\n--- Batched Solver Test: 1000 Systems of Sizes 3, 8 and 12 ---" << std::endl;
+    for (int n_small : { 3, 8, 12 }) {
+        try {
+            const int count = 1000;
+            SystemBatch batch(n_small, count);
+            std::vector<DenseMatrix> originals;
+            std::vector<Vector> rhs_all;
+            for (int s = 0; s < count; ++s) {
+                originals.push_back(random_matrix(n_small, 1000 + s));
+                rhs_all.emplace_back(n_small, 1.0);
+                for (int i = 0; i < n_small; ++i) {
+                    for (int j = 0; j < n_small; ++j) {
+                        batch.a(s, i, j) = originals[s](i, j);
+                    }
+                    batch.b(s, i) = rhs_all[s][i];
+                }
+            }
+            solve_batched(batch);
+
+            double worst = 0.0;
+            for (int s = 0; s < count; ++s) {
+                Vector x_s(n_small);
+                for (int i = 0; i < n_small; ++i) {
+                    x_s[i] = batch.b(s, i);
+                }
+                worst = std::max(worst, max_residual(originals[s], x_s, rhs_all[s]));
+            }
+            std::cout << "n = " << n_small << ": max residual over batch = " << std::scientific
+                      << std::setprecision(3) << worst << std::fixed << std::setprecision(4) << std::endl;
+        }
+        catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+        }
+    }
+
+    std::cout << "\nAttempting to solve a batch containing a singular system:" << std::endl;
+    try {
+        SystemBatch batch(3, 2);
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                batch.a(0, i, j) = A[i][j];
+                batch.a(1, i, j) = A_singular[i][j];
+            }
+            batch.b(0, i) = 1.0;
+            batch.b(1, i) = 1.0;
+        }
+        solve_batched(batch);
+        std::cout << "Unexpected success." << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    // --- Układy trójdiagonalne i pasmowe ---
+    std::cout << "\n--- Tridiagonal Test: Thomas Algorithm ---" << std::endl;
+    try {
+        // -x'' = 1 na (0, 1), n węzłów wewnętrznych: macierz tridiag(-1, 2, -1)
+        const int n_tri = 100000;
+        Vector lower(n_tri - 1, -1.0), diagonal(n_tri, 2.0), upper(n_tri - 1, -1.0), rhs(n_tri, 1.0);
+        Vector x_tri = solve_tridiagonal(lower, diagonal, upper, rhs);
+        double worst = 0.0;
+        for (int i = 0; i < n_tri; ++i) {
+            double r = 2.0 * x_tri[i] - (i > 0 ? x_tri[i - 1] : 0.0) - (i < n_tri - 1 ? x_tri[i + 1] : 0.0) - 1.0;
+            worst = std::max(worst, std::abs(r) / x_tri[n_tri / 2]);
+        }
+        std::cout << "n = " << n_tri << ", relative residual: " << std::scientific << std::setprecision(3)
+                  << worst << std::fixed << std::setprecision(4) << std::endl;
+
+        Vector x_small = solve_tridiagonal({ 1, 1 }, { 4, 4, 4 }, { 1, 1 }, { 5, 6, 5 });
+        print_vector(x_small, "x_tridiagonal"); // oczekiwane [1 1 1]
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting to solve a singular tridiagonal system:" << std::endl;
+    try {
+        Vector x_tri = solve_tridiagonal({ 1 }, { 1, 1 }, { 1 }, { 1, 2 });
+        print_vector(x_tri, "x_tri_singular");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- Batched Tridiagonal Test: 1000 Systems of Size 50 ---" << std::endl;
+    try {
+        const int n_tri = 50, count = 1000;
+        Vector lower((n_tri - 1) * count), diagonal(n_tri * count), upper((n_tri - 1) * count), rhs(n_tri * count, 1.0);
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        for (auto& v : lower) v = dist(gen);
+        for (auto& v : upper) v = dist(gen);
+        for (auto& v : diagonal) v = 3.0 + dist(gen);
+        const Vector diagonal_copy = diagonal;
+        solve_tridiagonal_batched(n_tri, count, lower.data(), diagonal.data(), upper.data(), rhs.data());
+
+        double worst = 0.0;
+        for (int s = 0; s < count; ++s) {
+            auto x = [&](int i) { return rhs[i * count + s]; };
+            for (int i = 0; i < n_tri; ++i) {
+                double r = diagonal_copy[i * count + s] * x(i) - 1.0;
+                if (i > 0) r += lower[(i - 1) * count + s] * x(i - 1);
+                if (i < n_tri - 1) r += upper[i * count + s] * x(i + 1);
+                worst = std::max(worst, std::abs(r));
+            }
+        }
+        std::cout << "Max residual over batch: " << std::scientific << std::setprecision(3) << worst
+                  << std::fixed << std::setprecision(4) << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- Banded Test: LU with Pivoting (kl = 2, ku = 1) ---" << std::endl;
+    try {
+        const int n_band = 8;
+        BandMatrix B(n_band, 2, 1);
+        for (int i = 0; i < n_band; ++i) {
+            B(i, i) = (i % 3 == 0) ? 0.0 : 1.0; // zera na przekątnej wymuszają przestawienia wierszy
+            if (i + 1 < n_band) B(i, i + 1) = 2.0;
+            if (i >= 1) B(i, i - 1) = 3.0;
+            if (i >= 2) B(i, i - 2) = -1.0;
+        }
+        Vector rhs(n_band);
+        for (int i = 0; i < n_band; ++i) rhs[i] = i + 1.0;
+        Vector x_band = solve_banded(B, rhs);
+        Vector x_dense = solve_gauss(B.to_dense(), rhs);
+        double diff = 0.0;
+        for (int i = 0; i < n_band; ++i) diff = std::max(diff, std::abs(x_band[i] - x_dense[i]));
+        print_vector(x_band, "x_banded");
+        std::cout << "Max difference from dense Gauss: " << std::scientific << std::setprecision(3) << diff
+                  << std::fixed << std::setprecision(4) << std::endl;
+
+        BandMatrix big(200000, 3, 2);
+        for (int i = 0; i < big.size(); ++i) {
+            for (int j = std::max(0, i - 3); j <= std::min(big.size() - 1, i + 2); ++j) {
+                big(i, j) = (i == j) ? 6.0 : -1.0;
+            }
+        }
+        Vector rhs_big(big.size(), 1.0);
+        Vector x_big = BandLuFactorization(big).solve(rhs_big);
+        double worst = 0.0;
+        for (int i = 0; i < big.size(); ++i) {
+            double r = -1.0;
+            for (int j = std::max(0, i - 3); j <= std::min(big.size() - 1, i + 2); ++j) r += big(i, j) * x_big[j];
+            worst = std::max(worst, std::abs(r));
+        }
+        std::cout << "n = 200000 banded system, max residual: " << std::scientific << std::setprecision(3) << worst
+                  << std::fixed << std::setprecision(4) << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting to write outside the band:" << std::endl;
+    try {
+        BandMatrix B(4, 1, 1);
+        B(0, 3) = 1.0;
+        std::cout << "Unexpected success." << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    // --- Układy symetryczne: Cholesky i LDL^T ---
+    std::cout << "\n--- Cholesky Test: Symmetric Positive Definite Systems ---" << std::endl;
+    try {
+        DenseMatrix S_small = {
+            {4, 2, 2},
+            {2, 5, 3},
+            {2, 3, 6}
+        };
+        print_vector(solve_cholesky(SymmetricMatrix(S_small), Vector{ 8, 10, 11 }), "x_cholesky"); // oczekiwane [1 1 1]
+
+        // A = R^T R + n I jest symetryczna i dodatnio określona; rozmiar obejmuje kilka paneli
+        const int n_spd = 500;
+        DenseMatrix R = random_matrix(n_spd, 11);
+        DenseMatrix S(n_spd, n_spd);
+        for (int i = 0; i < n_spd; ++i) {
+            for (int j = 0; j <= i; ++j) {
+                double sum = 0.0;
+                for (int k = 0; k < n_spd; ++k) sum += R(k, i) * R(k, j);
+                S(i, j) = S(j, i) = sum + (i == j ? n_spd : 0.0);
+            }
+        }
+        Vector rhs(n_spd, 1.0);
+        CholeskyFactorization chol(S);
+        std::cout << "Max residual (Cholesky, n = 500): " << std::scientific << std::setprecision(3)
+                  << max_residual(S, chol.solve(rhs), rhs) << std::fixed << std::setprecision(4) << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting Cholesky on an indefinite matrix:" << std::endl;
+    try {
+        DenseMatrix S_indef = {
+            {1, 2},
+            {2, 1}
+        };
+        CholeskyFactorization chol(S_indef);
+        std::cout << "Unexpected success, n = " << chol.size() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- LDL^T Test: Symmetric Indefinite Systems ---" << std::endl;
+    try {
+        // Zera na przekątnej wymuszają bloki 2 x 2 pivotowania Buncha-Kaufmana
+        DenseMatrix K_small = {
+            {0, 1, 2},
+            {1, 0, 3},
+            {2, 3, 0}
+        };
+        LdltFactorization ldlt_small{ SymmetricMatrix(K_small) };
+        print_vector(ldlt_small.solve(Vector{ 3, 4, 5 }), "x_ldlt"); // oczekiwane [1 1 1]
+        std::cout << "Negative eigenvalues: " << ldlt_small.negative_eigenvalues() << " (expected 2)" << std::endl;
+
+        const int n_sym = 300;
+        DenseMatrix K = random_matrix(n_sym, 23);
+        for (int i = 0; i < n_sym; ++i) {
+            for (int j = 0; j < i; ++j) K(j, i) = K(i, j);
+        }
+        Vector rhs(n_sym, 1.0);
+        LdltFactorization ldlt{ SymmetricMatrix(K) };
+        std::cout << "Max residual (LDL^T, n = 300): " << std::scientific << std::setprecision(3)
+                  << max_residual(K, ldlt.solve(rhs), rhs) << std::fixed << std::setprecision(4) << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting LDL^T on a singular matrix:" << std::endl;
+    try {
+        Vector x = solve_ldlt(SymmetricMatrix(DenseMatrix{ {1, 1}, {1, 1} }), Vector{ 1, 1 });
+        print_vector(x, "x_ldlt_singular");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    // --- Najmniejsze kwadraty: rozkład QR Householdera ---
+    std::cout << "\n--- Least Squares Test: Tall Random System (600x150) ---" << std::endl;
+    try {
+        const int m_ls = 600, n_ls = 150;
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        DenseMatrix T(m_ls, n_ls);
+        for (int i = 0; i < m_ls; ++i) {
+            for (int j = 0; j < n_ls; ++j) T(i, j) = dist(gen);
+        }
+        Vector b_ls(m_ls);
+        for (double& v : b_ls) v = dist(gen);
+
+        QrFactorization qr(T);
+        double residual = 0.0;
+        Vector x_ls = qr.solve(b_ls, &residual);
+
+        // Optymalność: residuum r = b - Ax jest ortogonalne do kolumn A (A^T r = 0)
+        Vector r(m_ls);
+        double residual_direct = 0.0;
+        for (int i = 0; i < m_ls; ++i) {
+            r[i] = b_ls[i];
+            for (int j = 0; j < n_ls; ++j) r[i] -= T(i, j) * x_ls[j];
+            residual_direct += r[i] * r[i];
+        }
+        double worst_gradient = 0.0;
+        for (int j = 0; j < n_ls; ++j) {
+            double g = 0.0;
+            for (int i = 0; i < m_ls; ++i) g += T(i, j) * r[i];
+            worst_gradient = std::max(worst_gradient, std::abs(g));
+        }
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "max |A^T (b - Ax)|: " << worst_gradient << std::endl;
+        std::cout << "Residual norm from Q^T b: " << residual << ", direct: " << std::sqrt(residual_direct) << std::endl;
+
+        // Pivotowanie daje to samo rozwiązanie dla macierzy pełnego rzędu
+        Vector x_piv = solve_least_squares(T, b_ls, true);
+        double max_diff = 0.0;
+        for (int j = 0; j < n_ls; ++j) max_diff = std::max(max_diff, std::abs(x_piv[j] - x_ls[j]));
+        std::cout << "Max difference with column pivoting: " << max_diff << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+        std::cout << "Rank: " << qr.rank() << " (expected " << n_ls << ")" << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- Least Squares Test: Polynomial Fit and Row Updates ---" << std::endl;
+    try {
+        // Punkty leżące dokładnie na 1 - 2t + 0.5t^2: dopasowanie wielomianu stopnia 2 odtwarza współczynniki
+        const int samples = 20;
+        DenseMatrix V(samples, 3);
+        Vector y(samples);
+        for (int i = 0; i < samples; ++i) {
+            const double t = -1.0 + 2.0 * i / (samples - 1);
+            V(i, 0) = 1.0; V(i, 1) = t; V(i, 2) = t * t;
+            y[i] = 1.0 - 2.0 * t + 0.5 * t * t;
+        }
+        print_vector(solve_least_squares(V, y), "coefficients"); // oczekiwane [1 -2 0.5]
+
+        // Dopisanie wierszy do istniejącego rozkładu a rozkład całej macierzy od nowa
+        const int m_old = 200, m_new = 50, n_up = 40;
+        std::mt19937 gen(17);
+        std::uniform_real_distribution<double> dist(-1.0, 1.0);
+        DenseMatrix full(m_old + m_new, n_up), top(m_old, n_up), bottom(m_new, n_up);
+        Vector b_full(m_old + m_new);
+        for (int i = 0; i < m_old + m_new; ++i) {
+            for (int j = 0; j < n_up; ++j) {
+                full(i, j) = dist(gen);
+                if (i < m_old) top(i, j) = full(i, j); else bottom(i - m_old, j) = full(i, j);
+            }
+            b_full[i] = dist(gen);
+        }
+        QrFactorization updated(top, true);
+        updated.append_rows(bottom);
+        double residual_updated = 0.0, residual_full = 0.0;
+        Vector x_updated = updated.solve(b_full, &residual_updated);
+        Vector x_full = QrFactorization(full).solve(b_full, &residual_full);
+        double max_diff = 0.0;
+        for (int j = 0; j < n_up; ++j) max_diff = std::max(max_diff, std::abs(x_updated[j] - x_full[j]));
+        std::cout << "Rows after update: " << updated.rows() << std::endl;
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Max difference (updated vs. refactored): " << max_diff
+                  << ", residual difference: " << std::abs(residual_updated - residual_full) << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\n--- Least Squares Test: Rank-Deficient Matrix with Column Pivoting ---" << std::endl;
+    try {
+        // Trzecia kolumna jest sumą dwóch pierwszych: rząd 2
+        DenseMatrix D = {
+            {1, 0, 1},
+            {0, 1, 1},
+            {1, 1, 2},
+            {2, 1, 3}
+        };
+        Vector b_rd = { 1, 2, 3, 4 };
+        QrFactorization qr(D, true);
+        double residual = 0.0;
+        Vector x_rd = qr.solve(b_rd, &residual);
+        std::cout << "Rank: " << qr.rank() << " (expected 2)" << std::endl;
+        std::cout << "Residual norm: " << residual << ", max |A^T (b - Ax)|: ";
+        double worst_gradient = 0.0;
+        for (int j = 0; j < 3; ++j) {
+            double g = 0.0;
+            for (int i = 0; i < 4; ++i) {
+                double ri = b_rd[i];
+                for (int k = 0; k < 3; ++k) ri -= D(i, k) * x_rd[k];
+                g += D(i, j) * ri;
+            }
+            worst_gradient = std::max(worst_gradient, std::abs(g));
+        }
+        std::cout << std::scientific << std::setprecision(3) << worst_gradient << std::fixed << std::setprecision(4) << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting least squares on the same matrix without pivoting:" << std::endl;
+    try {
+        Vector x = solve_least_squares(DenseMatrix{ {1, 0, 1}, {0, 1, 1}, {1, 1, 2}, {2, 1, 3} }, Vector{ 1, 2, 3, 4 });
+        print_vector(x, "x_rank_deficient");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting QR of a wide matrix:" << std::endl;
+    try {
+        QrFactorization qr(DenseMatrix(2, 3, 1.0));
+        std::cout << "Unexpected success." << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include <iostream>
+#include <vector>
+#include <iomanip>
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include "sparse_matrix.h" // Używamy naszej biblioteki
+
+// Pomocnicza funkcja do drukowania wektora
+void print_vector(const Vector& vec, const std::string& name) {
+    std::cout << "Vector " << name << ": [ ";
+    for (const auto& val : vec) {
+        std::cout << val << " ";
+    }
+    std::cout << "]" << std::endl;
+}
+
+// Pomocnicza funkcja do drukowania tablicy indeksów
+void print_indices(const std::vector<int>& idx, const std::string& name) {
+    std::cout << name << ": [ ";
+    for (int i : idx) {
+        std::cout << i << " ";
+    }
+    std::cout << "]" << std::endl;
+}
+
+// Maksymalna wartość bezwzględna residuum |Ax - b|
+double max_residual(const SparseMatrix& A, const Vector& x, const Vector& b) {
+    Vector r = A.multiply(x);
+    double worst = 0.0;
+    for (std::size_t i = 0; i < r.size(); ++i) {
+        worst = std::max(worst, std::abs(r[i] - b[i]));
+    }
+    return worst;
+}
+
+// Macierz 5-punktowego laplasjanu na siatce m x m (równanie Poissona)
+SparseMatrix poisson_2d(int m) {
+    std::vector<Triplet> t;
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < m; ++j) {
+            int row = i * m + j;
+            t.push_back({ row, row, 4.0 });
+            if (i > 0) t.push_back({ row, row - m, -1.0 });
+            if (i < m - 1) t.push_back({ row, row + m, -1.0 });
+            if (j > 0) t.push_back({ row, row - 1, -1.0 });
+            if (j < m - 1) t.push_back({ row, row + 1, -1.0 });
+        }
+    }
+    return SparseMatrix::from_triplets(m * m, m * m, t);
+}
+
+int main() {
+    std::cout << "--- Example: Sparse Matrices and Sparse LU ---" << std::endl;
+    std::cout << std::fixed << std::setprecision(4);
+
+    // --- Budowa z trójek: dowolna kolejność, duplikaty są sumowane ---
+    std::cout << "\n--- Correct Test: Building CSR from Triplets ---" << std::endl;
+    std::vector<Triplet> triplets = {
+        {2, 2, 5.0}, {0, 0, 4.0}, {0, 2, 1.0}, {1, 1, 3.0},
+        {3, 0, 2.0}, {3, 3, 6.0}, {1, 3, -1.0}, {2, 0, 1.0}, {2, 2, 1.0}
+    };
+    SparseMatrix S = SparseMatrix::from_triplets(4, 4, triplets);
+    std::cout << "Matrix " << S.rows() << "x" << S.cols() << ", non-zeros: " << S.non_zeros() << std::endl;
+    print_indices(S.row_pointers(), "row_ptr");
+    print_indices(S.col_indices(), "col_idx");
+    print_vector(S.values(), "values");
+    std::cout << "S(2,2) = " << S.at(2, 2) << " (expected 6), S(0,1) = " << S.at(0, 1) << " (expected 0)" << std::endl;
+
+    Vector ones(4, 1.0);
+    print_vector(S.multiply(ones), "S * 1");             // oczekiwane [5 2 7 8]
+    print_vector(S.multiply_transpose(ones), "S^T * 1"); // oczekiwane [7 3 7 5]
+
+    CscMatrix S_csc = S.to_csc();
+    print_indices(S_csc.col_pointers(), "csc col_ptr");
+    print_indices(S_csc.row_indices(), "csc row_idx");
+    print_vector(S_csc.multiply(ones), "S_csc * 1");
+    SparseMatrix S_back = S_csc.to_csr();
+    std::cout << "CSR -> CSC -> CSR round trip equal: "
+              << (S_back.col_indices() == S.col_indices() && S_back.values() == S.values() ? "yes" : "no") << std::endl;
+
+    // --- Rozwiązanie małego układu i porównanie z solverem gęstym ---
+    std::cout << "\n--- Correct Test: Sparse LU vs Dense Gauss ---" << std::endl;
+    try {
+        Vector b = { 1, 2, 3, 4 };
+        print_vector(solve_lu(S, b), "x_sparse");
+        print_vector(solve_gauss(S.to_dense(), b), "x_dense");
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // Zero na przekątnej wymusza przestawienie wierszy
+    std::cout << "\nSolving a system with zero diagonal (needs row pivoting):" << std::endl;
+    try {
+        SparseMatrix P = SparseMatrix::from_triplets(3, 3, {
+            {0, 1, 2.0}, {1, 0, 1.0}, {1, 2, 1.0}, {2, 1, 1.0}, {2, 2, 3.0}
+        });
+        print_vector(solve_lu(P, Vector{ 2, 2, 4 }), "x_pivot"); // oczekiwane [1 1 1]
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Duży układ: równanie Poissona na siatce 100 x 100 ---
+    std::cout << "\n--- Poisson 2D Test: 10000 Unknowns ---" << std::endl;
+    try {
+        SparseMatrix L = poisson_2d(100);
+        Vector rhs(L.rows(), 1.0);
+        SparseLuFactorization natural(L, SparseOrdering::Natural);
+        SparseLuFactorization amd(L);
+        std::cout << "nnz(A) = " << L.non_zeros()
+                  << ", nnz(L+U) natural = " << natural.factor_non_zeros()
+                  << ", nnz(L+U) AMD = " << amd.factor_non_zeros() << std::endl;
+        std::cout << "AMD reduces fill: " << (amd.factor_non_zeros() < natural.factor_non_zeros() ? "yes" : "no") << std::endl;
+        std::cout << std::scientific << std::setprecision(3);
+        std::cout << "Max residual (natural): " << max_residual(L, natural.solve(rhs), rhs) << std::endl;
+        std::cout << "Max residual (AMD):     " << max_residual(L, amd.solve(rhs), rhs) << std::endl;
+        std::cout << std::fixed << std::setprecision(4);
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+    }
+
+    // --- Błędne przypadki ---
+    std::cout << "\n--- Erroneous Test: Singular Sparse Matrix ---" << std::endl;
+    try {
+        SparseMatrix Z = SparseMatrix::from_triplets(3, 3, { {0, 0, 1.0}, {1, 1, 1.0}, {2, 1, 1.0} });
+        Vector x = solve_lu(Z, Vector{ 1, 1, 1 });
+        print_vector(x, "x_singular"); // This line should ideally not be reached
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting to build a matrix from an out-of-range triplet:" << std::endl;
+    try {
+        SparseMatrix bad = SparseMatrix::from_triplets(2, 2, { {0, 0, 1.0}, {2, 1, 1.0} });
+        std::cout << "Unexpected success: " << bad.non_zeros() << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    std::cout << "\nAttempting to solve with a non-square sparse matrix:" << std::endl;
+    try {
+        SparseMatrix rect = SparseMatrix::from_triplets(2, 3, { {0, 0, 1.0}, {1, 2, 1.0} });
+        Vector x = solve_lu(rect, Vector{ 1, 1 });
+        print_vector(x, "x_rect"); // This line should ideally not be reached
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Caught expected error: " << e.what() << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file